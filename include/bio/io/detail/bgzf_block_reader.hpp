@@ -0,0 +1,151 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2022, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2022, Knut Reinert & MPI für molekulare Genetik
+// Copyright (c) 2020-2022, deCODE Genetics
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/bio/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides bio::io::detail::bgzf_block_reader.
+ * \author Hannes Hauswedell <hannes.hauswedell AT decode.is>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <string_view>
+#include <vector>
+
+#include <bio/io/detail/index_gzi.hpp>
+#include <bio/io/exception.hpp>
+#include <bio/io/stream/detail/bgzf_stream_util.hpp>
+
+namespace bio::io::detail
+{
+
+/*!\brief Random access to the uncompressed data of a BGZF file that decompresses single blocks.
+ * \details
+ *
+ * Offsets into the uncompressed data are translated to blocks via a bio::io::detail::gzi_index. Only the blocks that
+ * contain the requested bytes are read and decompressed, and the last block is cached, so that subsequent reads
+ * from the same block do not touch the file at all. No threads are involved and no buffers are allocated after
+ * the first read.
+ *
+ * This is much cheaper than bio::io::transparent_istream::seekg_primary() for small reads, because the latter
+ * re-creates the decompression stream and decompresses a full stream buffer.
+ *
+ * The file is opened separately, i.e. reading does not change the state of other streams on the same file.
+ */
+class bgzf_block_reader
+{
+public:
+    /*!\brief Open the file.
+     * \throws bio::io::file_open_error If the file cannot be opened.
+     */
+    explicit bgzf_block_reader(std::filesystem::path const & path) : istream{path, std::ios::binary}, filename{path}
+    {
+        if (!istream.good())
+            throw file_open_error{"Could not open file ", path.string(), " for reading."};
+    }
+
+    /*!\brief Return the uncompressed data from `offset` to the end of the block that contains it.
+     * \param[in] gzi The GZI index of the file.
+     * \param[in] offset The offset in the uncompressed data.
+     * \returns The data; empty if the offset is behind the end of the file.
+     * \throws bio::io::format_error If the block is not a valid BGZF block.
+     * \throws bio::io::io_error If the block cannot be decompressed.
+     */
+    std::string_view read_block(gzi_index const & gzi, uint64_t const offset)
+    {
+        auto const [disk_offset, block_offset] = gzi.locate(offset);
+
+        if (disk_offset != cached_disk_offset)
+            load_block(disk_offset);
+
+        if (block_offset >= cached_size)
+            return {};
+        return {decompressed.data() + block_offset, cached_size - block_offset};
+    }
+
+    /*!\brief Copy `n` bytes of uncompressed data beginning at `offset` to `out`.
+     * \param[in] gzi The GZI index of the file.
+     * \param[in] offset The offset in the uncompressed data.
+     * \param[in] n The number of bytes.
+     * \param[out] out The output buffer (must have room for `n` bytes).
+     * \throws bio::io::unexpected_end_of_input If the file ends before `offset + n`.
+     * \throws bio::io::format_error If a block is not a valid BGZF block.
+     * \throws bio::io::io_error If a block cannot be decompressed.
+     */
+    void read(gzi_index const & gzi, uint64_t offset, size_t n, char * out)
+    {
+        while (n > 0)
+        {
+            std::string_view const data = read_block(gzi, offset);
+            if (data.empty())
+                throw unexpected_end_of_input{"Reached the end of the BGZF file ", filename.string(), " at offset ",
+                                              offset, " while reading."};
+
+            size_t const k = std::min(n, data.size());
+            std::memcpy(out, data.data(), k);
+            out += k;
+            offset += k;
+            n -= k;
+        }
+    }
+
+private:
+    //!\brief The file.
+    std::ifstream                                         istream;
+    //!\brief The name of the file (for error messages).
+    std::filesystem::path                                 filename;
+    //!\brief The compressed block.
+    std::vector<char>                                     compressed;
+    //!\brief The decompressed block.
+    std::vector<char>                                     decompressed;
+    //!\brief The on-disk offset of the cached block.
+    uint64_t                                              cached_disk_offset = std::numeric_limits<uint64_t>::max();
+    //!\brief The uncompressed size of the cached block.
+    size_t                                                cached_size        = 0;
+    //!\brief The zlib state.
+    contrib::CompressionContext<compression_format::bgzf> ctx;
+
+    //!\brief Read and decompress the block at the given on-disk offset.
+    void load_block(uint64_t const disk_offset)
+    {
+        using page_size_t            = contrib::DefaultPageSize<compression_format::bgzf>;
+        constexpr size_t header_size = page_size_t::BLOCK_HEADER_LENGTH;
+
+        cached_disk_offset = std::numeric_limits<uint64_t>::max(); // in case of exceptions
+        cached_size        = 0;
+
+        compressed.resize(page_size_t::MAX_BLOCK_SIZE);
+        decompressed.resize(page_size_t::MAX_BLOCK_SIZE);
+
+        istream.clear();
+        istream.seekg(disk_offset);
+        if (!istream.read(compressed.data(), header_size))
+            return; // behind the last block, i.e. the end of the file
+
+        if (!header_matches<compression_format::bgzf>(std::string_view{compressed.data(), header_size}))
+            throw format_error{"The file ", filename.string(), " has no valid BGZF block at offset ", disk_offset, "."};
+
+        size_t const block_size = contrib::_bgzfUnpack16(compressed.data() + 16) + 1u;
+        if (block_size <= header_size ||
+            !istream.read(compressed.data() + header_size, static_cast<std::streamsize>(block_size - header_size)))
+        {
+            throw unexpected_end_of_input{"The BGZF file ", filename.string(), " is truncated."};
+        }
+
+        cached_size =
+          contrib::_decompressBlock(decompressed.data(), decompressed.size(), compressed.data(), block_size, ctx);
+        cached_disk_offset = disk_offset;
+    }
+};
+
+} // namespace bio::io::detail
@@ -0,0 +1,104 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2022, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2022, Knut Reinert & MPI für molekulare Genetik
+// Copyright (c) 2020-2022, deCODE Genetics
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/bio/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides bio::io::detail::char_strictly_to_bulk.
+ * \author Hannes Hauswedell <hannes.hauswedell AT decode.is>
+ */
+
+#pragma once
+
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <ranges>
+#include <string_view>
+#include <type_traits>
+
+#include <bio/alphabet/concept.hpp>
+
+namespace bio::io::detail
+{
+
+/*!\addtogroup io
+ * \{
+ */
+
+/*!\interface bio::io::detail::table_convertible_alphabet <>
+ * \tparam alph_t The alphabet type.
+ * \brief An alphabet whose character conversion can be evaluated at compile-time (and tabulated).
+ */
+//!\cond
+template <typename alph_t>
+concept table_convertible_alphabet = alphabet::writable_alphabet<alph_t> && std::is_trivially_copyable_v<alph_t> &&
+  std::default_initializable<alph_t> && requires
+{
+    typename std::integral_constant<bool, (alphabet::char_is_valid_for<alph_t>('A'), true)>;
+    typename std::integral_constant<bool, (alphabet::assign_char_to('A', alph_t{}), true)>;
+};
+//!\endcond
+
+//!\brief For every (unsigned) char value, the alphabet letter it converts to.
+template <table_convertible_alphabet alph_t>
+inline constexpr std::array<alph_t, 256> char_to_alphabet_table = []()
+{
+    std::array<alph_t, 256> ret{};
+    for (size_t i = 0; i < 256; ++i)
+        ret[i] = alphabet::assign_char_to(static_cast<char>(i), alph_t{});
+    return ret;
+}();
+
+//!\brief For every (unsigned) char value, 1 if it is not valid for the alphabet and 0 otherwise.
+template <table_convertible_alphabet alph_t>
+inline constexpr std::array<uint8_t, 256> char_invalid_table = []()
+{
+    std::array<uint8_t, 256> ret{};
+    for (size_t i = 0; i < 256; ++i)
+        ret[i] = !alphabet::char_is_valid_for<alph_t>(static_cast<char>(i));
+    return ret;
+}();
+
+/*!\brief Convert characters to alphabet letters, throwing on invalid characters (like bio::views::char_strictly_to).
+ * \tparam out_t Type of the output; must be a contiguous range with `.resize()`.
+ * \param[in] in The characters.
+ * \param[out] out The output container; resized to the size of the input.
+ * \throws bio::alphabet::invalid_char_assignment If a character is not valid for the alphabet.
+ * \details
+ *
+ * The conversion is a single table lookup per character. Validity is accumulated in a flag and checked once for the
+ * whole input, so the loop has no branches. Only if an invalid character was found, the input is traversed again to
+ * produce the same exception that bio::views::char_strictly_to would.
+ */
+template <typename out_t>
+    requires std::ranges::contiguous_range<out_t> && table_convertible_alphabet<std::ranges::range_value_t<out_t>> &&
+      requires(out_t & out) { out.resize(0); }
+void char_strictly_to_bulk(std::string_view const in, out_t & out)
+{
+    using alph_t = std::ranges::range_value_t<out_t>;
+
+    out.resize(in.size());
+    alph_t * const out_data = std::ranges::data(out);
+
+    uint8_t invalid = 0;
+    for (size_t i = 0; i < in.size(); ++i)
+    {
+        uint8_t const c = static_cast<uint8_t>(in[i]);
+        out_data[i]     = char_to_alphabet_table<alph_t>[c];
+        invalid |= char_invalid_table<alph_t>[c];
+    }
+
+    if (invalid != 0)
+    {
+        for (char const c : in)
+            alphabet::assign_char_strictly_to(c, alph_t{}); // throws on the first invalid character
+    }
+}
+
+//!\}
+
+} // namespace bio::io::detail
@@ -13,9 +13,14 @@
 
 #pragma once
 
+#include <algorithm>
+#include <bit>
 #include <cassert>
 #include <charconv>
 #include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <limits>
 #include <ranges>
 #include <string>
 #include <string_view>
@@ -32,6 +37,172 @@ namespace bio::io::detail
  * \{
  */
 
+/*!\brief Parse up to eight decimal digits with a single 64-bit load (SWAR).
+ * \param[in] input The input string; must have a size between 1 and 8.
+ * \param[out] number The result.
+ * \returns `true` if input consisted only of digits (number is set); `false` otherwise (number is unchanged).
+ * \details
+ *
+ * The digits are loaded right-aligned into a word that is pre-filled with '0' characters so that
+ * the padding acts like leading zeros. Validation and conversion then each take a handful of
+ * word-wide operations instead of one loop iteration per character.
+ */
+inline bool parse_eight_digits_swar(std::string_view const input, uint64_t & number) noexcept
+{
+    assert(input.size() >= 1 && input.size() <= 8);
+
+    uint64_t val = 0x3030303030303030ull;
+    std::memcpy(reinterpret_cast<char *>(&val) + (8 - input.size()), input.data(), input.size());
+
+    // every byte must be in ['0', '9']
+    if ((((val + 0x4646464646464646ull) | (val - 0x3030303030303030ull)) & 0x8080808080808080ull) != 0)
+        return false;
+
+    val -= 0x3030303030303030ull;
+    val = (val * 10) + (val >> 8);
+    val = (((val & 0x000000FF000000FFull) * (100 + (1000000ull << 32))) +
+           (((val >> 16) & 0x000000FF000000FFull) * (1 + (10000ull << 32)))) >>
+          32;
+    number = val;
+    return true;
+}
+
+/*!\brief Fast path for parsing short integers.
+ * \param[in] input The input string.
+ * \param[out] number The variable holding the result.
+ * \returns `true` if the fast path could handle the input; `false` if the caller needs to fall back.
+ * \details
+ *
+ * Handles an optional leading '-' (signed types only) followed by one to eight digits. Everything else,
+ * including values that do not fit into the target type, is left to std::from_chars so that error
+ * behaviour is unchanged.
+ */
+template <std::integral int_t>
+inline bool string_to_integer_fast(std::string_view input, int_t & number) noexcept
+{
+    if constexpr (std::endian::native != std::endian::little || std::same_as<int_t, bool>)
+    {
+        return false;
+    }
+    else
+    {
+        bool negative = false;
+        if constexpr (std::is_signed_v<int_t>)
+        {
+            if (!input.empty() && input[0] == '-')
+            {
+                negative = true;
+                input.remove_prefix(1);
+            }
+        }
+
+        uint64_t val = 0;
+        if (input.size() < 1 || input.size() > 8 || !parse_eight_digits_swar(input, val))
+            return false;
+
+        if (negative)
+        {
+            if (val > static_cast<uint64_t>(std::numeric_limits<int_t>::max()) + 1ull)
+                return false;
+            number = static_cast<int_t>(-static_cast<int64_t>(val));
+        }
+        else
+        {
+            if (val > static_cast<uint64_t>(std::numeric_limits<int_t>::max()))
+                return false;
+            number = static_cast<int_t>(val);
+        }
+        return true;
+    }
+}
+
+/*!\brief Fast path for parsing floating point numbers.
+ * \param[in] input The input string.
+ * \param[out] number The variable holding the result.
+ * \returns `true` if the fast path could handle the input; `false` if the caller needs to fall back.
+ * \details
+ *
+ * Accepts `[-]digits[.digits][(e|E)[+-]digits]` and computes the result exactly (Clinger's fast path): if
+ * the decimal significand is representable in the floating point type and the power of ten is small enough
+ * to be exact, a single multiplication or division is correctly rounded. This covers virtually all values
+ * found in bioinformatics files (QUAL, allele frequencies, p-values written with few digits). All other
+ * inputs, including "nan", "inf", long significands and large exponents, are handed to std::from_chars.
+ */
+template <std::floating_point float_t>
+inline bool string_to_float_fast(std::string_view const input, float_t & number) noexcept
+{
+    if constexpr (!std::same_as<float_t, float> && !std::same_as<float_t, double>)
+    {
+        return false;
+    }
+    else
+    {
+        // maximum exact significand and power of ten
+        constexpr uint64_t max_mantissa = std::same_as<float_t, float> ? (1ull << 24) : (1ull << 53);
+        constexpr int64_t  max_exponent = std::same_as<float_t, float> ? 10 : 22;
+        constexpr float_t  powers_of_ten[]{1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                          1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                                          1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+        char const * it  = input.data();
+        char const * end = input.data() + input.size();
+
+        bool const negative = it != end && *it == '-';
+        it += negative;
+
+        uint64_t mantissa = 0;
+        int64_t  exponent = 0;
+        size_t   n_digits = 0;
+
+        char const * const int_begin = it;
+        for (; it != end && static_cast<unsigned char>(*it - '0') < 10; ++it, ++n_digits)
+            mantissa = mantissa * 10 + static_cast<uint64_t>(*it - '0');
+        bool has_digits = it != int_begin;
+
+        if (it != end && *it == '.')
+        {
+            ++it;
+            char const * const frac_begin = it;
+            for (; it != end && static_cast<unsigned char>(*it - '0') < 10; ++it, ++n_digits)
+                mantissa = mantissa * 10 + static_cast<uint64_t>(*it - '0');
+            exponent -= it - frac_begin;
+            has_digits |= it != frac_begin;
+        }
+
+        // more than 19 digits may have overflowed the mantissa
+        if (!has_digits || n_digits > 19)
+            return false;
+
+        if (it != end && (*it == 'e' || *it == 'E'))
+        {
+            ++it;
+            bool const exp_negative = it != end && *it == '-';
+            if (it != end && (*it == '-' || *it == '+'))
+                ++it;
+
+            char const * const exp_begin = it;
+            int64_t            exp_val   = 0;
+            for (; it != end && static_cast<unsigned char>(*it - '0') < 10 && it - exp_begin < 8; ++it)
+                exp_val = exp_val * 10 + (*it - '0');
+            if (it == exp_begin)
+                return false;
+            exponent += exp_negative ? -exp_val : exp_val;
+        }
+
+        if (it != end || mantissa > max_mantissa || exponent < -max_exponent || exponent > max_exponent)
+            return false;
+
+        float_t val = static_cast<float_t>(mantissa);
+        if (exponent < 0)
+            val /= powers_of_ten[-exponent];
+        else
+            val *= powers_of_ten[exponent];
+
+        number = negative ? -val : val;
+        return true;
+    }
+}
+
 /*!\brief Turn a string into a number.
  * \param[in] input The input string.
  * \param[out] number The variable holding the result.
@@ -41,15 +212,74 @@ namespace bio::io::detail
  * Relies on std::from_chars to efficiently convert but accepts std::string_view and throws on error so
  * there is no return value that needs to be checked.
  *
+ * Short integers and "simple" floating point numbers are handled by dedicated fast paths
+ * (see bio::io::detail::string_to_integer_fast and bio::io::detail::string_to_float_fast); the results are
+ * identical to those of std::from_chars.
+ *
  * TODO make this public (bio::io::) since it is useful for people doing plain IO
  */
 void string_to_number(std::string_view const input, meta::arithmetic auto & number)
 {
+    using number_t = std::remove_cvref_t<decltype(number)>;
+
+    if constexpr (std::integral<number_t>)
+    {
+        if (string_to_integer_fast(input, number))
+            return;
+    }
+    else if constexpr (std::floating_point<number_t>)
+    {
+        if (string_to_float_fast(input, number))
+            return;
+    }
+
     std::from_chars_result res = std::from_chars(input.data(), input.data() + input.size(), number);
     if (res.ec != std::errc{} || res.ptr != input.data() + input.size())
         throw bio_error{"Could not convert \"", input, "\" into a number."};
 }
 
+/*!\brief Turn a delimited list of numbers into a container of numbers.
+ * \param[in] input The input string, e.g. "1,2,3,4".
+ * \param[in] delimiter The character separating the elements.
+ * \param[out] output The container that the results are appended to.
+ * \param[in] missing A string that denotes a missing element (e.g. "." in VCF); empty to disable.
+ * \param[in] missing_value The value that is stored for missing elements.
+ * \throws bio_error If there was an error during conversion.
+ * \details
+ *
+ * This is equivalent to splitting the input and calling bio::io::detail::string_to_number on every element,
+ * but it avoids creating intermediate views and grows the output container only once per call.
+ */
+template <typename container_t>
+    requires(meta::arithmetic<typename container_t::value_type> &&
+             requires(container_t & c) { c.emplace_back(); })
+void string_to_numbers(std::string_view const                   input,
+                       char const                               delimiter,
+                       container_t &                            output,
+                       std::string_view const                   missing       = {},
+                       typename container_t::value_type const & missing_value = {})
+{
+    if constexpr (requires { output.reserve(0ull); })
+        output.reserve(output.size() + std::ranges::count(input, delimiter) + 1);
+
+    size_t beg = 0;
+    while (true)
+    {
+        size_t const           end  = std::min(input.find(delimiter, beg), input.size());
+        std::string_view const elem = input.substr(beg, end - beg);
+
+        output.emplace_back();
+        if (!missing.empty() && elem == missing)
+            output.back() = missing_value;
+        else
+            string_to_number(elem, output.back());
+
+        if (end == input.size())
+            break;
+        beg = end + 1;
+    }
+}
+
 // TODO write number_to_string and append_number_to_string
 
 //!\}
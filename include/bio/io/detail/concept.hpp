@@ -15,6 +15,7 @@
 
 #include <concepts>
 #include <ranges>
+#include <string_view>
 
 #include <bio/alphabet/concept.hpp>
 #include <bio/meta/overloaded.hpp>
@@ -37,6 +38,24 @@ template <typename t>
 concept deliberate_alphabet = alphabet::alphabet<t> && !std::integral<std::remove_cvref_t<t>>;
 //!\endcond
 
+/*!\interface   bio::io::detail::bulk_char_convertible <>
+ * \tparam t    The query type.
+ * \brief       A sequence container that is assigned from and converted to characters in bulk.
+ * \details
+ *
+ * Containers with a compressed representation (e.g. bio::io::seq::packed_dna5_vector) model this instead of being
+ * back-insertable; the format handlers use the bulk interfaces instead of converting element by element.
+ */
+//!\cond
+template <typename t>
+concept bulk_char_convertible = std::ranges::random_access_range<t const> && std::ranges::sized_range<t const> &&
+  requires(t & v, t const & cv, std::string_view const in, char * const out)
+{
+    v.assign_chars(in);
+    cv.to_chars(size_t{}, size_t{}, out);
+};
+//!\endcond
+
 /*!\brief Pass this function a constrained functor that accepts one argument and returns std::true_type.
  * \details
  *
@@ -0,0 +1,60 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2022, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2022, Knut Reinert & MPI für molekulare Genetik
+// Copyright (c) 2020-2022, deCODE Genetics
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/bio/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides bio::io::detail::count_char.
+ * \author Hannes Hauswedell <hannes.hauswedell AT decode.is>
+ */
+
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+
+namespace bio::io::detail
+{
+
+/*!\addtogroup io
+ * \{
+ */
+
+/*!\brief Count the occurrences of a character in a memory region.
+ * \param[in] beg Begin of the region.
+ * \param[in] end End of the region.
+ * \param[in] c   The character to count.
+ * \details
+ *
+ * Processes eight bytes at a time ("SIMD within a register"); the compiler typically auto-vectorises this further.
+ * The bit-trick used is exact, i.e. there are no false positives from carries between bytes.
+ */
+inline size_t count_char(char const * beg, char const * const end, char const c) noexcept
+{
+    constexpr uint64_t ones  = 0x0101010101010101ull;
+    constexpr uint64_t lows  = 0x7F7F7F7F7F7F7F7Full;
+    uint64_t const     match = ones * static_cast<unsigned char>(c);
+
+    size_t count = 0;
+    for (; end - beg >= 8; beg += 8)
+    {
+        uint64_t word = 0;
+        std::memcpy(&word, beg, 8);
+        word ^= match;                                   // matching bytes are now zero
+        uint64_t const t = ((word & lows) + lows) | word; // high bit of byte set iff byte is non-zero
+        count += std::popcount(~t & ~lows);
+    }
+
+    for (; beg != end; ++beg)
+        count += (*beg == c);
+
+    return count;
+}
+
+//!\}
+
+} // namespace bio::io::detail
@@ -0,0 +1,213 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2022, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2022, Knut Reinert & MPI für molekulare Genetik
+// Copyright (c) 2020-2022, deCODE Genetics
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides support for GZI indexes (block offsets of BGZF files).
+ * \author Hannes Hauswedell <hannes.hauswedell AT decode.is>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <bio/io/detail/to_little_endian.hpp>
+#include <bio/io/exception.hpp>
+#include <bio/io/stream/compression.hpp>
+#include <bio/io/stream/detail/fast_streambuf_iterator.hpp>
+#include <bio/io/stream/transparent_istream.hpp>
+
+namespace bio::io::detail
+{
+
+/*!\brief GZI index support; maps uncompressed offsets in a BGZF file to compressed block offsets.
+ * \details
+ *
+ * The on-disk format is the one used by `bgzip -i` and `samtools faidx`: a little-endian uint64_t number of entries
+ * followed by pairs of uint64_t (compressed offset, uncompressed offset) for every block except the first.
+ *
+ * In memory, the first block (0, 0) is always included.
+ */
+struct gzi_index
+{
+    //!\brief Pairs of (compressed offset, uncompressed offset) of each block's beginning; sorted.
+    std::vector<std::pair<uint64_t, uint64_t>> blocks{{0, 0}};
+
+    //!\brief Read an index from disk.
+    void read(std::filesystem::path const & path);
+    //!\brief Write an index to disk.
+    void write(std::filesystem::path const & path) const;
+
+    //!\brief Create an index by walking the block headers of a BGZF file (no decompression takes place).
+    static gzi_index build(std::filesystem::path const & path);
+
+    /*!\brief Find the block that contains the given uncompressed offset.
+     * \returns A pair of the on-disk offset of the block and the offset within the decompressed block.
+     */
+    std::pair<uint64_t, uint64_t> locate(uint64_t const uncompressed_offset) const
+    {
+        assert(!blocks.empty());
+        auto it = std::ranges::upper_bound(blocks, uncompressed_offset, {}, [](auto const & p) { return p.second; });
+        --it; // first element is (0,0) so there is always a predecessor
+        return {it->first, uncompressed_offset - it->second};
+    }
+
+    //!\brief Convert an uncompressed offset into a BGZF "virtual offset".
+    uint64_t to_virtual_offset(uint64_t const uncompressed_offset) const
+    {
+        auto [comp, uncomp] = locate(uncompressed_offset);
+        return (comp << 16) | uncomp;
+    }
+};
+
+inline void gzi_index::read(std::filesystem::path const & path)
+{
+    std::ifstream istream{path, std::ios::binary};
+    if (!istream.good())
+        throw file_open_error{"Could not open GZI index file ", path.string(), " for reading."};
+
+    detail::fast_istreambuf_iterator<char> it{istream};
+
+    uint64_t n = 0;
+    it.read_as_binary(n);
+    n = detail::to_little_endian(n);
+
+    blocks.resize(n + 1);
+    blocks[0] = {0, 0};
+    it.read_n_chars_into(n * 2 * sizeof(uint64_t), reinterpret_cast<char *>(blocks.data() + 1));
+
+    for (auto & [comp, uncomp] : blocks)
+    {
+        comp   = detail::to_little_endian(comp);
+        uncomp = detail::to_little_endian(uncomp);
+    }
+
+    if (!std::ranges::is_sorted(blocks))
+        throw format_error{"The GZI index ", path.string(), " is not sorted."};
+}
+
+inline void gzi_index::write(std::filesystem::path const & path) const
+{
+    std::ofstream ostream{path, std::ios::binary};
+    if (!ostream.good())
+        throw file_open_error{"Could not open file ", path.string(), " for writing."};
+
+    detail::fast_ostreambuf_iterator<char> it{ostream};
+
+    uint64_t const n = blocks.empty() ? 0 : blocks.size() - 1;
+    it.write_as_binary(detail::to_little_endian(n));
+    for (size_t i = 1; i < blocks.size(); ++i)
+    {
+        it.write_as_binary(detail::to_little_endian(blocks[i].first));
+        it.write_as_binary(detail::to_little_endian(blocks[i].second));
+    }
+}
+
+inline gzi_index gzi_index::build(std::filesystem::path const & path)
+{
+    constexpr size_t header_size = compression_traits<compression_format::bgzf>::magic_header.size();
+
+    std::ifstream istream{path, std::ios::binary};
+    if (!istream.good())
+        throw file_open_error{"Could not open file ", path.string(), " for reading."};
+
+    gzi_index ret;
+    ret.blocks.clear();
+
+    std::array<char, header_size> header{};
+    uint64_t                      comp_offset   = 0;
+    uint64_t                      uncomp_offset = 0;
+
+    while (istream.read(header.data(), header_size))
+    {
+        if (!header_matches<compression_format::bgzf>(std::string_view{header.data(), header_size}))
+            throw format_error{"The file ", path.string(), " is not BGZF compressed (or it is corrupted)."};
+
+        uint16_t bsize = 0;
+        std::ranges::copy_n(header.data() + 16, sizeof(bsize), reinterpret_cast<char *>(&bsize));
+        uint64_t const block_size = detail::to_little_endian(bsize) + 1ull;
+
+        // the last four bytes of each block hold the uncompressed size
+        uint32_t isize = 0;
+        istream.seekg(comp_offset + block_size - sizeof(isize));
+        if (!istream.read(reinterpret_cast<char *>(&isize), sizeof(isize)))
+            throw unexpected_end_of_input{"The BGZF file ", path.string(), " is truncated."};
+
+        ret.blocks.emplace_back(comp_offset, uncomp_offset);
+
+        comp_offset += block_size;
+        uncomp_offset += detail::to_little_endian(isize);
+    }
+
+    if (ret.blocks.empty())
+        ret.blocks.emplace_back(0, 0);
+
+    return ret;
+}
+
+/*!\brief Read the GZI index of a stream's file from "FILENAME.gzi" or create it (if not already present).
+ * \param[in] stream The stream; must have been opened from a file.
+ * \param[in,out] gzi The GZI index; nothing happens if it has a value.
+ * \throws bio::io::bio_error If the stream was not opened from a file.
+ * \throws bio::io::format_error If the index is created and the file is not BGZF compressed.
+ */
+inline void load_gzi_index(transparent_istream & stream, std::optional<gzi_index> & gzi)
+{
+    if (gzi.has_value())
+        return;
+
+    if (stream.filename().empty())
+        throw bio_error{"Random access on compressed streams requires a file name."};
+
+    std::filesystem::path gzi_file = stream.filename();
+    gzi_file += ".gzi";
+    if (std::filesystem::exists(gzi_file))
+        gzi.emplace().read(gzi_file);
+    else // throws if file is not BGZF
+        gzi = gzi_index::build(stream.filename());
+}
+
+/*!\brief Seek to an offset in the uncompressed data of a stream.
+ * \param[in,out] stream The stream; must have been opened from a file if it is compressed.
+ * \param[in,out] gzi    The GZI index of the file; read from "FILENAME.gzi" or built on demand if empty.
+ * \param[in] offset     The offset in the uncompressed data.
+ * \throws bio::io::bio_error If the stream is compressed with a format other than BGZF.
+ */
+inline void seek_to_uncompressed_offset(transparent_istream &      stream,
+                                        std::optional<gzi_index> & gzi,
+                                        uint64_t const             offset)
+{
+    switch (stream.compression())
+    {
+        case compression_format::none:
+            stream.seekg_primary(offset);
+            break;
+        case compression_format::bgzf:
+        case compression_format::gz: // BGZF files are read as GZ files in single-threaded mode
+            {
+                load_gzi_index(stream, gzi);
+
+                auto [disk_offset, block_offset] = gzi->locate(offset);
+                stream.seekg_primary(disk_offset);
+                fast_istreambuf_iterator<char>{stream}.skip_n(block_offset);
+                break;
+            }
+        default:
+            throw bio_error{"Random access is only possible on uncompressed and BGZF-compressed files."};
+    }
+}
+
+} // namespace bio::io::detail
@@ -179,7 +179,8 @@ inline void tabix_index::read(std::filesystem::path const & path)
 
 inline void tabix_index::write(std::filesystem::path const & path)
 {
-    transparent_ostream                    ostream{path, {.compression = compression_format::bgzf}};
+    // BGZF compression requires at least two threads; the index is small, so more are not needed
+    transparent_ostream                    ostream{path, {.compression = compression_format::bgzf, .threads = 2}};
     detail::fast_ostreambuf_iterator<char> it{ostream};
     unexpected_end_of_input                in_end{"Unexpected end of input while trying to read Tabix index."};
 
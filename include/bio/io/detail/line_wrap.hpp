@@ -0,0 +1,68 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2022, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2022, Knut Reinert & MPI für molekulare Genetik
+// Copyright (c) 2020-2022, deCODE Genetics
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/bio/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides bio::io::detail::append_wrapped.
+ * \author Hannes Hauswedell <hannes.hauswedell AT decode.is>
+ */
+
+#pragma once
+
+#include <cassert>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+namespace bio::io::detail
+{
+
+/*!\addtogroup io
+ * \{
+ */
+
+/*!\brief Append characters to a buffer and insert a line-ending after every `width` characters and at the end.
+ * \param[in,out] buf The buffer.
+ * \param[in] in The characters; nothing is appended if this is empty.
+ * \param[in] width The maximum number of characters per line; must not be 0.
+ * \param[in] windows_eol Whether to write "\r\n" instead of "\n".
+ * \details
+ *
+ * The buffer is resized once and the lines are copied with std::memcpy, i.e. the cost per line is constant.
+ */
+inline void append_wrapped(std::string & buf, std::string_view const in, size_t const width, bool const windows_eol)
+{
+    assert(width > 0);
+
+    if (in.empty())
+        return;
+
+    size_t const n_lines  = (in.size() + width - 1) / width;
+    size_t const old_size = buf.size();
+    buf.resize(old_size + in.size() + n_lines * (windows_eol ? 2 : 1));
+
+    char *       out = buf.data() + old_size;
+    char const * src = in.data();
+    for (size_t remaining = in.size(); remaining > 0;)
+    {
+        size_t const count = std::min(remaining, width);
+        std::memcpy(out, src, count);
+        out += count;
+        src += count;
+        remaining -= count;
+
+        if (windows_eol)
+            *out++ = '\r';
+        *out++ = '\n';
+    }
+
+    assert(out == buf.data() + buf.size());
+}
+
+//!\}
+
+} // namespace bio::io::detail
@@ -0,0 +1,122 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2022, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2022, Knut Reinert & MPI für molekulare Genetik
+// Copyright (c) 2020-2022, deCODE Genetics
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/bio/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides bio::io::detail::parallel_format and helpers for formatting into strings.
+ * \author Hannes Hauswedell <hannes.hauswedell AT decode.is>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <exception>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <bio/meta/concept/core_language.hpp>
+
+namespace bio::io::detail
+{
+
+/*!\addtogroup io
+ * \{
+ */
+
+/*!\brief Append the textual representation of a number to a string.
+ * \details
+ *
+ * Uses std::to_chars and produces the same output as bio::io::detail::fast_ostreambuf_iterator::write_number.
+ */
+inline void append_number(std::string & buf, meta::arithmetic auto const num)
+{
+    size_t const old_size = buf.size();
+    buf.resize(old_size + 150); // enough for any number
+    auto res = std::to_chars(buf.data() + old_size, buf.data() + buf.size(), num);
+    buf.resize(res.ptr - buf.data());
+}
+
+/*!\brief Format elements [0, n) in parallel and hand the results to a sink in order.
+ * \param[in] n         The number of elements.
+ * \param[in] n_threads The total number of threads to use (including the calling thread).
+ * \param[in] format_fn A callable with the signature `void(size_t beg, size_t end, std::string & buf)`; it is
+ *                      called on worker threads and needs to append the formatted elements [beg, end) to buf.
+ * \param[in] sink_fn   A callable with the signature `void(std::string const & buf)`; it is called on the calling
+ *                      thread once per chunk in the order of the elements.
+ * \details
+ *
+ * The elements are split into `n_threads` contiguous chunks. The calling thread formats the first chunk, passes it
+ * to the sink and then passes the remaining chunks as they are finished, i.e. writing the output overlaps with
+ * formatting the later chunks.
+ *
+ * Exceptions thrown in the worker threads are propagated to the caller (the first one in element order).
+ */
+template <typename format_fn_t, typename sink_fn_t>
+void parallel_format(size_t const n, size_t n_threads, format_fn_t && format_fn, sink_fn_t && sink_fn)
+{
+    n_threads = std::clamp<size_t>(n_threads, 1, std::max<size_t>(n, 1));
+
+    size_t const chunk_size = (n + n_threads - 1) / n_threads;
+
+    std::vector<std::string>        buffers(n_threads);
+    std::vector<std::exception_ptr> exceptions(n_threads);
+    std::vector<std::thread>        threads;
+    threads.reserve(n_threads - 1);
+
+    auto job = [&](size_t const i)
+    {
+        try
+        {
+            size_t const beg = std::min(n, i * chunk_size);
+            size_t const end = std::min(n, beg + chunk_size);
+            format_fn(beg, end, buffers[i]);
+        }
+        catch (...)
+        {
+            exceptions[i] = std::current_exception();
+        }
+    };
+
+    for (size_t i = 1; i < n_threads; ++i)
+        threads.emplace_back(job, i);
+
+    job(0);
+
+    std::exception_ptr first_exception;
+    for (size_t i = 0; i < n_threads; ++i)
+    {
+        if (i > 0)
+            threads[i - 1].join();
+
+        if (exceptions[i] && !first_exception)
+            first_exception = exceptions[i];
+
+        if (!first_exception)
+        {
+            try
+            {
+                sink_fn(std::as_const(buffers[i]));
+            }
+            catch (...)
+            {
+                first_exception = std::current_exception();
+            }
+            std::string{}.swap(buffers[i]); // release memory early
+        }
+    }
+
+    if (first_exception)
+        std::rethrow_exception(first_exception);
+}
+
+//!\}
+
+} // namespace bio::io::detail
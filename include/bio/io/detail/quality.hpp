@@ -0,0 +1,93 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2022, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2022, Knut Reinert & MPI für molekulare Genetik
+// Copyright (c) 2020-2022, deCODE Genetics
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/bio/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides bio::io::detail::summarise_qualities and bio::io::detail::shift_qualities.
+ * \author Hannes Hauswedell <hannes.hauswedell AT decode.is>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+
+namespace bio::io::detail
+{
+
+/*!\addtogroup io
+ * \{
+ */
+
+//!\brief Sum, minimum and maximum of the characters in a quality string.
+struct qual_summary
+{
+    //!\brief Sum of the character values.
+    uint64_t sum = 0;
+    //!\brief Smallest character value.
+    uint8_t  min = std::numeric_limits<uint8_t>::max();
+    //!\brief Largest character value.
+    uint8_t  max = 0;
+};
+
+/*!\brief Compute sum, minimum and maximum of the characters in a quality string.
+ * \param[in] qual The quality string.
+ * \details
+ *
+ * The string is processed in blocks with small accumulators and no branches, so that the loop is vectorised by the
+ * compiler. Minimum and maximum are sufficient to validate the range of all characters.
+ */
+inline qual_summary summarise_qualities(std::string_view const qual) noexcept
+{
+    // sums of 2^16 uint8_t values fit into uint32_t
+    static constexpr size_t block_size = 1ull << 16;
+
+    qual_summary    ret;
+    uint8_t const * data = reinterpret_cast<uint8_t const *>(qual.data());
+
+    for (size_t block_begin = 0; block_begin < qual.size(); block_begin += block_size)
+    {
+        size_t const block_end = std::min(block_begin + block_size, qual.size());
+
+        uint32_t sum = 0;
+        uint8_t  min = ret.min;
+        uint8_t  max = ret.max;
+        for (size_t i = block_begin; i < block_end; ++i)
+        {
+            uint8_t const c = data[i];
+            sum += c;
+            min = std::min(min, c);
+            max = std::max(max, c);
+        }
+
+        ret.sum += sum;
+        ret.min = min;
+        ret.max = max;
+    }
+
+    return ret;
+}
+
+/*!\brief Subtract a value from every character of a quality string, e.g. to convert Phred+64 to Phred+33.
+ * \param[in] in The quality string.
+ * \param[out] out Pointer to the output; must have space for `in.size()` characters and may be equal to `in.data()`.
+ * \param[in] delta The value to subtract.
+ */
+inline void shift_qualities(std::string_view const in, char * const out, uint8_t const delta) noexcept
+{
+    uint8_t const * in_data  = reinterpret_cast<uint8_t const *>(in.data());
+    uint8_t *       out_data = reinterpret_cast<uint8_t *>(out);
+
+    for (size_t i = 0; i < in.size(); ++i)
+        out_data[i] = static_cast<uint8_t>(in_data[i] - delta);
+}
+
+//!\}
+
+} // namespace bio::io::detail
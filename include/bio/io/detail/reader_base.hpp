@@ -14,8 +14,10 @@
 #pragma once
 
 #include <cassert>
+#include <cstdint>
 #include <filesystem>
 #include <fstream>
+#include <limits>
 #include <string>
 #include <variant>
 #include <vector>
@@ -246,6 +248,44 @@ public:
     record_type & front() noexcept { return *begin(); }
     //!\}
 
+    /*!\name Counting and skipping
+     * \brief Move through the file without parsing records.
+     * \{
+     */
+    /*!\brief Skip records, beginning with the current one.
+     * \param[in] n The number of records to skip.
+     * \returns The number of records skipped; smaller than `n` only if the end of the file was reached.
+     * \details
+     *
+     * Records are skipped by the format handler without parsing their fields; most formats do this directly on the
+     * (decompressed) stream buffer, e.g. by counting line-endings. Afterwards, the record behind the skipped ones is
+     * buffered, i.e. begin() points to it.
+     *
+     * Skipping is considerably faster than iterating over the records, but it performs only minimal validation of
+     * the skipped records.
+     */
+    uint64_t skip(uint64_t const n)
+    {
+        begin(); // the first record is buffered
+
+        if (n == 0 || at_end)
+            return 0;
+
+        uint64_t const skipped = 1 + to_derived().skip_raw_records(n - 1); // current record is already read
+        to_derived().read_next_record();
+        return skipped;
+    }
+
+    /*!\brief Count the records from the current one to the end of the file.
+     * \returns The number of records.
+     * \details
+     *
+     * This is equivalent to `skip(std::numeric_limits<uint64_t>::max())`, i.e. the reader is at end afterwards.
+     * Use reopen() to read the records after counting them.
+     */
+    uint64_t count() { return skip(std::numeric_limits<uint64_t>::max()); }
+    //!\}
+
 protected:
     //!\privatesection
 
@@ -295,6 +335,12 @@ protected:
         std::visit([&](auto & f) { f.parse_next_record_into(record_buffer); }, format_handler);
     }
 
+    //!\brief Tell the format to skip records (behind the buffered one).
+    uint64_t skip_raw_records(uint64_t const n)
+    {
+        return std::visit([&](auto & f) { return f.skip_records(n); }, format_handler);
+    }
+
     //!\brief Befriend iterator so it can access the buffers.
     friend iterator;
 };
@@ -16,6 +16,8 @@
 #include <concepts>
 #include <iterator>
 #include <ranges>
+#include <string>
+#include <string_view>
 
 #include <bio/ranges/views/detail.hpp>
 
@@ -42,6 +44,19 @@ private:
     char const *     uend        = nullptr; //!< End of the underlying range.
     char const *     subend      = nullptr; //!< End of the current subrange.
     bool             skip_quotes = false;   //!< Whether to ignore delimiter inside quoted regions.
+
+    /*!\brief Find the first occurrence of c in [beg, end); returns end if there is none.
+     * \details
+     *
+     * This uses std::char_traits<char>::find which resolves to memchr() and is thus vectorised by the
+     * standard library on all relevant platforms.
+     */
+    static constexpr char const * find_or_end(char const * const beg, char const * const end, char const c) noexcept
+    {
+        char const * const res = std::char_traits<char>::find(beg, static_cast<size_t>(end - beg), c);
+        return res == nullptr ? end : res;
+    }
+
 public:
     /*!\name Associated types
      * \{
@@ -106,20 +121,30 @@ public:
     constexpr eager_split_iterator & operator++() noexcept
     {
         auto subbegin = subend;
-        if (skip_quotes)
+        if (subend < uend)
         {
-            bool in_quote = false;
-            while ((subend < uend) && (in_quote || (*subend != delimiter)))
+            if (skip_quotes)
             {
-                in_quote ^= (*subend == '\"');
-
-                ++subend;
+                while (true)
+                {
+                    char const * const next_delim = find_or_end(subend, uend, delimiter);
+                    char const * const next_quote = find_or_end(subend, next_delim, '\"');
+                    if (next_quote == next_delim) // no quote before delimiter
+                    {
+                        subend = next_delim;
+                        break;
+                    }
+                    // skip to behind the closing quote
+                    subend = find_or_end(next_quote + 1, uend, '\"');
+                    if (subend == uend)
+                        break;
+                    ++subend;
+                }
+            }
+            else
+            {
+                subend = find_or_end(subend, uend, delimiter);
             }
-        }
-        else
-        {
-            while ((subend < uend) && (*subend != delimiter))
-                ++subend;
         }
         subrange = std::string_view{subbegin, static_cast<size_t>(subend - subbegin)};
         // move behind delimiter
@@ -55,6 +55,44 @@ private:
     //!\brief Whether iterator is at end.
     bool at_end = false;
 
+    //!\brief Read l_shared and l_indiv of the next record; the buffer must not be empty.
+    std::pair<uint32_t, uint32_t> read_lengths()
+    {
+        uint32_t l_shared = 0;
+        uint32_t l_indiv  = 0;
+
+        // we have buffer, but it is not large enough to contain l_shared and l_indiv
+        if (ptrdiff_t remaining_buffer_size = stream_buf->egptr() - stream_buf->gptr(); remaining_buffer_size < 8)
+        {
+            overflow_buffer.resize(8);
+            std::ranges::copy(stream_buf->gptr(), stream_buf->egptr(), overflow_buffer.begin());
+            stream_buf->gbump(remaining_buffer_size);
+            stream_buf->underflow();
+
+            ptrdiff_t remaining_data_size = 8 - remaining_buffer_size;
+
+            if (stream_buf->egptr() - stream_buf->gptr() < remaining_data_size)
+                throw format_error{"End-of-BCF-Stream encountered before the record data could read."};
+
+            std::ranges::copy(stream_buf->gptr(),
+                              stream_buf->gptr() + remaining_data_size,
+                              overflow_buffer.begin() + remaining_buffer_size);
+            stream_buf->gbump(remaining_data_size);
+
+            l_shared = detail::to_little_endian(*(reinterpret_cast<uint32_t *>(overflow_buffer.data())));
+            l_indiv  = detail::to_little_endian(*(reinterpret_cast<uint32_t *>(overflow_buffer.data() + 4)));
+            overflow_buffer.clear();
+        }
+        else // read l_shared and l_indiv directly
+        {
+            l_shared = detail::to_little_endian(*(reinterpret_cast<uint32_t *>(stream_buf->gptr())));
+            l_indiv  = detail::to_little_endian(*(reinterpret_cast<uint32_t *>(stream_buf->gptr() + 4)));
+            stream_buf->gbump(8); // skip l_shared and l_indiv
+        }
+
+        return {l_shared, l_indiv};
+    }
+
 public:
     //!\brief The bcf format header.
     var::detail::bcf_header header;
@@ -180,37 +218,7 @@ public:
 
         overflow_buffer.clear();
 
-        uint32_t l_shared = 0;
-        uint32_t l_indiv  = 0;
-
-        // we have buffer, but it is not large enough to contain l_shared and l_indiv
-        if (ptrdiff_t remaining_buffer_size = stream_buf->egptr() - stream_buf->gptr(); remaining_buffer_size < 8)
-        {
-            overflow_buffer.resize(8);
-            std::ranges::copy(stream_buf->gptr(), stream_buf->egptr(), overflow_buffer.begin());
-            stream_buf->gbump(remaining_buffer_size);
-            stream_buf->underflow();
-
-            ptrdiff_t remaining_data_size = 8 - remaining_buffer_size;
-
-            if (stream_buf->egptr() - stream_buf->gptr() < remaining_data_size)
-                throw format_error{"End-of-BCF-Stream encountered before the record data could read."};
-
-            std::ranges::copy(stream_buf->gptr(),
-                              stream_buf->gptr() + remaining_data_size,
-                              overflow_buffer.begin() + remaining_buffer_size);
-            stream_buf->gbump(remaining_data_size);
-
-            l_shared = detail::to_little_endian(*(reinterpret_cast<uint32_t *>(overflow_buffer.data())));
-            l_indiv  = detail::to_little_endian(*(reinterpret_cast<uint32_t *>(overflow_buffer.data() + 4)));
-            overflow_buffer.clear();
-        }
-        else // read l_shared and l_indiv directly
-        {
-            l_shared = detail::to_little_endian(*(reinterpret_cast<uint32_t *>(stream_buf->gptr())));
-            l_indiv  = detail::to_little_endian(*(reinterpret_cast<uint32_t *>(stream_buf->gptr() + 4)));
-            stream_buf->gbump(8); // skip l_shared and l_indiv
-        }
+        auto [l_shared, l_indiv] = read_lengths();
 
         ptrdiff_t record_size = l_shared + l_indiv;
         genotype_offset       = l_shared;
@@ -258,6 +266,53 @@ public:
 
     //!\overload
     void operator++(int) { ++(*this); }
+
+    /*!\brief Skip records behind the current one.
+     * \param[in] n The number of records to skip.
+     * \returns The number of records skipped; smaller than `n` only if the end of input was reached.
+     * \details
+     *
+     * Only the length fields of each record are read; the rest of the record is skipped in the stream buffer without
+     * copying it. The current record is invalidated; increment the iterator to read the record behind the skipped
+     * ones.
+     */
+    uint64_t skip(uint64_t const n)
+    {
+        assert(stream_buf != nullptr);
+
+        uint64_t i = 0;
+        for (; !at_end && i < n; ++i)
+        {
+            if (stream_buf->egptr() == stream_buf->gptr())
+            {
+                stream_buf->underflow();
+                if (stream_buf->egptr() == stream_buf->gptr())
+                    break;
+            }
+
+            auto [l_shared, l_indiv] = read_lengths();
+            uint64_t remaining       = uint64_t{l_shared} + l_indiv;
+
+            if (remaining == 0)
+                throw format_error{"Record of size 0 found when reading BCF stream."};
+
+            while (remaining > 0)
+            {
+                if (stream_buf->egptr() == stream_buf->gptr())
+                {
+                    stream_buf->underflow();
+                    if (stream_buf->egptr() == stream_buf->gptr())
+                        throw format_error{"End-of-BCF-Stream encountered before the record ended."};
+                }
+
+                ptrdiff_t const step = std::min<uint64_t>(remaining, stream_buf->egptr() - stream_buf->gptr());
+                stream_buf->gbump(step);
+                remaining -= step;
+            }
+        }
+
+        return i;
+    }
     //!\}
 
     /*!\name Dereference operators
@@ -1053,6 +1108,15 @@ public:
 
     //!\brief This resets the stream iterator after region-seek.
     void reset_stream() { file_it.reset(*stream); }
+
+    /*!\brief Skip records without reading their content.
+     * \param[in] n The number of records to skip.
+     * \returns The number of records skipped; smaller than `n` only if the end of input was reached.
+     * \details
+     *
+     * Hops over the records via their `l_shared` and `l_indiv` length fields.
+     */
+    uint64_t skip_records(uint64_t const n) { return file_it.skip(n); }
 };
 
 /*!\brief Parse a "dynamically typed" field out of a BCF stream and store the content in a variant.
@@ -14,6 +14,7 @@
 #pragma once
 
 #include <algorithm>
+#include <cstring>
 #include <iostream>
 #include <ranges>
 #include <string>
@@ -28,6 +29,7 @@
 #include <bio/io/format/format_input_handler.hpp>
 #include <bio/io/misc/char_predicate.hpp>
 #include <bio/io/seq/record.hpp>
+#include <bio/io/stream/detail/fast_streambuf_iterator.hpp>
 #include <bio/io/txt/reader.hpp>
 
 namespace bio::io
@@ -53,14 +55,20 @@ namespace bio::io
  *
  * ### Performance
  *
- * Since FASTA records can be exceptionally large, FASTA input always involves an additional buffering step.
- * Even when performing raw or lowlevel I/O (returning std::string_view or std::span<std::byte const>), all data
- * is typically copied once from the input stream buffer. This also means, that raw I/O does not preserve formatting
- * (e.g. linebreaks) as-is.
+ * If the sequence of a record is on a single line and the record is completely contained in the buffer of the
+ * stream, the fields of the raw record are views into that buffer, i.e. shallow records are created without copying
+ * any data.
+ *
+ * Otherwise, e.g. for sequences split over multiple lines, the record is copied once from the input stream buffer
+ * into an internal buffer; the lines are appended as a whole (removing only whitespace and digits).
+ * This also means, that raw I/O does not preserve formatting (e.g. linebreaks) as-is.
  *
  * If sequence and/or ID are requested as std::string, the record's element is swapped with the internal buffer to
  * prevent a second copy, but if output is requested as e.g. std::vector<alphabet::dna4>, a second copy needs to happen.
  * Requesting views never implies a second copy.
+ *
+ * Fields that are not part of the record (or that are bio::meta::ignore_t) are skipped over and never copied; this is
+ * decided at compile-time. For example, reading only the IDs does not copy the sequence lines.
  */
 template <>
 class format_input_handler<fasta> :
@@ -116,12 +124,122 @@ private:
     lowlevel_iterator it;
     //!\brief A line counter.
     size_t            line = -1;
+    //!\brief Whether the fields of the current raw record refer to the internal buffers.
+    bool              in_buffers = false;
+
+    //!\brief Characters that begin the ID line.
+    static constexpr auto is_id        = is_char<'>'> || is_char<';'>;
+    //!\brief Characters that are removed from the sequence.
+    static constexpr auto is_seq_noise = is_space || is_digit;
+
+    //!\brief Return the stream buffer.
+    detail::stream_buffer_exposer<char> * stream_buf()
+    {
+        return reinterpret_cast<detail::stream_buffer_exposer<char> *>(stream->rdbuf());
+    }
+
+    //!\brief Set the ID field of the raw record (id is the ID-line without the leading character).
+    void set_id(std::string_view id)
+    {
+        if (truncate_ids)
+            id = id.substr(0, std::ranges::find_if(id, is_space) - id.begin());
+
+        get<detail::field::id>(raw_record) = id;
+    }
+
+    /*!\brief Read the raw record directly from the stream buffer.
+     * \returns `true` on success; `false` if the record cannot be read this way.
+     * \details
+     *
+     * This succeeds if the sequence is on a single line without whitespace or digits and if the record (and the
+     * beginning of the next record) are contained in the stream buffer. The fields of the raw record then point into
+     * the stream buffer and stay valid until the next record is read.
+     *
+     * If the function returns `false`, nothing has been consumed.
+     */
+    template <bool read_id, bool read_seq>
+    bool read_raw_record_in_stream_buffer()
+    {
+        if (stream_buf()->gptr() == stream_buf()->egptr())
+            stream_buf()->underflow();
+
+        char const * const beg = stream_buf()->gptr();
+        char const * const end = stream_buf()->egptr();
+
+        char const * const id_end = static_cast<char const *>(std::memchr(beg, '\n', end - beg));
+        if (id_end == nullptr || id_end == beg || (!is_id)(*beg))
+            return false;
+
+        char const * const seq_beg = id_end + 1;
+        char const * const seq_end = static_cast<char const *>(std::memchr(seq_beg, '\n', end - seq_beg));
+        if (seq_end == nullptr)
+            return false;
+
+        std::string_view id{beg + 1, static_cast<size_t>(id_end - beg - 1)};
+        std::string_view seq{seq_beg, static_cast<size_t>(seq_end - seq_beg)};
+        if (id.ends_with('\r'))
+            id.remove_suffix(1);
+        if (seq.ends_with('\r'))
+            seq.remove_suffix(1);
+
+        if (seq.empty() || (read_seq && std::ranges::any_of(seq, is_seq_noise)))
+            return false;
+
+        // skip empty lines; the record is only complete if the next one begins in the buffer
+        size_t       n_lines = 2;
+        char const * cur     = seq_end + 1;
+        while (cur != end && (*cur == '\n' || (*cur == '\r' && cur + 1 != end && cur[1] == '\n')))
+        {
+            cur += (*cur == '\r') + 1;
+            ++n_lines;
+        }
+
+        if (cur == end || (!is_id)(*cur))
+            return false;
 
-    //!\brief Read the raw record [the base class invokes this function].
+        if constexpr (read_id)
+            set_id(id);
+        else
+            get<detail::field::id>(raw_record) = {};
+        get<detail::field::seq>(raw_record) = read_seq ? seq : std::string_view{};
+
+        stream_buf()->gbump(cur - beg);
+        line += n_lines;
+        in_buffers = false;
+        return true;
+    }
+
+    //!\brief Append a piece of a sequence line to the sequence buffer.
+    void append_seq(std::string_view const piece)
+    {
+        // lines typically consist only of sequence characters (and possibly a trailing '\r')
+        auto const noise = std::ranges::find_if(piece, is_seq_noise);
+        seq_buffer.append(piece.begin(), noise);
+
+        if (noise != piece.end())
+        {
+            std::ranges::copy(std::ranges::subrange{noise, piece.end()} | std::views::filter(!is_seq_noise),
+                              std::back_insert_iterator{seq_buffer});
+        }
+    }
+
+    /*!\brief Read the raw record [the base class invokes this function].
+     * \tparam parsed_record_t The record that the raw record is parsed into (a bio::io::detail::tuple_record).
+     * \details
+     *
+     * Fields that are not contained in `parsed_record_t` or that are ignored are skipped over; they are empty in the
+     * raw record. Sequence lines that are skipped are not checked for valid characters.
+     */
+    template <typename parsed_record_t = raw_record_type>
     void read_raw_record()
     {
-        constexpr auto not_id = !(is_char<'>'> || is_char<';'>);
+        constexpr bool read_id  = detail::has_non_ignore_field<detail::field::id, parsed_record_t>();
+        constexpr bool read_seq = detail::has_non_ignore_field<detail::field::seq, parsed_record_t>();
 
+        if (read_raw_record_in_stream_buffer<read_id, read_seq>())
+            return;
+
+        in_buffers = true;
         id_buffer.clear();
         seq_buffer.clear();
         raw_record.clear();
@@ -138,36 +256,54 @@ private:
         if (current_line.empty())
             error("Expected to be on begin of record but is on empty line.");
 
-        if (not_id(current_line[0]))
+        if ((!is_id)(current_line[0]))
             error("Record does not begin with '>' or ';'.");
 
-        if (truncate_ids)
-        {
-            size_t e = 1;
-            for (; e < current_line.size() && (!is_space)(current_line[e]); ++e)
-            {}
-            detail::string_copy(current_line.substr(1, e - 1), id_buffer);
-        }
-        else
+        if constexpr (read_id)
         {
-            detail::string_copy(current_line.substr(1), id_buffer);
+            set_id(current_line.substr(1));
+            detail::string_copy(get<detail::field::id>(raw_record), id_buffer);
+            get<detail::field::id>(raw_record) = id_buffer;
         }
-        get<detail::field::id>(raw_record) = id_buffer;
 
         /* READ SEQ */
-        /* Implementation NOTE: we create and compare a streambuf iterator here and do not check the line-iterator
-         * (it != std::default_sentinel) && ...
-         * because the line-iterator is "at end" one iteration later than the stream itself [it holds the line just
-         * before the current stream-buffer pointer]. If we don't do this, the peak() might fail.
+        /* Implementation NOTE: the sequence lines are read from the stream buffer directly; lines are located via
+         * memchr and appended as a whole, so there is no per-character work for regular sequence lines.
          */
-        while ((std::istreambuf_iterator<char>{*stream} != std::istreambuf_iterator<char>{}) && not_id(it.peak()))
+        bool at_line_start = true;
+        bool has_seq       = false; // only tracked if the sequence is skipped
+        while (true)
         {
-            ++it;
-            ++line;
-            std::ranges::copy(*it | std::views::filter(!(is_space || is_digit)), std::back_insert_iterator{seq_buffer});
+            if (stream_buf()->gptr() == stream_buf()->egptr())
+            {
+                stream_buf()->underflow();
+                if (stream_buf()->gptr() == stream_buf()->egptr())
+                    break;
+            }
+
+            char const * const cur = stream_buf()->gptr();
+            char const * const end = stream_buf()->egptr();
+
+            if (at_line_start)
+            {
+                if (is_id(*cur))
+                    break;
+                ++line;
+            }
+
+            char const * const eol     = static_cast<char const *>(std::memchr(cur, '\n', end - cur));
+            char const * const seg_end = eol == nullptr ? end : eol;
+
+            if constexpr (read_seq)
+                append_seq(std::string_view{cur, static_cast<size_t>(seg_end - cur)});
+            else if (seg_end != cur && *cur != '\r') // not an empty line
+                has_seq = true;
+
+            stream_buf()->gbump(seg_end - cur + (eol != nullptr));
+            at_line_start = eol != nullptr;
         }
 
-        if (seq_buffer.empty())
+        if (read_seq ? seq_buffer.empty() : !has_seq)
             error("No sequence or no valid sequence characters.");
         get<detail::field::seq>(raw_record) = seq_buffer;
     }
@@ -177,16 +313,22 @@ private:
      * \brief This is mostly done via the defaults in the base class.
      * \{
      */
-    //!\brief We can prevent another copy if the user wants a string.
+    //!\brief We can prevent another copy if the user wants a string and the record was copied.
     void parse_field(meta::vtag_t<detail::field::id> const & /**/, std::string & parsed_field)
     {
-        std::swap(id_buffer, parsed_field);
+        if (in_buffers)
+            std::swap(id_buffer, parsed_field);
+        else
+            detail::string_copy(get<detail::field::id>(raw_record), parsed_field);
     }
 
-    //!\brief We can prevent another copy if the user wants a string.
+    //!\brief We can prevent another copy if the user wants a string and the record was copied.
     void parse_field(meta::vtag_t<detail::field::seq> const & /**/, std::string & parsed_field)
     {
-        std::swap(seq_buffer, parsed_field);
+        if (in_buffers)
+            std::swap(seq_buffer, parsed_field);
+        else
+            detail::string_copy(get<detail::field::seq>(raw_record), parsed_field);
     }
     //!\}
 
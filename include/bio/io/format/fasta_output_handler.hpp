@@ -13,8 +13,18 @@
 
 #pragma once
 
+#include <exception>
+#include <filesystem>
+#include <optional>
+#include <ranges>
+#include <string>
+#include <string_view>
+
+#include <bio/io/detail/line_wrap.hpp>
+#include <bio/io/detail/utility.hpp>
 #include <bio/io/format/fasta.hpp>
 #include <bio/io/format/format_output_handler.hpp>
+#include <bio/io/seq/fai_index.hpp>
 #include <bio/io/seq/record.hpp>
 #include <bio/io/stream/detail/fast_streambuf_iterator.hpp>
 
@@ -37,9 +47,12 @@ namespace bio::io
  *
  * | Member              | Type    | Default | Description                                                       |
  * |---------------------|---------|---------|-------------------------------------------------------------------|
+ * |`fai_file`           |`path`   | `""`    | If set, a FAI index is created and written to this file.          |
  * |`max_seq_line_length`|`size_t` | 0       | Whether to split sequence lines after N characters.               |
  * |`windows_eol`        |`bool`   | `false` | Whether old-Windows style carriage return characters are printed. |
  *
+ * The FAI index (see bio::io::seq::fai_index) is written when the handler is destructed. It can only be created
+ * if the output is uncompressed or BGZF-compressed.
  */
 template <>
 class format_output_handler<fasta> : public format_output_handler_base<format_output_handler<fasta>>
@@ -54,15 +67,28 @@ private:
     friend base_t;
 
     using base_t::it;
+    using base_t::stream;
     using base_t::write_field_aux;
     //!\}
 
     //!\brief Insert empty line between records. [this is not an option]
     bool insert_newline = false;
 
+    //!\brief The FAI index being recorded (only if requested).
+    std::optional<seq::fai_index> fai;
+    //!\brief Track whether this object has been moved from.
+    detail::move_tracker          move_tracker;
+    //!\brief Buffer for sequence lines that are converted in bulk.
+    std::string                   line_buffer;
+    //!\brief Buffer for the wrapped sequence lines.
+    std::string                   wrap_buffer;
+
     /*!\name Options
      * \{
      */
+    //!\brief Where to write the FAI index to.
+    std::filesystem::path fai_file;
+
     //!\brief Break seq-lines after N characters.
     size_t max_seq_line_length = 0;
 
@@ -85,41 +111,101 @@ private:
         write_field_aux(record.id);
         it->write_end_of_line(windows_eol);
 
+        seq::fai_index::entry_t fai_entry;
+        if (fai.has_value())
+        {
+            fai_entry.name   = id_to_name(record.id);
+            fai_entry.offset = tell();
+        }
+
         /* SEQ */
         static_assert(meta::different_from<typename record_t::seq_t, meta::ignore_t>,
                       "The record must contain the SEQ field.");
 
         if (max_seq_line_length > 0)
         {
-#if 0 // in SeqAn3, the following was slow; benchmark again!
-            write_field_aux(record.id | views::to_char | views::interleave(max_seq_line_length, windows_eol ? std::string_view{"\r\n"} : std::string_view{"\n"}));
-#else
-            auto char_sequence = record.seq | views::to_char;
-            auto cit           = std::ranges::begin(char_sequence);
-            auto end           = std::ranges::end(char_sequence);
-
-            while (cit != end)
+            if constexpr (io::detail::bulk_char_convertible<std::remove_cvref_t<typename record_t::seq_t>>)
             {
-                /* Note: This solution is slightly suboptimal for sized but non-random-access ranges.*/
-                auto   current_end = cit;
-                size_t steps       = std::ranges::advance(current_end, max_seq_line_length, end);
-                using subrange_t =
-                  std::ranges::subrange<decltype(cit), decltype(cit), std::ranges::subrange_kind::sized>;
-                cit = it.write_range(subrange_t{cit, current_end, (max_seq_line_length - steps)});
-
-                it->write_end_of_line(windows_eol);
+                // convert line-wise, e.g. from packed sequences
+                line_buffer.resize(max_seq_line_length);
+                for (size_t pos = 0; pos < std::ranges::size(record.seq); pos += max_seq_line_length)
+                {
+                    size_t const count = record.seq.to_chars(pos, max_seq_line_length, line_buffer.data());
+                    it.write_range(std::string_view{line_buffer.data(), count});
+                    fai_entry.length += count;
+
+                    it->write_end_of_line(windows_eol);
+                }
             }
-#endif
+            else
+            {
+                // convert to characters (if necessary) and wrap the lines in a buffer
+                std::string_view chars;
+                using seq_t = typename record_t::seq_t;
+                if constexpr (std::ranges::contiguous_range<seq_t> && std::ranges::sized_range<seq_t> &&
+                              io::detail::char_range<seq_t>)
+                {
+                    chars = std::string_view{std::ranges::data(record.seq), std::ranges::size(record.seq)};
+                }
+                else
+                {
+                    line_buffer.clear();
+                    for (char const c : record.seq | views::to_char)
+                        line_buffer.push_back(c);
+                    chars = line_buffer;
+                }
+
+                wrap_buffer.clear();
+                detail::append_wrapped(wrap_buffer, chars, max_seq_line_length, windows_eol);
+                it.write_range(std::string_view{wrap_buffer});
+                fai_entry.length += chars.size();
+            }
+            fai_entry.linebases = std::min<uint64_t>(fai_entry.length, max_seq_line_length);
         }
         else
         {
             write_field_aux(record.seq);
+            if (fai.has_value())
+                fai_entry.length = tell() - fai_entry.offset;
             it->write_end_of_line(windows_eol);
+
+            fai_entry.linebases = fai_entry.length;
+        }
+
+        if (fai.has_value())
+        {
+            if (fai_entry.linebases > 0)
+                fai_entry.linewidth = fai_entry.linebases + (windows_eol ? 2 : 1);
+            fai->push_back(std::move(fai_entry));
         }
 
         insert_newline = !std::ranges::empty(record.seq);
     }
 
+    //!\brief The name of a sequence in the FAI index (the ID up until the first whitespace).
+    template <typename id_t>
+    static std::string id_to_name(id_t const & id)
+    {
+        std::string name;
+        if constexpr (std::convertible_to<id_t const &, std::string_view>)
+        {
+            name = std::string_view{id};
+        }
+        else
+        {
+            for (char const c : id | views::to_char)
+                name.push_back(c);
+        }
+
+        return name.substr(0, name.find_first_of(" \t\f\v\r"));
+    }
+
+    //!\brief Return the current position in the uncompressed output.
+    uint64_t tell()
+    {
+        return static_cast<uint64_t>(stream->rdbuf()->pubseekoff(0, std::ios_base::cur, std::ios_base::out));
+    }
+
 public:
     /*!\name Constructors, destructor and assignment.
      * \brief These are all private to prevent wrong instantiation.
@@ -130,7 +216,6 @@ public:
     format_output_handler(format_output_handler &&)                  = default; //!< Defaulted.
     format_output_handler & operator=(format_output_handler const &) = delete;  //!< Deleted.
     format_output_handler & operator=(format_output_handler &&)      = default; //!< Defaulted.
-    ~format_output_handler()                                         = default; //!< Defaulted.
 
     /*!\brief Construct with an options object.
      * \param[in,out] str The output stream.
@@ -143,16 +228,51 @@ public:
     format_output_handler(std::ostream & str, auto const & options) : base_t{str}
     {
         // extract options
+        if constexpr (requires { (std::filesystem::path) options.fai_file; })
+            fai_file = options.fai_file;
         if constexpr (requires { (size_t) options.max_seq_line_length; })
             max_seq_line_length = options.max_seq_line_length;
         if constexpr (requires { (bool)options.windows_eol; })
             windows_eol = options.windows_eol;
+
+        if (!fai_file.empty())
+        {
+            if (static_cast<std::streamoff>(tell()) < 0)
+                throw bio_error{"FAI indexes can only be created for uncompressed or BGZF compressed output."};
+            fai.emplace();
+        }
     }
 
     //!\brief Construct with only an output stream.
     format_output_handler(std::ostream & str) : format_output_handler(str, 1) {}
+
+    //!\brief The destructor writes the FAI index if requested.
+    ~format_output_handler() noexcept(false)
+    {
+        // never throw if the stack is unwinding
+        if (std::uncaught_exceptions() > 0)
+            return;
+
+        // no cleanup is needed if we are in moved-from state
+        if (move_tracker.moved_from)
+            return;
+
+        if (fai.has_value())
+            fai->write(fai_file);
+    }
     //!\}
 
+    /*!\brief Set up the handler as if the given record had been written before [used for formatting in parallel].
+     * \details
+     *
+     * Records with a non-empty sequence are followed by an empty line if another record is written.
+     */
+    template <typename... field_types>
+    void continue_after(seq::record<field_types...> const & previous)
+    {
+        insert_newline = !std::ranges::empty(previous.seq);
+    }
+
     //!\brief Write the record.
     template <typename... field_types>
     void write_record(seq::record<field_types...> const & record)
@@ -14,7 +14,9 @@
 #pragma once
 
 #include <algorithm>
+#include <cstring>
 #include <iostream>
+#include <iterator>
 #include <ranges>
 #include <string>
 #include <string_view>
@@ -23,11 +25,13 @@
 #include <bio/meta/tag/vtag.hpp>
 #include <bio/ranges/views/to_char.hpp>
 
+#include <bio/io/detail/quality.hpp>
 #include <bio/io/detail/range.hpp>
 #include <bio/io/format/fastq.hpp>
 #include <bio/io/format/format_input_handler.hpp>
 #include <bio/io/misc/char_predicate.hpp>
 #include <bio/io/seq/record.hpp>
+#include <bio/io/stream/detail/fast_streambuf_iterator.hpp>
 #include <bio/io/txt/reader.hpp>
 
 namespace bio::io
@@ -47,14 +51,34 @@ namespace bio::io
  * The following options are considered if the respective member variable is availabele in the object passed to
  * the constructor:
  *
- * | Member          | Type    | Default | Description                                         |
- * |-----------------|---------|---------|-----------------------------------------------------|
- * |`truncate_ids`   |`bool`   | `false` | Whether to truncate IDs on the first whitespace     |
+ * | Member               | Type     | Default | Description                                                  |
+ * |----------------------|----------|---------|--------------------------------------------------------------|
+ * |`compute_qual_stats`  |`bool`    | `false` | Whether to compute mean and minimum quality of every record  |
+ * |`qual_offset`         |`uint8_t` | `33`    | The ASCII offset of the qualities (e.g. 64 for old Illumina) |
+ * |`truncate_ids`        |`bool`    | `false` | Whether to truncate IDs on the first whitespace              |
+ *
+ * ### Qualities
+ *
+ * The qualities of every record are checked to be in the range `[qual_offset, '~']`. If the offset is not 33, the
+ * qualities are converted to Phred+33 encoding, i.e. the records always contain Phred+33 characters. Validation,
+ * conversion and the computation of bio::io::seq::qual_stats (see current_qual_stats()) happen in a single pass.
+ * If the qualities are not part of the record (or bio::meta::ignore_t) and no statistics are computed, they are not
+ * validated; only their length is compared with the length of the sequence.
  *
  * ### Performance
  *
- * The current implementation is not optimised for performance and performs an unnecessary copy operation––even
- * when shallow records are returned.
+ * If a record is completely contained in the buffer of the stream, the fields of the raw record are views into
+ * that buffer, i.e. shallow records are created without copying any data. Only records that cross the boundary
+ * of the stream buffer are copied into internal buffers.
+ *
+ * Long records (e.g. multi-megabase reads) are copied exactly once: the sequence is appended to the internal buffer
+ * directly from the stream buffer (line-endings are found via `memchr`), and the qualities, whose length is known
+ * from the sequence, are read into the internal buffer with a single `sgetn()` call, which allows stream buffers to
+ * bypass their own buffer. The internal buffers keep their capacity between records.
+ *
+ * Fields that are not part of the record (or that are bio::meta::ignore_t) are skipped over and never copied; this is
+ * decided at compile-time. For example, reading only the sequences does not copy IDs or qualities, and IDs are not
+ * truncated.
  */
 template <>
 class format_input_handler<fastq> :
@@ -87,8 +111,12 @@ private:
     /*!\name Options
      * \{
      */
+    //!\brief Whether to compute the mean and minimum quality of every record.
+    bool    compute_qual_stats = false;
+    //!\brief The ASCII offset of the qualities.
+    uint8_t qual_offset        = 33;
     //!\brief Whether to truncate IDs on first whitespace.
-    bool truncate_ids = false;
+    bool    truncate_ids       = false;
     //!\}
 
     /*!\name Raw record handling
@@ -114,13 +142,236 @@ private:
     lowlevel_iterator it;
     //!\brief A line counter.
     size_t            line = -1;
+    //!\brief Whether the fields of the current raw record refer to the internal buffers.
+    bool              in_buffers = false;
+    //!\brief Quality statistics of the current record.
+    seq::qual_stats   stats;
+
+    /*!\brief Split the four lines of a record beginning at the given position.
+     * \param[in] buffer The buffer.
+     * \param[in] pos Position of the first line.
+     * \param[in] at_eof Whether the end of the buffer is the end of the input (the last line may then lack a newline).
+     * \param[out] lines The four lines (without line-endings).
+     * \returns The position behind the record or #npos if the record is not completely contained in the buffer.
+     */
+    static size_t split_lines(std::string_view const buffer,
+                              size_t                 pos,
+                              bool const             at_eof,
+                              std::string_view (&lines)[4]) noexcept
+    {
+        for (size_t i = 0; i < 4; ++i)
+        {
+            if (pos == buffer.size())
+                return npos;
+
+            size_t eol = buffer.find('\n', pos);
+            if (eol == std::string_view::npos)
+            {
+                if (!at_eof || i < 3)
+                    return npos;
+                eol = buffer.size();
+            }
+
+            lines[i] = buffer.substr(pos, eol - pos);
+            if (lines[i].ends_with('\r'))
+                lines[i].remove_suffix(1);
+            pos = std::min(eol + 1, buffer.size());
+        }
+
+        return pos;
+    }
+
+    //!\brief Whether the lines form a valid record.
+    static bool is_record(std::string_view const (&lines)[4]) noexcept
+    {
+        return lines[0].starts_with('@') && lines[2].starts_with('+') && lines[1].size() == lines[3].size();
+    }
+
+    //!\brief Extract the ID from the ID-line.
+    static std::string_view id_from_line(std::string_view const id_line, bool const truncate) noexcept
+    {
+        std::string_view id = id_line.substr(1);
+        if (truncate)
+            id = id.substr(0, std::ranges::find_if(id, is_space) - id.begin());
+        return id;
+    }
 
-    //!\brief Read the raw record [the base class invokes this function].
+    /*!\brief Read the raw record directly from the stream buffer.
+     * \returns `true` on success; `false` if the record is not completely buffered or is not well-formed.
+     * \details
+     *
+     * This finds the four line-endings of the record in the stream buffer and makes the fields of the raw record
+     * point into the stream buffer. They stay valid until the next record is read.
+     *
+     * If the function returns `false`, nothing has been consumed, and the record needs to be read
+     * via the low-level iterator (which also generates the appropriate error messages).
+     */
+    template <bool read_id>
+    bool read_raw_record_in_stream_buffer()
+    {
+        auto * stream_buf = reinterpret_cast<detail::stream_buffer_exposer<char> *>(stream->rdbuf());
+        if (stream_buf->gptr() == stream_buf->egptr())
+            stream_buf->underflow();
+
+        std::string_view const buffer{stream_buf->gptr(),
+                                      static_cast<size_t>(stream_buf->egptr() - stream_buf->gptr())};
+
+        std::string_view lines[4];
+        size_t const     record_end = split_lines(buffer, 0, false, lines);
+        if (record_end == npos || !is_record(lines))
+            return false;
+
+        get<detail::field::id>(raw_record)   = read_id ? id_from_line(lines[0], truncate_ids) : std::string_view{};
+        get<detail::field::seq>(raw_record)  = lines[1];
+        get<detail::field::qual>(raw_record) = lines[3];
+
+        stream_buf->gbump(record_end);
+        line += 4;
+        in_buffers = false;
+        return true;
+    }
+
+    /*!\brief Read the raw record [the base class invokes this function].
+     * \tparam parsed_record_t The record that the raw record is parsed into (a bio::io::detail::tuple_record).
+     * \details
+     *
+     * Fields that are not contained in `parsed_record_t` or that are ignored are skipped over; they are empty in the
+     * raw record.
+     */
+    template <typename parsed_record_t = raw_record_type>
     void read_raw_record()
     {
+        constexpr bool read_id   = detail::has_non_ignore_field<detail::field::id, parsed_record_t>();
+        constexpr bool read_seq  = detail::has_non_ignore_field<detail::field::seq, parsed_record_t>();
+        constexpr bool read_qual = detail::has_non_ignore_field<detail::field::qual, parsed_record_t>();
+
+        if (!read_raw_record_in_stream_buffer<read_id>())
+            read_raw_record_via_iterator<read_id, read_seq, read_qual>();
+
+        if (read_qual || compute_qual_stats)
+            process_qualities();
+    }
+
+    //!\brief Return the stream buffer.
+    detail::stream_buffer_exposer<char> * stream_buf()
+    {
+        return reinterpret_cast<detail::stream_buffer_exposer<char> *>(stream->rdbuf());
+    }
+
+    /*!\brief Append the rest of the current line to `buffer` and move behind the line-ending.
+     * \returns `false` if the end of the input was reached before reading anything.
+     */
+    bool append_line(std::string & buffer)
+    {
+        size_t const old_size = buffer.size();
+        bool         read_any = false;
+        while (true)
+        {
+            if (stream_buf()->gptr() == stream_buf()->egptr())
+            {
+                stream_buf()->underflow();
+                if (stream_buf()->gptr() == stream_buf()->egptr())
+                    break;
+            }
+
+            char const * const cur     = stream_buf()->gptr();
+            char const * const end     = stream_buf()->egptr();
+            char const * const eol     = static_cast<char const *>(std::memchr(cur, '\n', end - cur));
+            char const * const seg_end = eol == nullptr ? end : eol;
+
+            buffer.append(cur, seg_end);
+            stream_buf()->gbump(seg_end - cur + (eol != nullptr));
+            read_any = true;
+
+            if (eol != nullptr)
+                break;
+        }
+
+        if (buffer.size() > old_size && buffer.back() == '\r')
+            buffer.pop_back();
+        return read_any;
+    }
+
+    /*!\brief Move behind the current line without copying it.
+     * \returns The length of the line (without the line-ending).
+     */
+    size_t skip_line()
+    {
+        size_t length  = 0;
+        bool   ends_cr = false;
+        while (true)
+        {
+            if (stream_buf()->gptr() == stream_buf()->egptr())
+            {
+                stream_buf()->underflow();
+                if (stream_buf()->gptr() == stream_buf()->egptr())
+                    break;
+            }
+
+            char const * const cur     = stream_buf()->gptr();
+            char const * const end     = stream_buf()->egptr();
+            char const * const eol     = static_cast<char const *>(std::memchr(cur, '\n', end - cur));
+            char const * const seg_end = eol == nullptr ? end : eol;
+
+            length += seg_end - cur;
+            if (seg_end != cur)
+                ends_cr = seg_end[-1] == '\r';
+            stream_buf()->gbump(seg_end - cur + (eol != nullptr));
+
+            if (eol != nullptr)
+                break;
+        }
+
+        return length - ends_cr;
+    }
+
+    /*!\brief Read the quality line into #qual_buffer, expecting the same length as the sequence.
+     * \param[in] expected The length of the sequence.
+     * \details
+     *
+     * The expected number of characters is read in one piece. If the line is shorter or longer, a size mismatch is
+     * reported.
+     */
+    void read_qual_line(size_t const expected)
+    {
+        qual_buffer.resize(expected);
+        size_t const n_read = stream_buf()->sgetn(qual_buffer.data(), expected);
+
+        // '\r' is not a valid quality character, so it marks the end of a line, too
+        if (size_t const eol = std::string_view{qual_buffer.data(), n_read}.find_first_of("\r\n");
+            eol != std::string_view::npos || n_read < expected)
+        {
+            error("Size mismatch between sequence (", expected, ") and qualities (", std::min(eol, n_read), ").");
+        }
+
+        if (stream_buf()->sgetc() == '\r')
+            stream_buf()->sbumpc();
+
+        if (int const c = stream_buf()->sgetc(); c == '\n')
+        {
+            stream_buf()->sbumpc();
+        }
+        else if (c != std::char_traits<char>::eof())
+        {
+            append_line(qual_buffer);
+            error("Size mismatch between sequence (", expected, ") and qualities (", qual_buffer.size(), ").");
+        }
+    }
+
+    /*!\brief Read the raw record line-by-line via the low-level iterator; copies the fields into the buffers.
+     * \tparam read_id   Whether to copy the ID (otherwise, the line is only checked to begin with '@').
+     * \tparam read_seq  Whether to copy the sequence (otherwise, it is only skipped over).
+     * \tparam read_qual Whether to copy the qualities (otherwise, only their length is checked unless statistics are
+     * computed).
+     */
+    template <bool read_id, bool read_seq, bool read_qual>
+    void read_raw_record_via_iterator()
+    {
+        in_buffers = true;
         id_buffer.clear();
         seq_buffer.clear();
         qual_buffer.clear();
+        raw_record.clear();
 
         /* READ ID */
         {
@@ -138,32 +389,34 @@ private:
             if ((!is_char<'@'>)(current_line[0]))
                 error("ID-line does not begin with '@'.");
 
-            if (truncate_ids)
-            {
-                size_t e = 1;
-                for (; e < current_line.size() && (!is_space)(current_line[e]); ++e)
-                {}
-                detail::string_copy(current_line.substr(1, e - 1), id_buffer);
-            }
-            else
+            if constexpr (read_id)
             {
-                detail::string_copy(current_line.substr(1), id_buffer);
+                detail::string_copy(id_from_line(current_line, truncate_ids), id_buffer);
+                get<detail::field::id>(raw_record) = id_buffer;
             }
-
-            get<detail::field::id>(raw_record) = id_buffer;
         }
 
         /* READ SEQ */
+        size_t seq_size = 0;
         {
-            ++it;
             ++line;
 
-            if (it == std::default_sentinel)
-                error("Reached end of file while trying to read SEQ.");
+            // read from the stream buffer directly to avoid copying long lines twice
+            if constexpr (read_seq)
+            {
+                if (!append_line(seq_buffer)) // is allowed to be empty
+                    error("Reached end of file while trying to read SEQ.");
 
-            detail::string_copy(*it, seq_buffer); // is allowed to be empty
+                seq_size                            = seq_buffer.size();
+                get<detail::field::seq>(raw_record) = seq_buffer;
+            }
+            else
+            {
+                if (stream_buf()->sgetc() == std::char_traits<char>::eof())
+                    error("Reached end of file while trying to read SEQ.");
 
-            get<detail::field::seq>(raw_record) = seq_buffer;
+                seq_size = skip_line();
+            }
         }
 
         /* READ third line */
@@ -182,19 +435,50 @@ private:
 
         /* READ QUAL */
         {
-            ++it;
             ++line;
 
-            if (it == std::default_sentinel)
+            if (stream_buf()->sgetc() == std::char_traits<char>::eof())
                 error("Reached end of file while trying to read QUALITIES.");
 
-            detail::string_copy(*it, qual_buffer); // is allowed to be empty
+            if (read_qual || compute_qual_stats)
+            {
+                read_qual_line(seq_size); // is allowed to be empty
+                get<detail::field::qual>(raw_record) = qual_buffer;
+            }
+            else if (size_t const qual_size = skip_line(); qual_size != seq_size)
+            {
+                error("Size mismatch between sequence (", seq_size, ") and qualities (", qual_size, ").");
+            }
+        }
+    }
+
+    //!\brief Validate the qualities, convert them to Phred+33 and compute the statistics.
+    void process_qualities()
+    {
+        std::string_view const     qual    = get<detail::field::qual>(raw_record);
+        detail::qual_summary const summary = detail::summarise_qualities(qual);
+
+        if (!qual.empty() && (summary.min < qual_offset || summary.max > '~'))
+        {
+            char const c = *std::ranges::find_if(qual, [&](uint8_t const c) { return c < qual_offset || c > '~'; });
+            error("Invalid character '", c, "' in qualities (Phred+", static_cast<size_t>(qual_offset), ").");
+        }
 
+        if (qual_offset != 33)
+        {
+            qual_buffer.resize(qual.size()); // no-op if the qualities are already in the buffer
+            detail::shift_qualities(qual, qual_buffer.data(), qual_offset - 33);
             get<detail::field::qual>(raw_record) = qual_buffer;
         }
 
-        if (size_t ssize = seq_buffer.size(), qsize = qual_buffer.size(); ssize != qsize)
-            error("Size mismatch between sequence (", ssize, ") and qualities (", qsize, ").");
+        if (compute_qual_stats)
+        {
+            if (qual.empty())
+                stats = {};
+            else
+                stats = {.mean = static_cast<double>(summary.sum - qual.size() * qual_offset) / qual.size(),
+                         .min  = static_cast<uint8_t>(summary.min - qual_offset)};
+        }
     }
     //!\}
 
@@ -202,22 +486,31 @@ private:
      * \brief This is mostly done via the defaults in the base class.
      * \{
      */
-    //!\brief We can prevent another copy if the user wants a string.
+    //!\brief We can prevent another copy if the user wants a string and the record was copied.
     void parse_field(meta::vtag_t<detail::field::id> const & /**/, std::string & parsed_field)
     {
-        std::swap(id_buffer, parsed_field);
+        if (in_buffers)
+            std::swap(id_buffer, parsed_field);
+        else
+            detail::string_copy(get<detail::field::id>(raw_record), parsed_field);
     }
 
-    //!\brief We can prevent another copy if the user wants a string.
+    //!\brief We can prevent another copy if the user wants a string and the record was copied.
     void parse_field(meta::vtag_t<detail::field::seq> const & /**/, std::string & parsed_field)
     {
-        std::swap(seq_buffer, parsed_field);
+        if (in_buffers)
+            std::swap(seq_buffer, parsed_field);
+        else
+            detail::string_copy(get<detail::field::seq>(raw_record), parsed_field);
     }
 
-    //!\brief We can prevent another copy if the user wants a string.
+    //!\brief We can prevent another copy if the user wants a string and the record was copied.
     void parse_field(meta::vtag_t<detail::field::qual> const & /**/, std::string & parsed_field)
     {
-        std::swap(qual_buffer, parsed_field);
+        if (in_buffers)
+            std::swap(qual_buffer, parsed_field);
+        else
+            detail::string_copy(get<detail::field::qual>(raw_record), parsed_field);
     }
     //!\}
 
@@ -243,6 +536,18 @@ public:
      */
     format_input_handler(std::istream & str, auto const & options) : base_t{str}, it{str, false}
     {
+        if constexpr (requires { (bool)options.compute_qual_stats; })
+        {
+            compute_qual_stats = options.compute_qual_stats;
+        }
+
+        if constexpr (requires { (uint8_t) options.qual_offset; })
+        {
+            qual_offset = options.qual_offset;
+            if (qual_offset < 33)
+                throw bio_error{"The quality offset must be at least 33."};
+        }
+
         if constexpr (requires { (bool)options.truncate_ids; })
         {
             truncate_ids = options.truncate_ids;
@@ -252,6 +557,132 @@ public:
     //!\brief Construct with only an input stream.
     format_input_handler(std::istream & str) : format_input_handler{str, int{}} {}
     //!\}
+
+    /*!\brief Skip records without reading their content.
+     * \param[in] n The number of records to skip.
+     * \returns The number of records skipped; smaller than `n` only if the end of input was reached.
+     * \details
+     *
+     * Every record is assumed to consist of exactly four lines which are skipped on the stream buffer directly. Only
+     * the first characters of the ID-line and the third line are checked; sequence and quality lengths are not
+     * compared.
+     */
+    uint64_t skip_records(uint64_t const n)
+    {
+        auto at_eof = [&] { return std::istreambuf_iterator<char>{*stream} == std::istreambuf_iterator<char>{}; };
+
+        uint64_t i = 0;
+        for (; i < n && !at_eof(); ++i)
+        {
+            ++line;
+            if ((!is_char<'@'>)(it.peak()))
+                error("ID-line does not begin with '@'.");
+
+            if (it.skip_lines(2) < 2 || at_eof())
+                error("Reached end of file while trying to read third FastQ record line.");
+            line += 2;
+
+            if ((!is_char<'+'>)(it.peak()))
+                error("Third FastQ record line does not begin with '+'.");
+
+            if (it.skip_lines(2) < 2)
+                error("Reached end of file while trying to read QUALITIES.");
+            ++line;
+        }
+
+        return i;
+    }
+
+    /*!\brief The quality statistics of the current record.
+     * \details
+     *
+     * Only computed if the `compute_qual_stats` option is set (see above); otherwise default-initialised.
+     */
+    seq::qual_stats const & current_qual_stats() const noexcept { return stats; }
+
+    /*!\name Parsing from memory
+     * \brief Interfaces for parsing FastQ data that has been read into memory, e.g. on multiple threads.
+     * \{
+     */
+    //!\brief Returned if a record is not completely contained in the buffer.
+    static constexpr size_t npos = std::string_view::npos;
+
+    /*!\brief Find the first record that begins at or behind the given position.
+     * \param[in] buffer The buffer (any part of a FastQ file).
+     * \param[in] pos The position to start searching from.
+     * \param[in] at_eof Whether the end of the buffer is the end of the input.
+     * \returns The position of the record or the size of the buffer if none could be found.
+     * \details
+     *
+     * A line is considered the beginning of a record if it begins with '@', the third line begins with '+' and
+     * the second and fourth line have the same length. Quality lines may begin with '@', but they are never followed
+     * by a line beginning with '+' two lines later, so this is only ambiguous for malformed files. Callers should
+     * nevertheless validate the result, e.g. by checking that the preceding records end at the returned position.
+     */
+    static size_t find_record_start(std::string_view const buffer, size_t pos, bool const at_eof) noexcept
+    {
+        if (pos > 0 && pos < buffer.size() && buffer[pos - 1] != '\n') // move to beginning of next line
+            pos = std::min(buffer.find('\n', pos), buffer.size() - 1) + 1;
+
+        std::string_view lines[4];
+        while (pos < buffer.size())
+        {
+            if (buffer[pos] == '@')
+            {
+                size_t const record_end = split_lines(buffer, pos, at_eof, lines);
+                if (record_end == npos)
+                    return buffer.size();
+                if (is_record(lines))
+                    return pos;
+            }
+
+            pos = std::min(buffer.find('\n', pos), buffer.size() - 1) + 1;
+        }
+
+        return buffer.size();
+    }
+
+    /*!\brief Parse the record at the given position.
+     * \param[in] buffer The buffer.
+     * \param[in] pos The position of the record.
+     * \param[in] at_eof Whether the end of the buffer is the end of the input.
+     * \param[in] truncate Whether to truncate the ID at the first whitespace.
+     * \param[out] record A bio::io::seq::record of std::string_view that is set to the fields in the buffer.
+     * \returns The position behind the record or #npos if the record is not completely contained in the buffer.
+     * \throws bio::io::parse_error If the record is malformed or the qualities are not valid Phred+33 characters.
+     */
+    static size_t parse_record_in_buffer(std::string_view const                                          buffer,
+                                         size_t const                                                    pos,
+                                         bool const                                                      at_eof,
+                                         bool const                                                      truncate,
+                                         seq::record<std::string_view, std::string_view, std::string_view> & record)
+    {
+        std::string_view lines[4];
+        size_t const     record_end = split_lines(buffer, pos, at_eof, lines);
+        if (record_end == npos)
+            return npos;
+
+        if (!lines[0].starts_with('@'))
+            throw parse_error{"[BioC++ FastQ format error] ID-line does not begin with '@'."};
+        if (!lines[2].starts_with('+'))
+            throw parse_error{"[BioC++ FastQ format error] Third FastQ record line does not begin with '+'."};
+        if (lines[1].size() != lines[3].size())
+        {
+            throw parse_error{"[BioC++ FastQ format error] Size mismatch between sequence (", lines[1].size(),
+                              ") and qualities (", lines[3].size(), ")."};
+        }
+        if (detail::qual_summary const s = detail::summarise_qualities(lines[3]);
+            !lines[3].empty() && (s.min < '!' || s.max > '~'))
+        {
+            throw parse_error{"[BioC++ FastQ format error] Invalid character in qualities (Phred+33)."};
+        }
+
+        record.id   = id_from_line(lines[0], truncate);
+        record.seq  = lines[1];
+        record.qual = lines[3];
+        return record_end;
+    }
+    //!\}
 };
 
 } // namespace bio::io
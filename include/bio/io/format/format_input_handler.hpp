@@ -13,6 +13,7 @@
 
 #pragma once
 
+#include <iterator>
 #include <span>
 #include <string_view>
 #include <vector>
@@ -21,6 +22,7 @@
 #include <bio/ranges/concept.hpp>
 #include <bio/ranges/views/char_strictly_to.hpp>
 
+#include <bio/io/detail/char_to_alphabet.hpp>
 #include <bio/io/detail/charconv.hpp>
 #include <bio/io/detail/concept.hpp>
 #include <bio/io/detail/range.hpp>
@@ -153,8 +155,16 @@ private:
     static void parse_field_aux(std::string_view const in, parsed_field_t & parsed_field)
     {
         using target_alph_type = std::ranges::range_value_t<parsed_field_t>;
-        //         detail::sized_range_copy(in | bio::views::char_strictly_to<target_alph_type>,
-        detail::sized_range_copy(in | bio::views::char_strictly_to<target_alph_type>, parsed_field);
+        if constexpr (requires { detail::char_strictly_to_bulk(in, parsed_field); }) // e.g. std::vector<dna5>
+            detail::char_strictly_to_bulk(in, parsed_field);
+        else
+            detail::sized_range_copy(in | bio::views::char_strictly_to<target_alph_type>, parsed_field);
+    }
+
+    //!\brief Parse into containers that convert from characters in bulk (e.g. packed sequences).
+    static void parse_field_aux(std::string_view const in, detail::bulk_char_convertible auto & parsed_field)
+    {
+        parsed_field.assign_chars(in);
     }
 
     //!\brief Parse into a numerical type.
@@ -251,12 +261,38 @@ public:
      * \details
      *
      * Convenience function that reads the next raw record and then parses it.
+     *
+     * If the format's `read_raw_record()` is a template, it is passed the type of the parsed record (as a
+     * bio::io::detail::tuple_record). This allows formats to only skip over those fields that are not part of the
+     * parsed record or that are ignored (bio::meta::ignore_t), instead of copying them into the raw record.
      */
     void parse_next_record_into(auto & parsed_record)
     {
-        read_next_raw_record();
+        using tuple_record_t = decltype(derived_t::record2tuple_record(parsed_record));
+
+        if constexpr (requires { to_derived()->template read_raw_record<tuple_record_t>(); })
+            to_derived()->template read_raw_record<tuple_record_t>();
+        else
+            read_next_raw_record();
+
         to_derived()->parse_current_record_into(parsed_record);
     }
+
+    /*!\brief Skip records without parsing them.
+     * \param[in] n The number of records to skip.
+     * \returns The number of records skipped; smaller than `n` only if the end of input was reached.
+     * \details
+     *
+     * The default implementation reads the raw records but does not parse them. Formats may provide faster
+     * implementations that operate on the stream buffer directly.
+     */
+    uint64_t skip_records(uint64_t const n)
+    {
+        uint64_t i = 0;
+        for (; i < n && std::istreambuf_iterator<char>{*stream} != std::istreambuf_iterator<char>{}; ++i)
+            to_derived()->read_raw_record();
+        return i;
+    }
     //!\}
 };
 
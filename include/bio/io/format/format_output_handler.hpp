@@ -13,6 +13,9 @@
 
 #pragma once
 
+#include <array>
+#include <string_view>
+
 #include <bio/alphabet/concept.hpp>
 #include <bio/meta/tag/vtag.hpp>
 #include <bio/ranges/views/to_char.hpp>
@@ -88,6 +91,20 @@ private:
         requires(detail::deliberate_alphabet<std::ranges::range_reference_t<rng_t>>)
     void write_field_aux(rng_t && range) { to_derived()->write_field_aux(range | bio::views::to_char); }
 
+    //!\brief Write alphabet ranges that convert to characters in bulk (e.g. packed sequences).
+    template <std::ranges::input_range rng_t>
+        requires(detail::deliberate_alphabet<std::ranges::range_reference_t<rng_t>> &&
+                 detail::bulk_char_convertible<std::remove_cvref_t<rng_t>>)
+    void write_field_aux(rng_t && range)
+    {
+        std::array<char, 4096> buffer;
+        for (size_t pos = 0; pos < std::ranges::size(range); pos += buffer.size())
+        {
+            size_t const count = range.to_chars(pos, buffer.size(), buffer.data());
+            to_derived()->it->write_range(std::string_view{buffer.data(), count});
+        }
+    }
+
     //!\brief Write CStrings.
     void write_field_aux(char const * const cstr) { write_field_aux(std::string_view{cstr}); }
 
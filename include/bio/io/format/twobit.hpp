@@ -0,0 +1,57 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2022, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2022, Knut Reinert & MPI für molekulare Genetik
+// Copyright (c) 2020-2022, deCODE Genetics
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/bio/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides the bio::io::twobit.
+ * \author Hannes Hauswedell <hannes.hauswedell AT decode.is>
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <bio/io.hpp>
+
+namespace bio::io
+{
+
+/*!\brief       The UCSC 2bit format.
+ * \ingroup     format
+ *
+ * \details
+ *
+ * This is the 2bit format tag. If you want to read 2bit files, use bio::io::seq::reader. Writing 2bit files is
+ * not supported.
+ *
+ * ### Introduction
+ *
+ * 2bit is a binary format for reference genomes that stores four nucleotides per byte. Runs of `N` and
+ * soft-masked (lower-case) regions are stored as separate lists of blocks. The file begins with an index of all
+ * sequences, so subsequences can be retrieved without an additional index file. See the
+ * [UCSC documentation](https://genome.ucsc.edu/FAQ/FAQformat.html#format7) for a description of the format.
+ *
+ * ### Fields
+ *
+ * The 2bit format provides the fields bio::io::detail::field::seq and bio::io::detail::field::id.
+ *
+ * ### Implementation notes
+ *
+ * Sequences are returned as characters, i.e. `A`, `C`, `G`, `T` and `N`; masked regions are returned in lower-case.
+ * Files of both byte-orders and of version 0 and version 1 (64bit offsets) are supported.
+ *
+ * When reading records sequentially, they are returned in the order in which they are stored in the file (which is
+ * the order of the index for files created by the UCSC tools).
+ */
+struct twobit
+{
+    //!\brief The valid file extensions for this format; note that you can modify this value.
+    static inline std::vector<std::string> file_extensions{"2bit"};
+};
+
+} // namespace bio::io
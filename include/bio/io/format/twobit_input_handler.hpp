@@ -0,0 +1,476 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2022, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2022, Knut Reinert & MPI für molekulare Genetik
+// Copyright (c) 2020-2022, deCODE Genetics
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/bio/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides the bio::io::format_input_handler<bio::io::twobit>.
+ * \author Hannes Hauswedell <hannes.hauswedell AT decode.is>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <bio/meta/tag/vtag.hpp>
+
+#include <bio/io/exception.hpp>
+#include <bio/io/format/format_input_handler.hpp>
+#include <bio/io/format/twobit.hpp>
+#include <bio/io/genomic_region.hpp>
+#include <bio/io/seq/record.hpp>
+#include <bio/io/stream/detail/fast_streambuf_iterator.hpp>
+
+namespace bio::io
+{
+
+/*!\brief Format input handler for the UCSC 2bit format (bio::io::twobit).
+ * \ingroup format
+ * \details
+ *
+ * ### Attention
+ *
+ * Most users should not perform I/O through input/output handlers but should instead use the respective
+ * readers/writers. See the overview (TODO link) for more information.
+ *
+ * ### Options
+ *
+ * This handler currently does not consider any options.
+ *
+ * ### Performance
+ *
+ * The header and the index of the file are read on construction. Every byte of packed sequence is converted to four
+ * characters with a single table lookup; `N`-blocks and mask-blocks are applied to the unpacked sequence afterwards.
+ *
+ * If the sequence is requested as std::string, the record's element is swapped with the internal buffer to
+ * prevent a second copy. Requesting views never implies a second copy.
+ *
+ * Subsequences can be read via fetch() which reads only the bytes that contain the requested region; the block
+ * lists of a sequence are read once and cached.
+ */
+template <>
+class format_input_handler<twobit> :
+  public format_input_handler_base<format_input_handler<twobit>>,
+  public seq::format_handler_mixin
+{
+private:
+    /*!\name CRTP related entities
+     * \{
+     */
+    //!\brief The type of the CRTP base class.
+    using base_t = format_input_handler_base<format_input_handler<twobit>>;
+    using base_t::parse_field;
+    using base_t::parse_field_aux;
+    using base_t::stream;
+
+    //!\brief Befriend the base class to enable CRTP.
+    friend base_t;
+    //!\}
+
+    //!\brief Throw a parse_error with the given message.
+    [[noreturn]] static void error(auto const &... messages)
+    {
+        throw parse_error{"[BioC++ 2bit format error] ", messages...};
+    }
+
+    /*!\name File layout
+     * \{
+     */
+    //!\brief The signature at the beginning of every 2bit file.
+    static constexpr uint32_t signature = 0x1A412743;
+
+    //!\brief A block of `N`s or of masked bases; 0-based start and length.
+    struct block
+    {
+        uint32_t start = 0; //!< Start position.
+        uint32_t size  = 0; //!< Length.
+    };
+
+    //!\brief The header of a sequence that precedes the packed bases.
+    struct sequence_header
+    {
+        //!\brief Number of bases.
+        uint32_t           length = 0;
+        //!\brief Runs of `N`.
+        std::vector<block> n_blocks;
+        //!\brief Soft-masked regions.
+        std::vector<block> mask_blocks;
+        //!\brief Offset of the packed bases in the file.
+        uint64_t           packed_offset = 0;
+    };
+
+    //!\brief An entry of the index.
+    struct index_entry
+    {
+        //!\brief Name of the sequence.
+        std::string                    name;
+        //!\brief Offset of the sequence header in the file.
+        uint64_t                       offset = 0;
+        //!\brief The sequence header; only read by fetch().
+        std::optional<sequence_header> header;
+    };
+
+    //!\brief The characters encoded by a byte of packed sequence (most significant bits first).
+    static constexpr std::array<std::array<char, 4>, 256> byte_to_chars = []()
+    {
+        constexpr std::array<char, 4>          code_to_char{'T', 'C', 'A', 'G'};
+        std::array<std::array<char, 4>, 256> ret{};
+        for (size_t i = 0; i < 256; ++i)
+            for (size_t j = 0; j < 4; ++j)
+                ret[i][j] = code_to_char[(i >> (6 - 2 * j)) & 0b11];
+        return ret;
+    }();
+    //!\}
+
+    /*!\name Raw record handling
+     * \{
+     */
+    //!\brief The fields that this format supports [the base class accesses this type].
+    using format_fields = meta::vtag_t<detail::field::id, detail::field::seq>;
+    //!\brief Type of the raw record.
+    using raw_record_type =
+      io::detail::tuple_record<format_fields, meta::type_list<std::string_view, std::string_view>>;
+
+    //!\brief The raw record.
+    raw_record_type raw_record;
+    //!\brief Buffer for the sequence.
+    std::string     seq_buffer;
+    //!\brief Buffer for the packed sequence.
+    std::string     packed_buffer;
+    //!\brief Buffer for the header of the current sequence.
+    sequence_header header_buffer;
+
+    //!\brief The index.
+    std::vector<index_entry>                entries;
+    //!\brief Maps names to positions in #entries.
+    std::unordered_map<std::string, size_t> name_to_entry;
+    //!\brief Positions in #entries, sorted by offset in the file.
+    std::vector<size_t>                     file_order;
+    //!\brief The number of records read sequentially.
+    size_t                                  n_read   = 0;
+    //!\brief The current position in the file (when reading sequentially).
+    uint64_t                                position = 0;
+    //!\brief Whether the file's byte-order is different from the host's.
+    bool                                    swap     = false;
+
+    //!\brief Reverse the byte-order of a number.
+    template <std::unsigned_integral int_t>
+    static constexpr int_t byteswap(int_t const in) noexcept
+    {
+        int_t ret = 0;
+        for (size_t i = 0; i < sizeof(int_t); ++i)
+            ret |= static_cast<int_t>((in >> (8 * i)) & 0xFF) << (8 * (sizeof(int_t) - 1 - i));
+        return ret;
+    }
+
+    //!\brief Read a number in the file's byte-order.
+    template <std::unsigned_integral int_t>
+    int_t read_number(io::detail::fast_istreambuf_iterator<char> & it)
+    {
+        int_t ret = 0;
+        it.read_as_binary(ret);
+        return swap ? byteswap(ret) : ret;
+    }
+
+    //!\brief Read the file header and the index.
+    void read_index()
+    {
+        io::detail::fast_istreambuf_iterator<char> it{*stream};
+
+        uint32_t const sig = read_number<uint32_t>(it);
+        if (sig == byteswap(signature))
+            swap = true;
+        else if (sig != signature)
+            error("The file does not begin with the 2bit signature.");
+
+        uint32_t const version = read_number<uint32_t>(it);
+        if (version > 1)
+            error("Unsupported version ", version, ".");
+
+        uint32_t const n_seqs = read_number<uint32_t>(it);
+        read_number<uint32_t>(it); // reserved
+        position = 16;
+
+        entries.resize(n_seqs);
+        name_to_entry.reserve(n_seqs);
+        for (size_t i = 0; i < n_seqs; ++i)
+        {
+            index_entry & entry = entries[i];
+
+            uint8_t name_size = 0;
+            it.read_as_binary(name_size);
+            entry.name.resize(name_size);
+            it.read_n_chars_into(name_size, entry.name.data());
+            entry.offset = version == 0 ? read_number<uint32_t>(it) : read_number<uint64_t>(it);
+            position += 1 + name_size + (version == 0 ? 4 : 8);
+
+            if (!name_to_entry.emplace(entry.name, i).second)
+                error("The sequence name \"", entry.name, "\" occurs more than once.");
+        }
+
+        file_order.resize(n_seqs);
+        std::iota(file_order.begin(), file_order.end(), 0);
+        std::ranges::stable_sort(file_order, {}, [&](size_t const i) { return entries[i].offset; });
+
+        if (n_seqs == 0) // consume trailing data so that the reader detects the end
+            stream->ignore(std::numeric_limits<std::streamsize>::max());
+    }
+
+    //!\brief Read a list of blocks.
+    void read_blocks(io::detail::fast_istreambuf_iterator<char> & it, std::vector<block> & blocks)
+    {
+        blocks.resize(read_number<uint32_t>(it));
+        for (block & b : blocks)
+            b.start = read_number<uint32_t>(it);
+        for (block & b : blocks)
+            b.size = read_number<uint32_t>(it);
+    }
+
+    //!\brief Read the sequence header at the current position (which is given as `offset`).
+    void read_sequence_header(io::detail::fast_istreambuf_iterator<char> & it,
+                              uint64_t const                               offset,
+                              sequence_header &                            header)
+    {
+        header.length = read_number<uint32_t>(it);
+        read_blocks(it, header.n_blocks);
+        read_blocks(it, header.mask_blocks);
+        read_number<uint32_t>(it); // reserved
+
+        header.packed_offset = offset + 16 + 8 * (header.n_blocks.size() + header.mask_blocks.size());
+
+        auto invalid = [&](block const & b) { return uint64_t{b.start} + b.size > header.length; };
+        if (std::ranges::any_of(header.n_blocks, invalid) || std::ranges::any_of(header.mask_blocks, invalid))
+            error("A block exceeds the length of the sequence.");
+    }
+
+    /*!\brief Unpack `n` bases, beginning with the base at position `skip` of the first byte.
+     * \details
+     *
+     * Whole bytes are unpacked by copying four characters from a table, so there are no branches per base.
+     */
+    static void unpack(char const * packed, size_t skip, size_t n, char * out) noexcept
+    {
+        if (skip > 0 && n > 0)
+        {
+            size_t const count = std::min(n, 4 - skip);
+            std::memcpy(out, byte_to_chars[static_cast<uint8_t>(*packed)].data() + skip, count);
+            ++packed;
+            out += count;
+            n -= count;
+        }
+
+        size_t const n_bytes = n / 4;
+        for (size_t i = 0; i < n_bytes; ++i)
+            std::memcpy(out + 4 * i, byte_to_chars[static_cast<uint8_t>(packed[i])].data(), 4);
+
+        if (n % 4 > 0)
+            std::memcpy(out + 4 * n_bytes, byte_to_chars[static_cast<uint8_t>(packed[n_bytes])].data(), n % 4);
+    }
+
+    /*!\brief Apply `N`-blocks and mask-blocks to the unpacked bases of the region `[beg, beg + seq.size())`.
+     * \details
+     *
+     * Blocks are sorted and do not overlap, so the first relevant block is found via binary search.
+     */
+    static void apply_blocks(sequence_header const & header, uint64_t const beg, std::string & seq)
+    {
+        uint64_t const end = beg + seq.size();
+
+        auto for_each_overlap = [&](std::vector<block> const & blocks, auto && fn)
+        {
+            auto b = std::ranges::partition_point(blocks,
+                                                  [&](block const & bl) { return uint64_t{bl.start} + bl.size <= beg; });
+            for (; b != blocks.end() && b->start < end; ++b)
+            {
+                uint64_t const b_beg = std::max<uint64_t>(b->start, beg);
+                uint64_t const b_end = std::min<uint64_t>(uint64_t{b->start} + b->size, end);
+                fn(seq.data() + (b_beg - beg), seq.data() + (b_end - beg));
+            }
+        };
+
+        for_each_overlap(header.n_blocks, [](char * b, char * e) { std::fill(b, e, 'N'); });
+        for_each_overlap(header.mask_blocks,
+                         [](char * b, char * e)
+                         {
+                             for (; b != e; ++b)
+                                 *b |= 0x20; // to lower-case
+                         });
+    }
+
+    //!\brief Read the raw record [the base class invokes this function].
+    void read_raw_record()
+    {
+        if (n_read == entries.size())
+            error("Tried to read more sequences than listed in the index.");
+
+        index_entry const & entry = entries[file_order[n_read]];
+
+        if (entry.offset < position)
+            error("The sequence \"", entry.name, "\" overlaps with the previous sequence or the index.");
+
+        io::detail::fast_istreambuf_iterator<char> it{*stream};
+        it.skip_n(entry.offset - position);
+
+        read_sequence_header(it, entry.offset, header_buffer);
+
+        size_t const n_bytes = (header_buffer.length + 3) / 4;
+        packed_buffer.resize(n_bytes);
+        it.read_n_chars_into(n_bytes, packed_buffer.data());
+        position = header_buffer.packed_offset + n_bytes;
+
+        seq_buffer.resize(header_buffer.length);
+        unpack(packed_buffer.data(), 0, header_buffer.length, seq_buffer.data());
+        apply_blocks(header_buffer, 0, seq_buffer);
+
+        get<detail::field::id>(raw_record)  = entry.name;
+        get<detail::field::seq>(raw_record) = seq_buffer;
+
+        if (++n_read == entries.size()) // consume trailing data so that the reader detects the end
+            stream->ignore(std::numeric_limits<std::streamsize>::max());
+    }
+    //!\}
+
+    /*!\name Parsed record handling
+     * \brief This is mostly done via the defaults in the base class.
+     * \{
+     */
+    //!\brief We can prevent another copy if the user wants a string.
+    void parse_field(meta::vtag_t<detail::field::seq> const & /**/, std::string & parsed_field)
+    {
+        std::swap(seq_buffer, parsed_field);
+    }
+    //!\}
+
+public:
+    /*!\name Constructors, destructor and assignment.
+     * \{
+     */
+    format_input_handler()                                         = default; //!< Defaulted.
+    format_input_handler(format_input_handler const &)             = delete;  //!< Deleted.
+    format_input_handler(format_input_handler &&)                  = default; //!< Defaulted.
+    ~format_input_handler()                                        = default; //!< Defaulted.
+    format_input_handler & operator=(format_input_handler const &) = delete;  //!< Deleted.
+    format_input_handler & operator=(format_input_handler &&)      = default; //!< Defaulted.
+
+    /*!\brief Construct with an options object.
+     * \param[in,out] str The input stream; must be at the beginning of the file.
+     * \param[in] options An object with options for the input handler.
+     * \throws bio::io::parse_error If the header or the index are invalid.
+     * \details
+     *
+     * The options argument is typically bio::io::seq::reader_options, but any object with a subset of similarly
+     * named members is also accepted. See bio::io::format_input_handler<bio::io::twobit> for the supported options
+     * and defaults.
+     */
+    format_input_handler(std::istream & str, auto const & /*options*/) : base_t{str} { read_index(); }
+
+    //!\brief Construct with only an input stream.
+    format_input_handler(std::istream & str) : format_input_handler{str, int{}} {}
+    //!\}
+
+    /*!\brief Skip records without parsing them.
+     * \param[in] n The number of records to skip.
+     * \returns The number of records skipped; smaller than `n` only if the end of input was reached.
+     * \details
+     *
+     * Only the header of every sequence is read; the packed bases are skipped.
+     */
+    uint64_t skip_records(uint64_t const n)
+    {
+        uint64_t i = 0;
+        for (; i < n && n_read < entries.size(); ++i)
+        {
+            index_entry const & entry = entries[file_order[n_read]];
+            if (entry.offset < position)
+                error("The sequence \"", entry.name, "\" overlaps with the previous sequence or the index.");
+
+            io::detail::fast_istreambuf_iterator<char> it{*stream};
+            it.skip_n(entry.offset - position);
+            read_sequence_header(it, entry.offset, header_buffer);
+
+            size_t const n_bytes = (header_buffer.length + 3) / 4;
+            it.skip_n(n_bytes);
+            position = header_buffer.packed_offset + n_bytes;
+
+            if (++n_read == entries.size())
+                stream->ignore(std::numeric_limits<std::streamsize>::max());
+        }
+        return i;
+    }
+
+    //!\brief The names of the sequences in the order of the index.
+    std::vector<std::string_view> sequence_names() const
+    {
+        std::vector<std::string_view> ret;
+        ret.reserve(entries.size());
+        for (index_entry const & entry : entries)
+            ret.push_back(entry.name);
+        return ret;
+    }
+
+    /*!\brief Read the bases of a region.
+     * \param[in] region The region; positions are 0-based and half-open, they are clamped to the sequence length.
+     * \param[out] out The characters are stored here.
+     * \param[in] seek A callable that moves the stream to the given offset in the (uncompressed) file.
+     * \throws bio::io::bio_error If the sequence is not contained in the index.
+     * \details
+     *
+     * Only the bytes that contain the region are read. After calling this function, records can no longer be read
+     * sequentially.
+     */
+    void fetch(genomic_region const & region, std::string & out, auto && seek)
+    {
+        auto e_it = name_to_entry.find(region.chrom);
+        if (e_it == name_to_entry.end())
+            throw bio_error{"The sequence \"", region.chrom, "\" is not contained in the 2bit index."};
+
+        index_entry & entry = entries[e_it->second];
+
+        // the stream position is changed
+        n_read   = entries.size();
+        position = std::numeric_limits<uint64_t>::max();
+
+        if (!entry.header.has_value())
+        {
+            seek(entry.offset);
+            io::detail::fast_istreambuf_iterator<char> it{*stream};
+            sequence_header header;
+            read_sequence_header(it, entry.offset, header);
+            entry.header = std::move(header);
+        }
+
+        sequence_header const & header = *entry.header;
+        uint64_t const          beg    = std::clamp<int64_t>(region.beg, 0, header.length);
+        uint64_t const          end    = std::clamp<int64_t>(region.end, beg, header.length);
+
+        out.resize(end - beg);
+        if (end == beg)
+            return;
+
+        size_t const n_bytes = (end - 1) / 4 - beg / 4 + 1;
+        seek(header.packed_offset + beg / 4);
+        io::detail::fast_istreambuf_iterator<char> it{*stream};
+        packed_buffer.resize(n_bytes);
+        it.read_n_chars_into(n_bytes, packed_buffer.data());
+
+        unpack(packed_buffer.data(), beg % 4, end - beg, out.data());
+        apply_blocks(header, beg, out);
+    }
+};
+
+} // namespace bio::io
@@ -0,0 +1,57 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2022, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2022, Knut Reinert & MPI für molekulare Genetik
+// Copyright (c) 2020-2022, deCODE Genetics
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/bio/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides the bio::io::ubam.
+ * \author Hannes Hauswedell <hannes.hauswedell AT decode.is>
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <bio/io.hpp>
+
+namespace bio::io
+{
+
+/*!\brief       The BAM format, read as (unaligned) sequence data.
+ * \ingroup     format
+ *
+ * \details
+ *
+ * This is the uBAM format tag. If you want to read the reads stored in (unaligned) BAM files, use
+ * bio::io::seq::reader. Writing BAM files is not supported.
+ *
+ * ### Introduction
+ *
+ * BAM is the binary, BGZF-compressed representation of SAM. Sequencing centres increasingly store raw reads as
+ * *unaligned BAM* (uBAM) instead of FastQ, because it is smaller and can carry additional per-read tags. See the
+ * [SAM specification](https://samtools.github.io/hts-specs/SAMv1.pdf) for a description of the format.
+ *
+ * ### Fields
+ *
+ * The uBAM format provides the fields bio::io::detail::field::id, bio::io::detail::field::seq and
+ * bio::io::detail::field::qual. All other information (flags, alignment, tags) is discarded.
+ *
+ * ### Implementation notes
+ *
+ * Like `samtools fastq`, the handler skips secondary and supplementary alignments, and it reverse-complements the
+ * sequence (and reverses the qualities) of records that are flagged as aligned to the reverse strand. Thus, every read
+ * is returned once and in its original orientation, also when reading aligned BAM files.
+ *
+ * Qualities are returned as Phred+33 characters; they are empty if the record does not store qualities.
+ */
+struct ubam
+{
+    //!\brief The valid file extensions for this format; note that you can modify this value.
+    static inline std::vector<std::string> file_extensions{"bam", "ubam"};
+};
+
+} // namespace bio::io
@@ -0,0 +1,418 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2022, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2022, Knut Reinert & MPI für molekulare Genetik
+// Copyright (c) 2020-2022, deCODE Genetics
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/bio/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides the bio::io::format_input_handler<bio::io::ubam>.
+ * \author Hannes Hauswedell <hannes.hauswedell AT decode.is>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <string>
+#include <string_view>
+
+#include <bio/meta/tag/vtag.hpp>
+
+#include <bio/io/detail/to_little_endian.hpp>
+#include <bio/io/exception.hpp>
+#include <bio/io/format/format_input_handler.hpp>
+#include <bio/io/format/ubam.hpp>
+#include <bio/io/seq/record.hpp>
+#include <bio/io/stream/detail/fast_streambuf_iterator.hpp>
+
+namespace bio::io
+{
+
+/*!\brief Format input handler for unaligned BAM files (bio::io::ubam).
+ * \ingroup format
+ * \details
+ *
+ * ### Attention
+ *
+ * Most users should not perform I/O through input/output handlers but should instead use the respective
+ * readers/writers. See the overview (TODO link) for more information.
+ *
+ * ### Options
+ *
+ * This handler currently does not consider any options.
+ *
+ * ### Performance
+ *
+ * The BGZF decompression is performed by bio::io::transparent_istream, i.e. on multiple threads if so requested.
+ * Of every record, only the read name, the packed sequence and the qualities are copied out of the stream buffer;
+ * the CIGAR string and the tags are skipped. Fields that are bio::meta::ignore'd in the record are skipped, too.
+ *
+ * Every byte of packed sequence is converted to two characters with a single table lookup, i.e. there are no
+ * branches per base.
+ *
+ * If the sequence or the qualities are requested as std::string, the record's element is swapped with the internal
+ * buffer to prevent a second copy. Requesting views never implies a second copy.
+ */
+template <>
+class format_input_handler<ubam> :
+  public format_input_handler_base<format_input_handler<ubam>>,
+  public seq::format_handler_mixin
+{
+private:
+    /*!\name CRTP related entities
+     * \{
+     */
+    //!\brief The type of the CRTP base class.
+    using base_t = format_input_handler_base<format_input_handler<ubam>>;
+    using base_t::parse_field;
+    using base_t::parse_field_aux;
+    using base_t::stream;
+
+    //!\brief Befriend the base class to enable CRTP.
+    friend base_t;
+    //!\}
+
+    //!\brief Throw a parse_error with the given message.
+    [[noreturn]] static void error(auto const &... messages)
+    {
+        throw parse_error{"[BioC++ BAM format error] ", messages...};
+    }
+
+    /*!\name File layout
+     * \{
+     */
+    //!\brief Size of block_size and of the fixed-size fields at the beginning of every record.
+    static constexpr size_t fixed_size = 36;
+
+    //!\brief Flags of secondary (0x100) and supplementary (0x800) alignments; these records are skipped.
+    static constexpr uint16_t skip_flags = 0x900;
+
+    //!\brief Flag of records whose sequence is stored reverse-complemented.
+    static constexpr uint16_t reverse_flag = 0x10;
+
+    //!\brief The fixed-size fields of a record that are relevant here.
+    struct record_header
+    {
+        uint32_t block_size  = 0; //!< Size of the record (without block_size itself).
+        uint8_t  l_read_name = 0; //!< Length of the read name including the terminating `\0`.
+        uint16_t n_cigar_op  = 0; //!< Number of CIGAR operations.
+        uint16_t flag        = 0; //!< Bitwise flags.
+        uint32_t l_seq       = 0; //!< Length of the sequence.
+    };
+
+    //!\brief The characters of the 4-bit codes.
+    static constexpr std::string_view code_to_char = "=ACMGRSVTWYHKDBN";
+
+    //!\brief The characters encoded by a byte of packed sequence (high nibble first).
+    static constexpr std::array<std::array<char, 2>, 256> byte_to_chars = []()
+    {
+        std::array<std::array<char, 2>, 256> ret{};
+        for (size_t i = 0; i < 256; ++i)
+            ret[i] = {code_to_char[i >> 4], code_to_char[i & 0xF]};
+        return ret;
+    }();
+
+    //!\brief The complement of every character in #code_to_char; the 4-bit codes are complemented by reversing bits.
+    static constexpr std::array<char, 256> complement_char = []()
+    {
+        std::array<char, 256> ret{};
+        for (size_t i = 0; i < 16; ++i)
+        {
+            size_t const rev = ((i & 1) << 3) | ((i & 2) << 1) | ((i & 4) >> 1) | ((i & 8) >> 3);
+            ret[static_cast<uint8_t>(code_to_char[i])] = code_to_char[rev];
+        }
+        return ret;
+    }();
+    //!\}
+
+    /*!\name Raw record handling
+     * \{
+     */
+    //!\brief The fields that this format supports [the base class accesses this type].
+    using format_fields = meta::vtag_t<detail::field::id, detail::field::seq, detail::field::qual>;
+    //!\brief Type of the raw record.
+    using raw_record_type =
+      io::detail::tuple_record<format_fields,
+                               meta::type_list<std::string_view, std::string_view, std::string_view>>;
+
+    //!\brief The raw record.
+    raw_record_type raw_record;
+    //!\brief Buffer for the read name.
+    std::string     id_buffer;
+    //!\brief Buffer for the sequence.
+    std::string     seq_buffer;
+    //!\brief Buffer for the qualities.
+    std::string     qual_buffer;
+    //!\brief Buffer for the packed sequence.
+    std::string     packed_buffer;
+
+    //!\brief The header of the next record that is not skipped; see #has_next.
+    record_header next;
+    //!\brief Whether #next was read; false at the end of the file.
+    bool          has_next = false;
+
+    //!\brief Read a little-endian number.
+    template <std::integral int_t>
+    static int_t read_number(io::detail::fast_istreambuf_iterator<char> & it)
+    {
+        int_t ret = 0;
+        it.read_as_binary(ret);
+        return io::detail::to_little_endian(ret);
+    }
+
+    //!\brief Interpret the bytes at `ptr` as a little-endian number.
+    template <std::integral int_t>
+    static int_t load_number(char const * const ptr) noexcept
+    {
+        int_t ret = 0;
+        std::memcpy(&ret, ptr, sizeof(int_t));
+        return io::detail::to_little_endian(ret);
+    }
+
+    //!\brief Read the file header; the text and the reference sequences are skipped.
+    void read_header()
+    {
+        io::detail::fast_istreambuf_iterator<char> it{*stream};
+
+        std::array<char, 4> magic{};
+        it.read_n_chars_into(magic.size(), magic.data());
+        if (std::string_view{magic.data(), magic.size()} != std::string_view{"BAM\1", 4})
+            error("The file does not begin with the BAM magic string.");
+
+        int32_t const l_text = read_number<int32_t>(it);
+        if (l_text < 0)
+            error("The length of the header text is negative.");
+        it.skip_n(l_text);
+
+        int32_t const n_ref = read_number<int32_t>(it);
+        if (n_ref < 0)
+            error("The number of reference sequences is negative.");
+        for (int32_t i = 0; i < n_ref; ++i)
+        {
+            int32_t const l_name = read_number<int32_t>(it);
+            if (l_name < 0)
+                error("The length of a reference name is negative.");
+            it.skip_n(l_name + 4); // name and l_ref
+        }
+    }
+
+    /*!\brief Read the header of the next record that is not skipped into #next.
+     * \details
+     *
+     * Reading ahead guarantees that the stream is at its end after the last record that is returned, so the reader
+     * detects the end of the file also if the last records are secondary or supplementary alignments.
+     */
+    void read_next_header()
+    {
+        has_next = false;
+        while (std::istreambuf_iterator<char>{*stream} != std::istreambuf_iterator<char>{})
+        {
+            io::detail::fast_istreambuf_iterator<char> it{*stream};
+            std::array<char, fixed_size>               buf{};
+            it.read_n_chars_into(fixed_size, buf.data());
+
+            next.block_size  = load_number<uint32_t>(buf.data());
+            next.l_read_name = static_cast<uint8_t>(buf[12]);
+            next.n_cigar_op  = load_number<uint16_t>(buf.data() + 16);
+            next.flag        = load_number<uint16_t>(buf.data() + 18);
+            next.l_seq       = load_number<uint32_t>(buf.data() + 20);
+
+            uint64_t const min_size = uint64_t{fixed_size - 4} + next.l_read_name + 4ull * next.n_cigar_op +
+                                      (uint64_t{next.l_seq} + 1) / 2 + next.l_seq;
+            if (next.block_size < min_size)
+                error("The record size (", next.block_size, ") is smaller than the size of its fields (", min_size,
+                      ").");
+            if (next.l_read_name == 0)
+                error("The read name is not terminated by '\\0'.");
+
+            if ((next.flag & skip_flags) == 0)
+            {
+                has_next = true;
+                return;
+            }
+
+            it.skip_n(next.block_size - (fixed_size - 4));
+        }
+    }
+
+    /*!\brief Unpack `n` bases from the packed sequence.
+     * \details
+     *
+     * Whole bytes are unpacked by copying two characters from a table, so there are no branches per base.
+     */
+    static void unpack(char const * packed, size_t const n, char * out) noexcept
+    {
+        size_t const n_bytes = n / 2;
+        for (size_t i = 0; i < n_bytes; ++i)
+            std::memcpy(out + 2 * i, byte_to_chars[static_cast<uint8_t>(packed[i])].data(), 2);
+
+        if (n % 2 > 0)
+            out[n - 1] = byte_to_chars[static_cast<uint8_t>(packed[n_bytes])][0];
+    }
+
+    /*!\brief Read the raw record [the base class invokes this function].
+     * \tparam parsed_record_t The type of the record that is parsed; fields that it ignores are skipped.
+     */
+    template <typename parsed_record_t = raw_record_type>
+    void read_raw_record()
+    {
+        constexpr bool read_id   = detail::has_non_ignore_field<detail::field::id, parsed_record_t>();
+        constexpr bool read_seq  = detail::has_non_ignore_field<detail::field::seq, parsed_record_t>();
+        constexpr bool read_qual = detail::has_non_ignore_field<detail::field::qual, parsed_record_t>();
+
+        if (!has_next)
+            error("Tried to read a record, but only secondary or supplementary alignments were left.");
+
+        io::detail::fast_istreambuf_iterator<char> it{*stream};
+        size_t const                               l_seq  = next.l_seq;
+        bool const                                 is_rev = next.flag & reverse_flag;
+
+        /* read name */
+        if constexpr (read_id)
+        {
+            id_buffer.resize(next.l_read_name);
+            it.read_n_chars_into(next.l_read_name, id_buffer.data());
+            if (id_buffer.back() != '\0')
+                error("The read name is not terminated by '\\0'.");
+            id_buffer.pop_back();
+        }
+        else
+        {
+            it.skip_n(next.l_read_name);
+        }
+
+        /* cigar */
+        it.skip_n(4ull * next.n_cigar_op);
+
+        /* seq */
+        if constexpr (read_seq)
+        {
+            packed_buffer.resize((l_seq + 1) / 2);
+            it.read_n_chars_into(packed_buffer.size(), packed_buffer.data());
+            seq_buffer.resize(l_seq);
+            unpack(packed_buffer.data(), l_seq, seq_buffer.data());
+            if (is_rev)
+            {
+                std::ranges::reverse(seq_buffer);
+                for (char & c : seq_buffer)
+                    c = complement_char[static_cast<uint8_t>(c)];
+            }
+        }
+        else
+        {
+            it.skip_n((l_seq + 1) / 2);
+        }
+
+        /* qual */
+        if constexpr (read_qual)
+        {
+            qual_buffer.resize(l_seq);
+            it.read_n_chars_into(l_seq, qual_buffer.data());
+            if (l_seq > 0 && static_cast<uint8_t>(qual_buffer[0]) == 0xFF) // qualities are absent
+            {
+                qual_buffer.clear();
+            }
+            else
+            {
+                for (char & c : qual_buffer)
+                {
+                    if (static_cast<uint8_t>(c) > '~' - '!')
+                        error("The quality ", static_cast<int>(static_cast<uint8_t>(c)), " is out of range.");
+                    c += '!';
+                }
+                if (is_rev)
+                    std::ranges::reverse(qual_buffer);
+            }
+        }
+        else
+        {
+            it.skip_n(l_seq);
+        }
+
+        /* tags */
+        it.skip_n(next.block_size - (fixed_size - 4) - next.l_read_name - 4ull * next.n_cigar_op - (l_seq + 1) / 2 -
+                  l_seq);
+
+        get<detail::field::id>(raw_record)   = id_buffer;
+        get<detail::field::seq>(raw_record)  = seq_buffer;
+        get<detail::field::qual>(raw_record) = qual_buffer;
+
+        read_next_header();
+    }
+    //!\}
+
+    /*!\name Parsed record handling
+     * \brief This is mostly done via the defaults in the base class.
+     * \{
+     */
+    //!\brief We can prevent another copy if the user wants a string.
+    void parse_field(meta::vtag_t<detail::field::seq> const & /**/, std::string & parsed_field)
+    {
+        std::swap(seq_buffer, parsed_field);
+    }
+
+    //!\brief We can prevent another copy if the user wants a string.
+    void parse_field(meta::vtag_t<detail::field::qual> const & /**/, std::string & parsed_field)
+    {
+        std::swap(qual_buffer, parsed_field);
+    }
+    //!\}
+
+public:
+    /*!\name Constructors, destructor and assignment.
+     * \{
+     */
+    format_input_handler()                                         = default; //!< Defaulted.
+    format_input_handler(format_input_handler const &)             = delete;  //!< Deleted.
+    format_input_handler(format_input_handler &&)                  = default; //!< Defaulted.
+    ~format_input_handler()                                        = default; //!< Defaulted.
+    format_input_handler & operator=(format_input_handler const &) = delete;  //!< Deleted.
+    format_input_handler & operator=(format_input_handler &&)      = default; //!< Defaulted.
+
+    /*!\brief Construct with an options object.
+     * \param[in,out] str The input stream; must be at the beginning of the (decompressed) file.
+     * \param[in] options An object with options for the input handler.
+     * \throws bio::io::parse_error If the header is invalid.
+     * \details
+     *
+     * The options argument is typically bio::io::seq::reader_options, but any object with a subset of similarly
+     * named members is also accepted. See bio::io::format_input_handler<bio::io::ubam> for the supported options
+     * and defaults.
+     */
+    format_input_handler(std::istream & str, auto const & /*options*/) : base_t{str}
+    {
+        read_header();
+        read_next_header();
+    }
+
+    //!\brief Construct with only an input stream.
+    format_input_handler(std::istream & str) : format_input_handler{str, int{}} {}
+    //!\}
+
+    /*!\brief Skip records without parsing them.
+     * \param[in] n The number of records to skip.
+     * \returns The number of records skipped; smaller than `n` only if the end of input was reached.
+     * \details
+     *
+     * Secondary and supplementary alignments are not counted.
+     */
+    uint64_t skip_records(uint64_t const n)
+    {
+        uint64_t i = 0;
+        for (; i < n && has_next; ++i)
+        {
+            io::detail::fast_istreambuf_iterator<char> it{*stream};
+            it.skip_n(next.block_size - (fixed_size - 4));
+            read_next_header();
+        }
+        return i;
+    }
+};
+
+} // namespace bio::io
@@ -511,6 +511,20 @@ public:
 
     //!\brief This resets the stream iterator after region-seek.
     void reset_stream() { file_it = lowlevel_iterator{*stream, false}; }
+
+    /*!\brief Skip records without reading their content.
+     * \param[in] n The number of records to skip.
+     * \returns The number of records skipped; smaller than `n` only if the end of input was reached.
+     * \details
+     *
+     * Every line is one record, so this only counts newline characters in the stream buffer.
+     */
+    uint64_t skip_records(uint64_t const n)
+    {
+        uint64_t const skipped = file_it.skip_lines(n);
+        line += skipped;
+        return skipped;
+    }
 };
 
 // ----------------------------------------------------------------------------
@@ -674,10 +688,17 @@ struct format_input_handler<vcf>::parse_element_value_type_fn
     {
         if (input != missing)
         {
-            for (std::string_view const s : input | detail::eager_split(','))
+            if constexpr (meta::arithmetic<elem_t> && !std::same_as<elem_t, bool> && !std::same_as<elem_t, char>)
             {
-                vec.emplace_back();
-                parse_element_value_type_fn{s}(vec.back());
+                detail::string_to_numbers(input, ',', vec, missing, var::missing_value<elem_t>);
+            }
+            else
+            {
+                for (std::string_view const s : input | detail::eager_split(','))
+                {
+                    vec.emplace_back();
+                    parse_element_value_type_fn{s}(vec.back());
+                }
             }
         }
 
@@ -0,0 +1,274 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2022, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2022, Knut Reinert & MPI für molekulare Genetik
+// Copyright (c) 2020-2022, deCODE Genetics
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/bio/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides bio::io::seq::fai_index.
+ * \author Hannes Hauswedell <hannes.hauswedell AT decode.is>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <bio/io/detail/charconv.hpp>
+#include <bio/io/exception.hpp>
+#include <bio/io/stream/detail/fast_streambuf_iterator.hpp>
+#include <bio/io/stream/transparent_istream.hpp>
+
+namespace bio::io::seq
+{
+
+/*!\brief An index of the sequences in a FastA file (the ".fai" format of samtools).
+ * \ingroup seq
+ * \details
+ *
+ * For every sequence in the file, the index stores the name (the ID up until the first whitespace), the length of
+ * the sequence, the offset of the first base in the file, the number of bases per line and the number of bytes per
+ * line (including the line-ending). This allows computing the position of every base in the file directly, as long
+ * as all lines of a sequence (except the last) have the same length.
+ *
+ * For BGZF compressed files, the offsets refer to the **uncompressed** data; a GZI index is needed to translate
+ * them into on-disk positions (see bio::io::seq::reader::fetch()).
+ *
+ * The index can be created in one of the following ways:
+ *
+ *   1. By reading the file: bio::io::seq::fai_index::build().
+ *   2. While writing the file: see the `fai_file` member of bio::io::seq::writer_options.
+ *   3. By reading an existing index created by this library or `samtools faidx`: bio::io::seq::fai_index::read().
+ *
+ * ### File format
+ *
+ * One line per sequence with five tab-separated columns:
+ *
+ * ```
+ * NAME    LENGTH    OFFSET    LINEBASES    LINEWIDTH
+ * ```
+ *
+ * Indexes of FastQ files (with a sixth column) are not supported.
+ */
+class fai_index
+{
+public:
+    //!\brief An entry in the index.
+    struct entry_t
+    {
+        std::string name;          //!< Name of the sequence (the ID up until the first whitespace).
+        uint64_t    length    = 0; //!< Number of bases in the sequence.
+        uint64_t    offset    = 0; //!< Offset of the first base in the (uncompressed) file.
+        uint64_t    linebases = 0; //!< Number of bases per line.
+        uint64_t    linewidth = 0; //!< Number of bytes per line (including the line-ending).
+
+        //!\brief The offset of the base at the given position (must be smaller than #length).
+        uint64_t offset_of(uint64_t const pos) const noexcept
+        {
+            return offset + pos / linebases * linewidth + pos % linebases;
+        }
+
+        //!\brief Defaulted comparison.
+        friend bool operator==(entry_t const &, entry_t const &) = default;
+    };
+
+    //!\brief The entries in order of occurrence in the file.
+    std::vector<entry_t> const & entries() const noexcept { return entries_; }
+
+    /*!\brief Add an entry to the index.
+     * \throws bio::io::format_error If an entry with the same name is already present.
+     */
+    void push_back(entry_t entry)
+    {
+        auto [it, inserted] = names_map.try_emplace(entry.name, entries_.size());
+        if (!inserted)
+            throw format_error{"Duplicate sequence name \"", entry.name, "\" in FAI index."};
+
+        entries_.push_back(std::move(entry));
+    }
+
+    //!\brief Return a pointer to the entry with the given name or `nullptr` if no such entry exists.
+    entry_t const * find(std::string_view const name) const
+    {
+        auto it = names_map.find(name);
+        return it == names_map.end() ? nullptr : &entries_[it->second];
+    }
+
+    //!\brief Read an index from disk.
+    void read(std::filesystem::path const & path);
+    //!\brief Write an index to disk.
+    void write(std::filesystem::path const & path) const;
+
+    /*!\brief Create an index by reading the given FastA file.
+     * \param[in] path The file to index; may be compressed.
+     * \param[in] istream_options Options passed to the underlying stream.
+     * \throws bio::io::format_error If the file contains sequences with inconsistent line lengths.
+     */
+    static fai_index build(std::filesystem::path const &       path,
+                           transparent_istream_options const & istream_options = transparent_istream_options{});
+
+    //!\brief Compares the entries.
+    friend bool operator==(fai_index const & lhs, fai_index const & rhs) { return lhs.entries_ == rhs.entries_; }
+
+private:
+    //!\brief Hash that allows lookup via std::string_view.
+    struct string_hash
+    {
+        using is_transparent = void; //!< Enables heterogeneous lookup.
+
+        //!\brief Hash the string.
+        size_t operator()(std::string_view const str) const noexcept { return std::hash<std::string_view>{}(str); }
+    };
+
+    //!\brief The entries.
+    std::vector<entry_t>                                                   entries_;
+    //!\brief Map of name to position in #entries_.
+    std::unordered_map<std::string, size_t, string_hash, std::equal_to<>> names_map;
+};
+
+inline void fai_index::read(std::filesystem::path const & path)
+{
+    std::ifstream istream{path};
+    if (!istream.good())
+        throw file_open_error{"Could not open FAI index file ", path.string(), " for reading."};
+
+    entries_.clear();
+    names_map.clear();
+
+    std::string line;
+    while (std::getline(istream, line))
+    {
+        if (line.empty())
+            continue;
+
+        std::string_view fields[5];
+        std::string_view rest = line;
+        for (size_t i = 0; i < 5; ++i)
+        {
+            size_t const tab = rest.find('\t');
+            if (tab == std::string_view::npos && i < 4)
+                throw format_error{"The FAI index ", path.string(), " has lines with fewer than five fields."};
+
+            fields[i] = rest.substr(0, tab);
+            rest      = tab == std::string_view::npos ? std::string_view{} : rest.substr(tab + 1);
+        }
+
+        if (!rest.empty())
+            throw format_error{"The FAI index ", path.string(), " has more than five fields (FastQ index?)."};
+
+        entry_t entry{.name = std::string{fields[0]}};
+        io::detail::string_to_number(fields[1], entry.length);
+        io::detail::string_to_number(fields[2], entry.offset);
+        io::detail::string_to_number(fields[3], entry.linebases);
+        io::detail::string_to_number(fields[4], entry.linewidth);
+
+        if (entry.length > 0 && (entry.linebases == 0 || entry.linewidth < entry.linebases))
+            throw format_error{"Invalid line length for sequence \"", entry.name, "\" in FAI index."};
+
+        push_back(std::move(entry));
+    }
+}
+
+inline void fai_index::write(std::filesystem::path const & path) const
+{
+    std::ofstream ostream{path, std::ios::binary};
+    if (!ostream.good())
+        throw file_open_error{"Could not open file ", path.string(), " for writing."};
+
+    io::detail::fast_ostreambuf_iterator<char> it{ostream};
+
+    for (entry_t const & entry : entries_)
+    {
+        it.write_range(entry.name);
+        it = '\t';
+        it.write_number(entry.length);
+        it = '\t';
+        it.write_number(entry.offset);
+        it = '\t';
+        it.write_number(entry.linebases);
+        it = '\t';
+        it.write_number(entry.linewidth);
+        it = '\n';
+    }
+}
+
+inline fai_index fai_index::build(std::filesystem::path const &       path,
+                                  transparent_istream_options const & istream_options)
+{
+    transparent_istream istream{path, istream_options};
+
+    fai_index   ret;
+    entry_t     entry;
+    bool        in_entry  = false; // a header line was seen
+    bool        last_line = false; // the last (possibly shorter) line of the current sequence was seen
+    uint64_t    offset    = 0;     // offset of the current line
+    std::string line;
+
+    while (std::getline(istream, line))
+    {
+        bool const       has_eol  = !istream.eof();
+        std::string_view line_v   = line;
+        uint64_t const   n_bytes  = line_v.size() + has_eol;
+        uint64_t const   eol_size = 1 + line_v.ends_with('\r');
+
+        if (line_v.starts_with('>'))
+        {
+            if (in_entry)
+                ret.push_back(std::move(entry));
+
+            line_v.remove_prefix(1);
+            entry        = entry_t{.name = std::string{line_v.substr(0, line_v.find_first_of(" \t\f\v\r"))}};
+            entry.offset = offset + n_bytes;
+            in_entry     = true;
+            last_line    = false;
+        }
+        else
+        {
+            size_t const n_bases = line_v.size() + 1 - eol_size;
+
+            if (n_bases > 0)
+            {
+                if (!in_entry)
+                    throw format_error{"The file ", path.string(), " does not begin with a FastA ID line."};
+
+                if (last_line || (entry.linebases > 0 && n_bases > entry.linebases))
+                    throw format_error{"Sequence \"", entry.name, "\" in ", path.string(),
+                                       " has lines of different length; cannot create FAI index."};
+
+                if (entry.linebases == 0)
+                {
+                    entry.linebases = n_bases;
+                    entry.linewidth = n_bases + eol_size;
+                }
+                else if (n_bases < entry.linebases || n_bases + eol_size != entry.linewidth)
+                {
+                    last_line = true;
+                }
+
+                entry.length += n_bases;
+            }
+            else if (in_entry)
+            {
+                last_line = true; // empty lines are only allowed at the end of a sequence
+            }
+        }
+
+        offset += n_bytes;
+    }
+
+    if (in_entry)
+        ret.push_back(std::move(entry));
+
+    return ret;
+}
+
+} // namespace bio::io::seq
@@ -0,0 +1,407 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2022, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2022, Knut Reinert & MPI für molekulare Genetik
+// Copyright (c) 2020-2022, deCODE Genetics
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/bio/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides bio::io::seq::packed_dna5_vector.
+ * \author Hannes Hauswedell <hannes.hauswedell AT decode.is>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <compare>
+#include <cstdint>
+#include <iterator>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <bio/alphabet/nucleotide/dna5.hpp>
+
+#include <bio/io/detail/char_to_alphabet.hpp>
+
+namespace bio::io::seq
+{
+
+/*!\brief A container of bio::alphabet::dna5 that stores two bits per base.
+ * \ingroup seq
+ * \details
+ *
+ * A, C, G and T are stored with two bits each (32 bases per 64-bit word). Since N cannot be represented in two bits,
+ * the positions of N are stored as a sorted list of runs (see #n_runs()); the packed storage holds an 'A' at these
+ * positions. For typical genomic data, this requires a quarter of the memory of a std::vector<bio::alphabet::dna5>.
+ *
+ * Elements are returned by value and cannot be modified in-place; the container can only be appended to. The
+ * container is filled from characters by assign_chars() and converted back to characters by to_chars(); these
+ * functions work on whole bytes of the packed storage (four bases) at once and are used by the format handlers
+ * when reading and writing records (see bio::io::seq::record_dna_packed).
+ */
+class packed_dna5_vector
+{
+public:
+    //!\brief A run of N characters.
+    struct n_run
+    {
+        uint64_t begin  = 0; //!< Position of the first N.
+        uint64_t length = 0; //!< Number of consecutive N.
+
+        //!\brief Defaulted comparison.
+        friend bool operator==(n_run const &, n_run const &) = default;
+    };
+
+    /*!\name Associated types
+     * \{
+     */
+    using value_type      = alphabet::dna5; //!< The value type.
+    using reference       = alphabet::dna5; //!< Elements are returned by value.
+    using const_reference = alphabet::dna5; //!< Elements are returned by value.
+    using size_type       = size_t;         //!< The size type.
+    using difference_type = ptrdiff_t;      //!< The difference type.
+
+    class iterator;
+    using const_iterator = iterator; //!< The container is not modifiable via iterators.
+    //!\}
+
+    /*!\name Element access
+     * \{
+     */
+    //!\brief Return the element at the given position.
+    alphabet::dna5 operator[](size_t const pos) const noexcept
+    {
+        assert(pos < size_);
+        if (in_n_run(pos))
+            return n_letter;
+        return code_to_letter[(words[pos / bases_per_word] >> (pos % bases_per_word * 2)) & 0b11];
+    }
+
+    //!\brief The runs of N, sorted by position; adjacent runs are always merged.
+    std::span<n_run const> n_runs() const noexcept { return n_runs_; }
+
+    //!\brief The packed storage (32 bases per word, lowest bits first; N are stored as A).
+    std::span<uint64_t const> raw_data() const noexcept { return words; }
+    //!\}
+
+    /*!\name Iterators
+     * \{
+     */
+    iterator begin() const noexcept; //!< Iterator to the first element.
+    iterator end() const noexcept;   //!< Iterator behind the last element.
+    //!\}
+
+    /*!\name Capacity
+     * \{
+     */
+    size_t size() const noexcept { return size_; }                   //!< The number of elements.
+    bool   empty() const noexcept { return size_ == 0; }             //!< Whether the container is empty.
+    void   reserve(size_t const n) { words.reserve(word_count(n)); } //!< Reserve storage for n elements.
+    //!\}
+
+    /*!\name Modifiers
+     * \{
+     */
+    //!\brief Remove all elements.
+    void clear() noexcept
+    {
+        words.clear();
+        n_runs_.clear();
+        size_ = 0;
+    }
+
+    //!\brief Append an element.
+    void push_back(alphabet::dna5 const letter)
+    {
+        uint8_t const code = char_to_code[static_cast<uint8_t>(alphabet::to_char(letter))];
+        if (size_ % bases_per_word == 0)
+            words.push_back(0);
+
+        if (code == n_code)
+            append_n(size_, 1);
+        else
+            words.back() |= uint64_t{code} << (size_ % bases_per_word * 2);
+
+        ++size_;
+    }
+
+    /*!\brief Replace the contents with the given characters.
+     * \throws bio::alphabet::invalid_char_assignment If a character is not valid for bio::alphabet::dna5.
+     */
+    void assign_chars(std::string_view const chars)
+    {
+        clear();
+        append_chars(chars);
+    }
+
+    /*!\brief Append the given characters.
+     * \throws bio::alphabet::invalid_char_assignment If a character is not valid for bio::alphabet::dna5.
+     * \details
+     *
+     * Characters are converted via a lookup table and combined into whole words; validity is checked once for the
+     * entire input (the contents are unspecified if an exception is thrown).
+     */
+    void append_chars(std::string_view const chars);
+    //!\}
+
+    /*!\brief Convert a part of the sequence to characters.
+     * \param[in] pos   The position of the first element; must not be larger than size().
+     * \param[in] count The number of elements; clamped to the end of the container.
+     * \param[out] out  Pointer to a buffer that can hold at least `count` characters.
+     * \returns The number of characters written.
+     * \details
+     *
+     * Four bases (one byte of the storage) are converted at once via a lookup table; runs of N are written
+     * afterwards.
+     */
+    size_t to_chars(size_t const pos, size_t count, char * const out) const;
+
+    //!\brief Return the sequence as a std::string.
+    std::string to_string() const
+    {
+        std::string ret;
+        ret.resize(size_);
+        to_chars(0, size_, ret.data());
+        return ret;
+    }
+
+    //!\brief Compares the elements.
+    friend bool operator==(packed_dna5_vector const & lhs, packed_dna5_vector const & rhs) noexcept
+    {
+        return lhs.size_ == rhs.size_ && lhs.words == rhs.words && lhs.n_runs_ == rhs.n_runs_;
+    }
+
+private:
+    //!\brief Number of bases stored in a word.
+    static constexpr size_t  bases_per_word = 32;
+    //!\brief Code used for N in #char_to_code (never stored).
+    static constexpr uint8_t n_code         = 4;
+
+    //!\brief The letters corresponding to the 2-bit codes.
+    static constexpr std::array<alphabet::dna5, 4> code_to_letter = []()
+    {
+        std::array<alphabet::dna5, 4> ret{};
+        for (size_t i = 0; i < 4; ++i)
+            alphabet::assign_char_to("ACGT"[i], ret[i]);
+        return ret;
+    }();
+
+    //!\brief The N letter.
+    static constexpr alphabet::dna5 n_letter = alphabet::assign_char_to('N', alphabet::dna5{});
+
+    //!\brief Maps every character to its 2-bit code (or #n_code); invalid characters are mapped like dna5 does.
+    static constexpr std::array<uint8_t, 256> char_to_code = []()
+    {
+        std::array<uint8_t, 256> ret{};
+        for (size_t i = 0; i < 256; ++i)
+        {
+            char const c = alphabet::to_char(io::detail::char_to_alphabet_table<alphabet::dna5>[i]);
+            ret[i]       = c == 'A' ? 0 : c == 'C' ? 1 : c == 'G' ? 2 : c == 'T' ? 3 : n_code;
+        }
+        return ret;
+    }();
+
+    //!\brief Maps every byte of the storage to the four characters it encodes.
+    static constexpr std::array<std::array<char, 4>, 256> byte_to_chars = []()
+    {
+        std::array<std::array<char, 4>, 256> ret{};
+        for (size_t i = 0; i < 256; ++i)
+            for (size_t j = 0; j < 4; ++j)
+                ret[i][j] = "ACGT"[(i >> (j * 2)) & 0b11];
+        return ret;
+    }();
+
+    //!\brief The number of words needed for n elements.
+    static constexpr size_t word_count(size_t const n) noexcept { return (n + bases_per_word - 1) / bases_per_word; }
+
+    //!\brief Whether the position is covered by a run of N.
+    bool in_n_run(uint64_t const pos) const noexcept
+    {
+        auto it = std::ranges::upper_bound(n_runs_, pos, {}, &n_run::begin);
+        return it != n_runs_.begin() && pos < (it - 1)->begin + (it - 1)->length;
+    }
+
+    //!\brief Add a run of N at the end (merged with the last run if adjacent).
+    void append_n(uint64_t const pos, uint64_t const length)
+    {
+        if (!n_runs_.empty() && n_runs_.back().begin + n_runs_.back().length == pos)
+            n_runs_.back().length += length;
+        else
+            n_runs_.push_back({pos, length});
+    }
+
+    //!\brief The packed storage.
+    std::vector<uint64_t> words;
+    //!\brief The runs of N.
+    std::vector<n_run>    n_runs_;
+    //!\brief The number of elements.
+    size_t                size_ = 0;
+};
+
+/*!\brief The iterator of bio::io::seq::packed_dna5_vector.
+ * \details
+ *
+ * A random access iterator that returns elements by value.
+ */
+class packed_dna5_vector::iterator
+{
+public:
+    /*!\name Associated types
+     * \{
+     */
+    using value_type        = alphabet::dna5;                  //!< The value type.
+    using reference         = alphabet::dna5;                  //!< Elements are returned by value.
+    using pointer           = void;                            //!< No pointer type.
+    using difference_type   = ptrdiff_t;                       //!< The difference type.
+    using iterator_category = std::input_iterator_tag;         //!< Legacy category (returns by value).
+    using iterator_concept  = std::random_access_iterator_tag; //!< The iterator concept.
+    //!\}
+
+    /*!\name Constructors
+     * \{
+     */
+    iterator() = default; //!< Defaulted.
+
+    //!\brief Construct from container and position.
+    iterator(packed_dna5_vector const & host, size_t const pos) noexcept : host{&host}, pos{pos} {}
+    //!\}
+
+    /*!\name Element access
+     * \{
+     */
+    alphabet::dna5 operator*() const noexcept { return (*host)[pos]; }                             //!< Dereference.
+    alphabet::dna5 operator[](difference_type const n) const noexcept { return (*host)[pos + n]; } //!< Offset.
+    //!\}
+
+    /*!\name Arithmetic
+     * \{
+     */
+    // clang-format off
+    iterator & operator++() noexcept { ++pos; return *this; }                             //!< Increment.
+    iterator   operator++(int) noexcept { iterator tmp = *this; ++pos; return tmp; }     //!< Post-increment.
+    iterator & operator--() noexcept { --pos; return *this; }                             //!< Decrement.
+    iterator   operator--(int) noexcept { iterator tmp = *this; --pos; return tmp; }     //!< Post-decrement.
+    iterator & operator+=(difference_type const n) noexcept { pos += n; return *this; }   //!< Advance.
+    iterator & operator-=(difference_type const n) noexcept { pos -= n; return *this; }   //!< Advance backwards.
+    // clang-format on
+
+    //!\brief Advance.
+    friend iterator operator+(iterator it, difference_type const n) noexcept { return it += n; }
+    //!\brief Advance.
+    friend iterator operator+(difference_type const n, iterator it) noexcept { return it += n; }
+    //!\brief Advance backwards.
+    friend iterator operator-(iterator it, difference_type const n) noexcept { return it -= n; }
+
+    //!\brief Distance.
+    friend difference_type operator-(iterator const & lhs, iterator const & rhs) noexcept
+    {
+        return static_cast<difference_type>(lhs.pos) - static_cast<difference_type>(rhs.pos);
+    }
+    //!\}
+
+    /*!\name Comparison
+     * \{
+     */
+    //!\brief Compares positions.
+    friend bool operator==(iterator const & lhs, iterator const & rhs) noexcept { return lhs.pos == rhs.pos; }
+    //!\brief Compares positions.
+    friend auto operator<=>(iterator const & lhs, iterator const & rhs) noexcept { return lhs.pos <=> rhs.pos; }
+    //!\}
+
+private:
+    //!\brief The container.
+    packed_dna5_vector const * host = nullptr;
+    //!\brief The position.
+    size_t                     pos  = 0;
+};
+
+inline packed_dna5_vector::iterator packed_dna5_vector::begin() const noexcept
+{
+    return iterator{*this, 0};
+}
+
+inline packed_dna5_vector::iterator packed_dna5_vector::end() const noexcept
+{
+    return iterator{*this, size_};
+}
+
+inline void packed_dna5_vector::append_chars(std::string_view const chars)
+{
+    size_t i = 0;
+    words.resize(word_count(size_ + chars.size()));
+
+    uint8_t invalid = 0;
+    auto    pack    = [&](size_t const n) // packs n characters into the current (partially filled) word
+    {
+        uint64_t &   word   = words[size_ / bases_per_word];
+        size_t const offset = size_ % bases_per_word;
+        uint64_t     bits   = 0;
+        for (size_t j = 0; j < n; ++j, ++i)
+        {
+            uint8_t const c    = static_cast<uint8_t>(chars[i]);
+            uint8_t const code = char_to_code[c];
+            invalid |= io::detail::char_invalid_table<alphabet::dna5>[c];
+
+            if (code == n_code) [[unlikely]]
+                append_n(size_ + j, 1);
+            else
+                bits |= uint64_t{code} << (j * 2);
+        }
+        word |= bits << (offset * 2);
+        size_ += n;
+    };
+
+    // fill the last word, then whole words
+    if (size_t const offset = size_ % bases_per_word; offset != 0)
+        pack(std::min(bases_per_word - offset, chars.size()));
+
+    while (i < chars.size())
+        pack(std::min(bases_per_word, chars.size() - i));
+
+    if (invalid != 0)
+    {
+        for (char const c : chars)
+            alphabet::assign_char_strictly_to(c, alphabet::dna5{}); // throws on the first invalid character
+    }
+}
+
+inline size_t packed_dna5_vector::to_chars(size_t const pos, size_t count, char * const out) const
+{
+    assert(pos <= size_);
+    count = std::min(count, size_ - pos);
+
+    // the n-th byte of the storage (four bases); independent of the byte order of the platform
+    auto byte = [this](size_t const n) -> uint8_t { return words[n / 8] >> (n % 8 * 8); };
+
+    size_t i = 0;
+    // leading bases up to a byte boundary
+    for (; i < count && (pos + i) % 4 != 0; ++i)
+        out[i] = byte_to_chars[byte((pos + i) / 4)][(pos + i) % 4];
+    // four bases at a time
+    for (; i + 4 <= count; i += 4)
+        std::ranges::copy(byte_to_chars[byte((pos + i) / 4)], out + i);
+    // trailing bases
+    for (; i < count; ++i)
+        out[i] = byte_to_chars[byte((pos + i) / 4)][(pos + i) % 4];
+
+    // overwrite N
+    auto it = std::ranges::upper_bound(n_runs_, pos, {}, &n_run::begin);
+    if (it != n_runs_.begin())
+        --it;
+    for (; it != n_runs_.end() && it->begin < pos + count; ++it)
+    {
+        uint64_t const b = std::max<uint64_t>(it->begin, pos);
+        uint64_t const e = std::min<uint64_t>(it->begin + it->length, pos + count);
+        if (b < e)
+            std::fill(out + (b - pos), out + (e - pos), 'N');
+    }
+
+    return count;
+}
+
+} // namespace bio::io::seq
@@ -0,0 +1,371 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2022, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2022, Knut Reinert & MPI für molekulare Genetik
+// Copyright (c) 2020-2022, deCODE Genetics
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/bio/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides bio::io::seq::paired_reader.
+ * \author Hannes Hauswedell <hannes.hauswedell AT decode.is>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <exception>
+#include <filesystem>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+
+#include <bio/io/exception.hpp>
+#include <bio/io/seq/reader.hpp>
+#include <bio/io/seq/reader_options.hpp>
+#include <bio/io/seq/record_batch.hpp>
+#include <bio/io/seq/statistics.hpp>
+
+namespace bio::io::seq
+{
+
+/*!\brief A reader for paired-end sequence data, i.e. two files (R1/R2) or one interleaved file.
+ * \ingroup seq
+ * \tparam option_args_t Template arguments of bio::io::seq::reader_options (usually deduced).
+ * \details
+ *
+ * ### Introduction
+ *
+ * This class owns two bio::io::seq::reader and advances them in lock-step. Iterating over it yields
+ * `std::pair`s of references to the records of both mates:
+ *
+ * ```cpp
+ * bio::io::seq::paired_reader reader{"reads_R1.fastq.gz", "reads_R2.fastq.gz"};
+ *
+ * for (auto && [mate1, mate2] : reader)
+ *     std::cout << mate1.id << '\t' << mate2.id << '\n';
+ * ```
+ *
+ * Alternatively, pairs can be read in batches via read_batch(); in this case, the two files are parsed on two
+ * threads concurrently.
+ *
+ * ### Interleaved files
+ *
+ * If only one file is given, it is assumed to contain the mates of each pair as consecutive records. Internally,
+ * the file is opened twice and each reader moves over the records of the other mate without parsing them.
+ *
+ * ### Checking of names
+ *
+ * By default, the IDs of the mates are compared (see mate_names_match()) and a bio::io::format_error is thrown if
+ * they differ. A bio::io::format_error is also thrown if one file ends before the other.
+ *
+ * ### Decompression
+ *
+ * The decompression threads (see bio::io::transparent_istream_options::threads) are split between the two streams,
+ * i.e. the total number of threads used for decompression is the same as for a single reader.
+ */
+template <typename... option_args_t>
+class paired_reader
+{
+public:
+    //!\brief The type of the reader for a single mate.
+    using reader_type = reader<option_args_t...>;
+    //!\brief The type of the record of a single mate.
+    using record_type = typename reader_type::record_type;
+
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+    /*!\brief Construct from the filenames of both mates.
+     * \param[in] filename1   Path to the file with the first mates (R1).
+     * \param[in] filename2   Path to the file with the second mates (R2).
+     * \param[in] opt         Reader options (bio::io::seq::reader_options); used for both readers. [optional]
+     * \param[in] check_names Whether to check that the IDs of mates match. [optional]
+     * \throws bio::io::file_open_error If a file could not be opened.
+     * \throws bio::io::bio_error If bio::io::seq::reader_options::shard is set (mates could end up in different
+     * shards).
+     */
+    paired_reader(std::filesystem::path const &    filename1,
+                  std::filesystem::path const &    filename2,
+                  reader_options<option_args_t...> opt         = reader_options<option_args_t...>{},
+                  bool const                       check_names = true) :
+      reader1{filename1, split_threads(opt)},
+      reader2{filename2, std::move(opt)},
+      check_names{check_names}
+    {}
+
+    /*!\brief Construct from the filename of an interleaved file.
+     * \param[in] filename    Path to the file with alternating first and second mates.
+     * \param[in] opt         Reader options (bio::io::seq::reader_options). [optional]
+     * \param[in] check_names Whether to check that the IDs of mates match. [optional]
+     * \throws bio::io::file_open_error If the file could not be opened.
+     * \throws bio::io::bio_error If bio::io::seq::reader_options::shard is set (mates could end up in different
+     * shards).
+     */
+    explicit paired_reader(std::filesystem::path const &    filename,
+                           reader_options<option_args_t...> opt         = reader_options<option_args_t...>{},
+                           bool const                       check_names = true) :
+      paired_reader{filename, filename, std::move(opt), check_names}
+    {
+        interleaved = true;
+    }
+
+    paired_reader()                                  = delete;  //!< Deleted.
+    paired_reader(paired_reader const &)             = delete;  //!< Deleted.
+    paired_reader(paired_reader &&)                  = default; //!< Defaulted.
+    ~paired_reader()                                 = default; //!< Defaulted.
+    paired_reader & operator=(paired_reader const &) = delete;  //!< Deleted.
+    paired_reader & operator=(paired_reader &&)      = default; //!< Defaulted.
+    //!\}
+
+    /*!\name Range interface
+     * \{
+     */
+    //!\brief The iterator type; dereferences to a pair of references to the mates.
+    class iterator
+    {
+    public:
+        //!\brief The value type.
+        using value_type        = std::pair<record_type &, record_type &>;
+        //!\brief The reference type (a proxy).
+        using reference         = value_type;
+        //!\brief The difference type.
+        using difference_type   = ptrdiff_t;
+        //!\brief Tag this class as an input iterator.
+        using iterator_category = std::input_iterator_tag;
+
+        iterator() = default; //!< Defaulted.
+
+        //!\brief Construct with reference to host.
+        iterator(paired_reader & _host) noexcept : host{&_host} {}
+
+        //!\brief Move to the next pair.
+        iterator & operator++()
+        {
+            host->read_next_pair();
+            return *this;
+        }
+
+        //!\brief Post-increment is the same as pre-increment, but returns void.
+        void operator++(int) { ++(*this); }
+
+        //!\brief Return the current pair.
+        reference operator*() const noexcept { return {host->reader1.front(), host->reader2.front()}; }
+
+        //!\brief Checks whether `*this` is at end.
+        bool operator==(std::default_sentinel_t const &) const noexcept
+        {
+            return host->reader1.begin() == host->reader1.end();
+        }
+
+    private:
+        //!\brief Pointer to the host.
+        paired_reader * host = nullptr;
+    };
+
+    /*!\brief Returns an iterator to the current pair.
+     * \throws bio::io::format_error If the mates do not match.
+     */
+    iterator begin()
+    {
+        if (init_state)
+        {
+            init_state = false;
+            if (interleaved)
+                reader2.skip(1);
+            check_pair();
+        }
+        return {*this};
+    }
+
+    //!\brief Returns a sentinel for comparison with iterator.
+    std::default_sentinel_t end() noexcept { return {}; }
+    //!\}
+
+    /*!\name Batches
+     * \{
+     */
+    /*!\brief Read multiple pairs into two batches, beginning with the current pair.
+     * \param[out] batch1 The batch for the first mates; it is cleared before reading.
+     * \param[out] batch2 The batch for the second mates; it is cleared before reading.
+     * \param[in] n The maximum number of pairs to read.
+     * \returns The number of pairs read; smaller than `n` only if the end of the files was reached.
+     * \throws bio::io::format_error If the mates do not match.
+     * \details
+     *
+     * The second mates are read on a separate thread. See bio::io::seq::reader::read_batch() for details on batches.
+     * Reading via begin() and read_batch() can be mixed.
+     */
+    template <typename seq_t, typename qual_t>
+    size_t read_batch(record_batch<seq_t, qual_t> & batch1, record_batch<seq_t, qual_t> & batch2, size_t const n)
+    {
+        begin();
+
+        std::exception_ptr exception2;
+        {
+            std::jthread thread2{[&]()
+                                 {
+                                     try
+                                     {
+                                         read_mates(reader2, batch2, n);
+                                     }
+                                     catch (...)
+                                     {
+                                         exception2 = std::current_exception();
+                                     }
+                                 }};
+            read_mates(reader1, batch1, n);
+        } // joins
+        if (exception2)
+            std::rethrow_exception(exception2);
+
+        if (batch1.size() != batch2.size())
+            throw format_error{"The files of the pairs contain a different number of records."};
+
+        if (check_names)
+        {
+            for (size_t i = 0; i < batch1.size(); ++i)
+                if (!mate_names_match(batch1.ids[i], batch2.ids[i]))
+                    throw_name_mismatch(batch1.ids[i], batch2.ids[i]);
+        }
+
+        check_pair();
+        return batch1.size();
+    }
+    //!\}
+
+    /*!\brief The statistics of the first and of the second mates read so far.
+     * \details
+     *
+     * Requires bio::io::seq::reader_options::compute_statistics to be set; see bio::io::seq::reader::statistics().
+     * Merge the two objects via bio::io::seq::statistics::operator+=() to obtain the statistics of all reads.
+     */
+    std::pair<seq::statistics const &, seq::statistics const &> statistics() const noexcept
+    {
+        return {reader1.statistics(), reader2.statistics()};
+    }
+
+    /*!\brief Check whether two IDs belong to mates of the same pair.
+     * \param[in] id1 The ID of the first mate.
+     * \param[in] id2 The ID of the second mate.
+     * \details
+     *
+     * The IDs are truncated at the first whitespace, and a trailing `/1` or `/2` is removed. The remainders need to be
+     * equal.
+     */
+    template <std::ranges::contiguous_range id1_t, std::ranges::contiguous_range id2_t>
+        //!\cond REQ
+        requires(std::same_as<std::ranges::range_value_t<id1_t>, char> &&
+                 std::same_as<std::ranges::range_value_t<id2_t>, char>)
+    //!\endcond
+    static bool mate_names_match(id1_t && id1, id2_t && id2) noexcept
+    {
+        return mate_name(std::string_view{std::ranges::data(id1), std::ranges::size(id1)}) ==
+               mate_name(std::string_view{std::ranges::data(id2), std::ranges::size(id2)});
+    }
+
+private:
+    //!\brief Reduce an ID to the part that is shared between the mates.
+    static std::string_view mate_name(std::string_view id) noexcept
+    {
+        id = id.substr(0, std::min(id.find(' '), id.find('\t')));
+
+        if (id.size() >= 2 && id[id.size() - 2] == '/' && (id.back() == '1' || id.back() == '2'))
+            id.remove_suffix(2);
+
+        return id;
+    }
+
+    //!\brief Throw an exception for IDs of mates that do not match.
+    template <typename id1_t, typename id2_t>
+    [[noreturn]] static void throw_name_mismatch(id1_t && id1, id2_t && id2)
+    {
+        std::string const name1{std::ranges::begin(id1), std::ranges::end(id1)};
+        std::string const name2{std::ranges::begin(id2), std::ranges::end(id2)};
+        throw format_error{"The IDs of the mates do not match: \"" + name1 + "\" and \"" + name2 + "\"."};
+    }
+
+    /*!\brief Give half of the decompression threads to the first reader and return its options.
+     * \details
+     *
+     * The options cannot be copied if the record is shallow, so all members except the record are copied
+     * individually (the record member only determines the type). Sharding is rejected, because the shards of the
+     * two files (or of an interleaved file) do not consist of the same pairs.
+     */
+    static reader_options<option_args_t...> split_threads(reader_options<option_args_t...> & opt)
+    {
+        if (opt.shard.count > 1)
+            throw bio_error{"Sharding is not supported when reading paired reads."};
+
+        size_t const threads = opt.stream_options.threads;
+
+        reader_options<option_args_t...> opt1{.compute_qual_stats = opt.compute_qual_stats,
+                                              .compute_statistics = opt.compute_statistics,
+                                              .formats            = opt.formats,
+                                              .qual_offset        = opt.qual_offset,
+                                              .stream_options     = opt.stream_options,
+                                              .truncate_ids       = opt.truncate_ids};
+
+        opt.stream_options.threads  = std::max<size_t>(1, threads / 2);
+        opt1.stream_options.threads = std::max<size_t>(1, threads - opt.stream_options.threads);
+        return opt1;
+    }
+
+    //!\brief Check that both readers are (not) at end and that the IDs match.
+    void check_pair()
+    {
+        bool const at_end1 = reader1.begin() == reader1.end();
+        bool const at_end2 = reader2.begin() == reader2.end();
+
+        if (at_end1 != at_end2)
+            throw format_error{"The files of the pairs contain a different number of records."};
+
+        if constexpr (requires(record_type & r) { mate_names_match(r.id, r.id); })
+        {
+            if (!at_end1 && check_names && !mate_names_match(reader1.front().id, reader2.front().id))
+                throw_name_mismatch(reader1.front().id, reader2.front().id);
+        }
+    }
+
+    //!\brief Move both readers to the next pair.
+    void read_next_pair()
+    {
+        reader1.skip(interleaved ? 2 : 1);
+        reader2.skip(interleaved ? 2 : 1);
+        check_pair();
+    }
+
+    //!\brief Read the mates of the next `n` pairs from one reader.
+    template <typename seq_t, typename qual_t>
+    void read_mates(reader_type & reader, record_batch<seq_t, qual_t> & batch, size_t const n)
+    {
+        if (!interleaved)
+        {
+            reader.read_batch(batch, n);
+            return;
+        }
+
+        batch.clear();
+        for (size_t i = 0; i < n && reader.begin() != reader.end(); ++i)
+        {
+            batch.push_back(reader.front());
+            reader.skip(2);
+        }
+    }
+
+    //!\brief Reader for the first mates.
+    reader_type reader1;
+    //!\brief Reader for the second mates.
+    reader_type reader2;
+    //!\brief Whether the IDs of mates are checked.
+    bool        check_names = true;
+    //!\brief Whether the mates are read from a single file.
+    bool        interleaved = false;
+    //!\brief Tracks whether the first pair is buffered when calling begin().
+    bool        init_state  = true;
+};
+
+} // namespace bio::io::seq
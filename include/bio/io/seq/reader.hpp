@@ -13,7 +13,15 @@
 
 #pragma once
 
+#include <algorithm>
+#include <exception>
+#include <filesystem>
+#include <limits>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
 #include <vector>
 
 #include <bio/alphabet/aminoacid/aa27.hpp>
@@ -22,11 +30,24 @@
 #include <bio/alphabet/quality/phred63.hpp>
 #include <bio/ranges/views/char_strictly_to.hpp>
 
+#include <bio/io/detail/char_to_alphabet.hpp>
+#include <bio/io/detail/index_gzi.hpp>
+#ifdef BIOCPP_IO_HAS_ZLIB
+#    include <bio/io/detail/bgzf_block_reader.hpp>
+#endif
 #include <bio/io/detail/reader_base.hpp>
 #include <bio/io/format/fasta_input_handler.hpp>
 #include <bio/io/format/fastq_input_handler.hpp>
+#include <bio/io/format/twobit_input_handler.hpp>
+#include <bio/io/format/ubam_input_handler.hpp>
+#include <bio/io/genomic_region.hpp>
 #include <bio/io/misc.hpp>
+#include <bio/io/misc/char_predicate.hpp>
+#include <bio/io/seq/fai_index.hpp>
 #include <bio/io/seq/reader_options.hpp>
+#include <bio/io/seq/record_batch.hpp>
+#include <bio/io/seq/statistics.hpp>
+#include <bio/io/stream/detail/fast_streambuf_iterator.hpp>
 
 namespace bio::io::seq
 {
@@ -56,6 +77,8 @@ namespace bio::io::seq
  *
  *   1. FastA (see also bio::io::fasta)
  *   2. FastQ (see also bio::io::fastq)
+ *   3. 2bit (see also bio::io::twobit)
+ *   4. unaligned BAM (see also bio::io::ubam)
  *
  * Fields that are not present in a format (e.g. bio::io::detail::field::qual in FastA) will be returned empty.
  *
@@ -97,6 +120,25 @@ namespace bio::io::seq
  * For more information on *shallow* vs *deep*, see \ref shallow_vs_deep
  *
  * For more advanced options, see bio::io::seq::reader_options.
+ *
+ * ### Batches
+ *
+ * Records can also be read in batches, see read_batch() and bio::io::seq::record_batch.
+ *
+ * ### Qualities
+ *
+ * Qualities of FastQ files are validated while reading, and Phred+64 files can be converted on-the-fly. Mean and
+ * minimum quality of each record can be computed in the same pass, see current_qual_stats().
+ *
+ * ### Statistics
+ *
+ * Read-length histogram, base composition per position, GC content and quality profile of all records can be
+ * accumulated while reading, see bio::io::seq::reader_options::compute_statistics and statistics().
+ *
+ * ### Random access
+ *
+ * Subsequences of 2bit files and of indexed FastA files can be fetched directly via fetch(). See
+ * bio::io::seq::fai_index for how to create an index for FastA files; 2bit files contain their own index.
  */
 template <typename... option_args_t>
 class reader : public reader_base<reader<option_args_t...>, reader_options<option_args_t...>>
@@ -182,6 +224,757 @@ public:
            reader_options<option_args_t...> opt = reader_options<option_args_t...>{}) :
       base_t{std::move(str), fmt, std::move(opt)}
     {}
+
+    /*!\name Batches
+     * \{
+     */
+    /*!\brief Read multiple records into a batch, beginning with the current one.
+     * \param[out] batch The batch; it is cleared before reading.
+     * \param[in] n The maximum number of records to read.
+     * \returns The number of records read; smaller than `n` only if the end of the file was reached.
+     * \throws bio::alphabet::invalid_char_assignment If the batch stores alphabets and the characters are invalid.
+     * \details
+     *
+     * The records are stored directly in the batch (see bio::io::seq::record_batch). The format is dispatched once per
+     * batch and the fields are copied from the format's buffers without creating an intermediate record. If the same
+     * batch is reused, no memory is allocated once the batch has grown to its final size.
+     *
+     * Afterwards, the record behind the batch is buffered, i.e. reading via begin() and read_batch() can be mixed.
+     */
+    template <typename seq_t, typename qual_t>
+    size_t read_batch(record_batch<seq_t, qual_t> & batch, size_t const n)
+    {
+        batch.clear();
+        base_t::begin(); // the first record is buffered
+
+        if (n == 0 || at_end)
+            return 0;
+
+        batch.push_back(record_buffer); // current record
+
+        std::visit(
+          [&](auto & handler)
+          {
+              record<std::string_view, std::string_view, std::string_view> raw;
+              for (size_t i = 1; i < n; ++i)
+              {
+                  if (std::istreambuf_iterator<char>{stream} == std::istreambuf_iterator<char>{} ||
+                      !before_shard_end())
+                  {
+                      at_end = true;
+                      return;
+                  }
+
+                  handler.parse_next_record_into(raw);
+                  if (options.compute_statistics)
+                      stats.add(raw.seq, raw.qual);
+                  batch.push_back(raw);
+              }
+          },
+          format_handler);
+
+        read_next_record(); // buffer the record behind the batch
+        return batch.size();
+    }
+
+    /*!\brief Read the next chunk of a FastQ file and parse it on multiple threads.
+     * \param[out] batch The batch; it is cleared before reading.
+     * \param[in] n_threads The number of threads to use (including the calling thread).
+     * \param[in] chunk_size The number of bytes (of the decompressed file) to parse per thread.
+     * \returns The number of records read; 0 only if the end of the file was reached.
+     * \throws bio::io::bio_error If the format is not FastQ or the quality options are set (see below).
+     * \throws bio::io::parse_error If the file is malformed.
+     * \details
+     *
+     * Reads `n_threads * chunk_size` bytes from the (decompressed) file and splits them into `n_threads` parts.
+     * The first record in each part is found heuristically (see
+     * bio::io::format_input_handler<bio::io::fastq>::find_record_start()) and validated by checking that the records
+     * of the previous part end exactly there; if they don't, the part is parsed again from the end of the previous
+     * part. The parts are parsed on separate threads and appended to the batch in order. An incomplete record at the
+     * end of the data is kept and completed by the next call.
+     *
+     * If bio::io::seq::reader_options::compute_statistics is set, every thread accumulates the statistics of its
+     * part, and the partial results are merged afterwards.
+     *
+     * The records in the batch are in file order. Together with multi-threaded decompression of BGZF files (see
+     * bio::io::transparent_istream_options), this allows reading FastQ files with all stages running in parallel.
+     *
+     * If a record was buffered by previous record-based reading, it is the first record of the batch. After calling
+     * this function, record-based reading via begin() and read_batch() is not possible until reopen() is called.
+     *
+     * The qualities are validated as Phred+33; the options bio::io::seq::reader_options::qual_offset,
+     * bio::io::seq::reader_options::compute_qual_stats and bio::io::seq::reader_options::shard are not supported.
+     */
+    template <typename seq_t, typename qual_t>
+    size_t read_batch_parallel(record_batch<seq_t, qual_t> & batch,
+                               size_t                        n_threads  = std::thread::hardware_concurrency(),
+                               size_t const                  chunk_size = 1ull << 22)
+    {
+        if (!std::visit([](auto f) { return std::same_as<decltype(f), fastq>; }, format))
+            throw bio_error{"Parallel parsing is only supported for FastQ files."};
+        if (options.qual_offset != 33 || options.compute_qual_stats || options.shard.count > 1)
+            throw bio_error{"Parallel parsing does not support the qual_offset, compute_qual_stats and shard options."};
+
+        batch.clear();
+        if (!init_state && !parallel_mode && !at_end) // a record is buffered
+            batch.push_back(record_buffer);
+
+        init_state    = false;
+        at_end        = true; // record-based reading is not possible
+        parallel_mode = true;
+
+        n_threads              = std::max<size_t>(n_threads, 1);
+        size_t       requested = n_threads * std::max<size_t>(chunk_size, 1);
+        size_t const n_before  = batch.size();
+        // read more data if not a single record is complete (records larger than the chunks)
+        while (!read_parallel_chunk(batch, n_threads, requested) && batch.size() == n_before)
+            requested *= 2;
+
+        return batch.size();
+    }
+    //!\}
+
+    /*!\brief The quality statistics of the current record.
+     * \details
+     *
+     * Requires bio::io::seq::reader_options::compute_qual_stats to be set; otherwise, or if the format does not
+     * have qualities, a default-initialised bio::io::seq::qual_stats is returned. After read_batch(), this refers
+     * to the record behind the batch.
+     *
+     * This makes it possible to filter records by quality without a second pass over the qualities:
+     *
+     * ```cpp
+     * bio::io::seq::reader reader{"reads.fastq", bio::io::seq::reader_options{.compute_qual_stats = true}};
+     *
+     * for (auto & rec : reader)
+     *     if (reader.current_qual_stats().mean >= 20)
+     *         // ...
+     * ```
+     */
+    qual_stats current_qual_stats()
+    {
+        base_t::begin();
+        return std::visit(
+          [](auto const & handler)
+          {
+              if constexpr (requires { handler.current_qual_stats(); })
+                  return handler.current_qual_stats();
+              else
+                  return qual_stats{};
+          },
+          format_handler);
+    }
+
+    /*!\brief The statistics of all records read so far.
+     * \details
+     *
+     * Requires bio::io::seq::reader_options::compute_statistics to be set; otherwise, the statistics are empty.
+     * The statistics include the buffered record, i.e. the current record when iterating and the record behind the
+     * batch after read_batch(). Records skipped via skip() are not included. reopen() resets the statistics.
+     *
+     * The statistics are computed from the characters of the file while the record is parsed, so no second pass
+     * over the records is necessary:
+     *
+     * ```cpp
+     * bio::io::seq::reader reader{"reads.fastq", bio::io::seq::reader_options{.compute_statistics = true}};
+     *
+     * for (auto & rec : reader)
+     *     // ...
+     *
+     * double gc = reader.statistics().gc_content();
+     * ```
+     */
+    seq::statistics const & statistics() const noexcept { return stats; }
+
+    /*!\name Random access
+     * \brief Fetch subsequences from 2bit files or from FastA files via a bio::io::seq::fai_index.
+     * \{
+     */
+    /*!\brief Set the FAI index used by fetch().
+     * \param[in] index The index.
+     */
+    void set_fai_index(fai_index index) { fai = std::move(index); }
+
+    /*!\brief Read the FAI index from a file.
+     * \param[in] index_file The index file; defaults to "FILENAME.fai".
+     * \throws bio::io::file_open_error If no file name is given and the reader was not created from a file.
+     */
+    void read_fai_index(std::filesystem::path index_file = {})
+    {
+        if (index_file.empty())
+        {
+            if (stream.filename().empty())
+                throw file_open_error{"No FAI index file given and reader was not created from file."};
+            index_file = stream.filename();
+            index_file += ".fai";
+        }
+
+        fai.emplace();
+        fai->read(index_file);
+    }
+
+    /*!\brief Fetch a subsequence of a FastA or 2bit file.
+     * \param[in] region The region; positions are 0-based and half-open, they are clamped to the sequence length.
+     * \param[out] seq The subsequence is stored here; a container of `char` or of an alphabet, or a std::string_view.
+     * \throws bio::io::bio_error If the file is neither FastA nor 2bit, the sequence is not part of the index, or the
+     * file is compressed with a format other than BGZF.
+     * \throws bio::alphabet::invalid_char_assignment If the subsequence contains characters that are invalid for
+     * the alphabet of `seq`.
+     * \details
+     *
+     * The position of the first requested base is computed from the index, and only the requested bases
+     * (and the line-endings in between) are read from the file.
+     *
+     * If no index has been set via set_fai_index() or read_fai_index(), the file "FILENAME.fai" is read if it
+     * exists; otherwise the index is created by reading the file once (see bio::io::seq::fai_index::build()).
+     * BGZF compressed files are supported; their GZI index is read from "FILENAME.gzi" if present or created
+     * from the block headers. Only the (one or two) BGZF blocks that contain the region are decompressed, and the
+     * last block is cached, so fetching nearby regions repeatedly is cheap.
+     *
+     * 2bit files contain an index of the sequences, so no index file is needed. Only the bytes that hold the
+     * requested bases are read and unpacked; masked bases are returned in lower-case.
+     *
+     * If `seq` is a std::string_view, it refers to an internal buffer that is valid until the next call to fetch().
+     *
+     * Record-based reading via begin() is not possible after calling this function; call reopen() to start
+     * reading records from the beginning of the file.
+     */
+    template <typename seq_t>
+    void fetch(genomic_region const & region, seq_t & seq)
+    {
+        std::string_view const chars = fetch_chars(region);
+
+        if constexpr (std::same_as<seq_t, std::string_view> || io::detail::char_range<seq_t>)
+        {
+            io::detail::string_copy(chars, seq);
+        }
+        else if constexpr (io::detail::bulk_char_convertible<seq_t>) // e.g. packed_dna5_vector
+        {
+            seq.assign_chars(chars);
+        }
+        else
+        {
+            static_assert(ranges::back_insertable<seq_t> &&
+                            alphabet::alphabet<std::ranges::range_reference_t<seq_t>>,
+                          "The sequence passed to fetch() must be a container of char or alphabet, or a "
+                          "std::string_view.");
+            if constexpr (requires { io::detail::char_strictly_to_bulk(chars, seq); })
+                io::detail::char_strictly_to_bulk(chars, seq);
+            else
+                io::detail::sized_range_copy(chars | views::char_strictly_to<std::ranges::range_value_t<seq_t>>, seq);
+        }
+    }
+
+    /*!\brief Fetch a subsequence of a FastA or 2bit file.
+     * \param[in] region The region; positions are 0-based and half-open, they are clamped to the sequence length.
+     * \returns A std::string_view of the characters; valid until the next call to fetch().
+     * \throws bio::io::bio_error If the file is neither FastA nor 2bit, the sequence is not part of the index, or the
+     * file is compressed with a format other than BGZF.
+     * \details
+     *
+     * See the other overload for details.
+     */
+    std::string_view fetch(genomic_region const & region) { return fetch_chars(region); }
+    //!\}
+
+private:
+    //!\brief Reset the state of parallel reading and initialise the format handler [called by the base class].
+    void init()
+    {
+        parallel_buffer.clear();
+        parallel_mode = false;
+        stats.clear();
+        if (options.shard.count > 1)
+            init_shard();
+        base_t::init();
+    }
+
+    //!\brief Read the next record unless the end of the shard is reached [called by the base class].
+    void read_next_record()
+    {
+        if (!at_end && !before_shard_end())
+            at_end = true;
+
+        if (!options.compute_statistics)
+        {
+            base_t::read_next_record();
+            return;
+        }
+
+        // like in the base class, but the statistics are computed before the fields are converted
+        if (at_end)
+            return;
+
+        if (std::istreambuf_iterator<char>{stream} == std::istreambuf_iterator<char>{})
+        {
+            at_end = true;
+            return;
+        }
+
+        std::visit(
+          [&](auto & handler)
+          {
+              record<std::string_view, std::string_view, std::string_view> raw;
+              handler.parse_next_record_into(raw);
+              stats.add(raw.seq, raw.qual);
+              handler.parse_current_record_into(record_buffer);
+          },
+          format_handler);
+    }
+
+    //!\brief Skip records; stops at the end of the shard [called by the base class].
+    uint64_t skip_raw_records(uint64_t const n)
+    {
+        if (options.shard.count <= 1)
+            return base_t::skip_raw_records(n);
+
+        uint64_t i = 0;
+        for (; i < n && before_shard_end(); ++i)
+            base_t::skip_raw_records(1);
+        return i;
+    }
+
+    /*!\name Sharding
+     * \brief Helpers for bio::io::seq::reader_options::shard.
+     * \details
+     *
+     * All offsets refer to the uncompressed data. For BGZF files, they are translated via the GZI index.
+     * \{
+     */
+    //!\brief Compute the end of the shard and move to its first record.
+    void init_shard()
+    {
+        shard_spec const & shard = options.shard;
+        if (shard.index >= shard.count)
+            throw bio_error{"The shard index (", shard.index, ") must be smaller than the number of shards (",
+                            shard.count, ")."};
+        if (!std::visit([]<typename format_t>(format_t)
+                        { return std::same_as<format_t, fasta> || std::same_as<format_t, fastq>; },
+                        format))
+            throw bio_error{"Sharding is only supported for FastA and FastQ files."};
+        if (stream.filename().empty())
+            throw bio_error{"Sharding requires the reader to be created from a file."};
+
+        switch (stream.compression())
+        {
+            case compression_format::none:
+                break;
+            case compression_format::bgzf:
+            case compression_format::gz: // BGZF files are read as GZ files in single-threaded mode
+                io::detail::load_gzi_index(stream, gzi);
+                break;
+            default:
+                throw bio_error{"Sharding is only possible on uncompressed and BGZF-compressed files."};
+        }
+
+        uint64_t const file_size = std::filesystem::file_size(stream.filename());
+
+        // the boundary between shards i-1 and i
+        auto boundary = [&](size_t const i) -> uint64_t
+        {
+            if (i == 0)
+                return 0;
+            if (i == shard.count)
+                return std::numeric_limits<uint64_t>::max();
+
+            uint64_t const on_disk = i * file_size / shard.count;
+            if (stream.compression() == compression_format::none)
+                return on_disk;
+
+            auto it = std::ranges::lower_bound(gzi->blocks, on_disk, {}, [](auto const & p) { return p.first; });
+            return it == gzi->blocks.end() ? std::numeric_limits<uint64_t>::max() : it->second;
+        };
+
+        shard_end            = boundary(shard.index + 1);
+        uint64_t const start = find_record_start(boundary(shard.index));
+
+        if (start < shard_end)
+        {
+            shard_seek(start);
+        }
+        else // empty shard; the format handler is still created at the beginning of the file (requires data)
+        {
+            shard_end = 0;
+            shard_seek(0);
+        }
+    }
+
+    //!\brief Find the first record that begins at or behind the given offset.
+    uint64_t find_record_start(uint64_t const offset)
+    {
+        if (offset == 0 || offset == std::numeric_limits<uint64_t>::max())
+            return offset;
+
+        if (std::holds_alternative<fasta>(format))
+        {
+            if (!fai.has_value())
+            {
+                std::filesystem::path fai_file = stream.filename();
+                fai_file += ".fai";
+                if (std::filesystem::exists(fai_file))
+                    fai.emplace().read(fai_file);
+            }
+
+            /* The index only gives the offset of the sequence, so the header line is searched for between the end
+             * of the previous sequence and that offset (records may be separated by empty lines).
+             */
+            if (fai.has_value())
+            {
+                uint64_t    sequence_end = 0; // of the previous record
+                std::string between;
+                for (fai_index::entry_t const & entry : fai->entries())
+                {
+                    if (entry.offset > offset)
+                    {
+                        shard_seek(sequence_end);
+                        between.resize(entry.offset - sequence_end);
+                        stream.read(between.data(), between.size());
+                        between.resize(stream.gcount());
+                        stream.clear();
+
+                        // the last character is the end of the header line
+                        size_t const eol =
+                          between.size() < 2 ? std::string::npos : between.rfind('\n', between.size() - 2);
+                        uint64_t const record_start = eol == std::string::npos ? sequence_end : sequence_end + eol + 1;
+                        if (record_start >= offset)
+                            return record_start;
+                    }
+
+                    uint64_t const rest = entry.linebases == 0 ? 0 : entry.length % entry.linebases;
+                    sequence_end        = entry.offset;
+                    if (entry.linebases > 0)
+                        sequence_end += entry.length / entry.linebases * entry.linewidth;
+                    if (rest > 0)
+                        sequence_end += rest + entry.linewidth - entry.linebases;
+                }
+                return std::numeric_limits<uint64_t>::max();
+            }
+        }
+
+        // the data begins one character before the offset, so it is known whether the offset is a line beginning
+        std::string data;
+        for (size_t size = 1ull << 16;; size *= 2)
+        {
+            shard_seek(offset - 1);
+            data.resize(size);
+            stream.read(data.data(), size);
+            data.resize(stream.gcount());
+            stream.clear();
+            bool const at_eof = data.size() < size;
+
+            size_t const pos = std::visit(
+              [&]<typename format_t>(format_t) -> size_t
+              {
+                  if constexpr (std::same_as<format_t, fastq>)
+                  {
+                      return format_input_handler<fastq>::find_record_start(data, 1, at_eof);
+                  }
+                  else
+                  {
+                      for (size_t eol = data.find('\n'); eol != std::string::npos && eol + 1 < data.size();
+                           eol        = data.find('\n', eol + 1))
+                      {
+                          if (data[eol + 1] == '>' || data[eol + 1] == ';')
+                              return eol + 1;
+                      }
+                      return data.size();
+                  }
+              },
+              format);
+
+            if (pos < data.size())
+                return offset - 1 + pos;
+            if (at_eof)
+                return std::numeric_limits<uint64_t>::max();
+        }
+    }
+
+    //!\brief Seek to an offset and remember the beginning of the block that decompression starts at.
+    void shard_seek(uint64_t const offset)
+    {
+        if (stream.compression() == compression_format::none)
+        {
+            stream.seekg_primary(offset);
+        }
+        else
+        {
+            io::detail::seek_to_uncompressed_offset(stream, gzi, offset);
+            auto const [disk_offset, block_offset] = gzi->locate(offset);
+            decompression_start                    = {disk_offset, offset - block_offset};
+        }
+    }
+
+    //!\brief The offset of the next character or the maximum value at the end of the file.
+    uint64_t current_offset()
+    {
+        // this also moves to the next block of compressed files if the current one is exhausted
+        if (stream.rdbuf()->sgetc() == std::char_traits<char>::eof())
+            return std::numeric_limits<uint64_t>::max();
+
+        // positions of compressed streams are relative to the block that decompression started at
+        uint64_t const pos = stream.rdbuf()->pubseekoff(0, std::ios_base::cur, std::ios_base::in);
+        switch (stream.compression())
+        {
+            case compression_format::bgzf: // virtual offset
+                {
+                    uint64_t const disk_offset = decompression_start.first + (pos >> 16);
+                    auto           it =
+                      std::ranges::upper_bound(gzi->blocks, disk_offset, {}, [](auto const & p) { return p.first; });
+                    return std::prev(it)->second + (pos & 0xFFFF);
+                }
+            case compression_format::gz: // number of characters
+                return decompression_start.second + pos;
+            default:
+                return pos;
+        }
+    }
+
+    //!\brief Whether the next record begins before the end of the shard (always true if sharding is not used).
+    bool before_shard_end() { return options.shard.count <= 1 || current_offset() < shard_end; }
+    //!\}
+
+    /*!\brief Read `requested` bytes and parse them into the batch [helper of read_batch_parallel()].
+     * \returns Whether the end of the file was reached.
+     */
+    template <typename seq_t, typename qual_t>
+    bool read_parallel_chunk(record_batch<seq_t, qual_t> & batch, size_t const n_threads, size_t const requested)
+    {
+        using handler_t = format_input_handler<fastq>;
+        using raw_t     = record<std::string_view, std::string_view, std::string_view>;
+
+        /* read the data (behind the remainder of the previous call) */
+        size_t const remainder = parallel_buffer.size();
+        parallel_buffer.resize(remainder + requested);
+        stream.read(parallel_buffer.data() + remainder, requested);
+        parallel_buffer.resize(remainder + stream.gcount());
+        bool const             at_eof = parallel_buffer.size() < remainder + requested;
+        std::string_view const buffer = parallel_buffer;
+
+        /* find the parts */
+        std::vector<size_t> starts(n_threads + 1, buffer.size());
+        starts[0] = 0;
+        for (size_t i = 1; i < n_threads; ++i)
+        {
+            size_t const nominal = i * buffer.size() / n_threads;
+            starts[i]            = handler_t::find_record_start(buffer, std::max(starts[i - 1], nominal), at_eof);
+        }
+
+        /* parse the parts */
+        std::vector<record_batch<seq_t, qual_t>> part_batches(n_threads);
+        std::vector<seq::statistics>             part_stats(n_threads);
+        std::vector<size_t>                      ends(n_threads);
+        std::vector<std::exception_ptr>          exceptions(n_threads);
+
+        auto job = [&](size_t const i)
+        {
+            part_batches[i].clear();
+            part_stats[i].clear();
+            exceptions[i] = nullptr;
+            try
+            {
+                raw_t  raw;
+                size_t pos = starts[i];
+                while (pos < starts[i + 1])
+                {
+                    size_t const next =
+                      handler_t::parse_record_in_buffer(buffer, pos, at_eof, options.truncate_ids, raw);
+                    if (next == handler_t::npos)
+                        break;
+
+                    if (options.compute_statistics)
+                        part_stats[i].add(raw.seq, raw.qual);
+                    part_batches[i].push_back(raw);
+                    pos = next;
+                }
+                ends[i] = pos;
+            }
+            catch (...)
+            {
+                exceptions[i] = std::current_exception();
+            }
+        };
+
+        {
+            std::vector<std::jthread> threads;
+            threads.reserve(n_threads - 1);
+            for (size_t i = 1; i < n_threads; ++i)
+                threads.emplace_back(job, i);
+            job(0);
+        } // joins
+
+        /* validate and merge in order */
+        for (size_t i = 0; i < n_threads; ++i)
+        {
+            if (i > 0 && ends[i - 1] != starts[i])
+            { // the start of this part was not found correctly; parse it again
+                starts[i] = ends[i - 1];
+                job(i);
+            }
+
+            if (exceptions[i])
+                std::rethrow_exception(exceptions[i]);
+
+            for (size_t j = 0; j < part_batches[i].size(); ++j)
+                batch.push_back(part_batches[i][j]);
+            stats += part_stats[i];
+        }
+
+        /* keep the remainder */
+        parallel_buffer.erase(0, ends[n_threads - 1]);
+        if (at_eof)
+        {
+            if (std::ranges::any_of(parallel_buffer, [](char const c) { return !is_space(c); }))
+                throw parse_error{"[BioC++ FastQ format error] Reached end of file while trying to read record."};
+            parallel_buffer.clear();
+        }
+
+        return at_eof;
+    }
+
+    //!\brief Seek to the region and read its characters into #fetch_buffer.
+    std::string_view fetch_chars(genomic_region const & region)
+    {
+        return std::visit(
+          [&]<typename format_t>(format_t) -> std::string_view
+          {
+              if constexpr (std::same_as<format_t, fasta>)
+                  return fetch_chars_fasta(region);
+              else if constexpr (std::same_as<format_t, twobit>)
+                  return fetch_chars_twobit(region);
+              else
+                  throw bio_error{"Fetching subsequences is only supported for FastA and 2bit files."};
+          },
+          format);
+    }
+
+    //!\brief Read the characters of a region in a 2bit file into #fetch_buffer [helper of fetch_chars()].
+    std::string_view fetch_chars_twobit(genomic_region const & region)
+    {
+        using handler_t = format_input_handler<twobit>;
+
+        // the handler reads the index on construction; it already exists if records have been read
+        if (!std::holds_alternative<handler_t>(format_handler))
+            format_handler.template emplace<handler_t>(stream, options);
+
+        // the stream is no longer at a record boundary
+        init_state = false;
+        at_end     = true;
+
+        std::get<handler_t>(format_handler)
+          .fetch(region,
+                 fetch_buffer,
+                 [&](uint64_t const offset) { io::detail::seek_to_uncompressed_offset(stream, gzi, offset); });
+        return fetch_buffer;
+    }
+
+    //!\brief Read the characters of a region in a FastA file into #fetch_buffer [helper of fetch_chars()].
+    std::string_view fetch_chars_fasta(genomic_region const & region)
+    {
+        if (!fai.has_value())
+        {
+            if (stream.filename().empty())
+                throw bio_error{"Fetching subsequences from streams requires setting a FAI index."};
+
+            std::filesystem::path fai_file = stream.filename();
+            fai_file += ".fai";
+            if (std::filesystem::exists(fai_file))
+                fai.emplace().read(fai_file);
+            else
+                fai = fai_index::build(stream.filename(), options.stream_options);
+        }
+
+        fai_index::entry_t const * entry = fai->find(region.chrom);
+        if (entry == nullptr)
+            throw bio_error{"The sequence \"", region.chrom, "\" is not contained in the FAI index."};
+
+        uint64_t const beg = std::clamp<int64_t>(region.beg, 0, entry->length);
+        uint64_t const end = std::clamp<int64_t>(region.end, beg, entry->length);
+
+        // the stream is no longer at a record boundary
+        init_state = false;
+        at_end     = true;
+
+        fetch_buffer.resize(end - beg);
+        if (end == beg)
+            return fetch_buffer;
+
+        // copy the bases line-wise, skipping the line-endings
+        auto copy_bases = [&](auto && read_n_chars_into, auto && skip_n)
+        {
+            char *   out  = fetch_buffer.data();
+            uint64_t todo = end - beg;
+            uint64_t col  = beg % entry->linebases;
+            while (true)
+            {
+                uint64_t const n = std::min(todo, entry->linebases - col);
+                read_n_chars_into(n, out);
+                out += n;
+                todo -= n;
+
+                if (todo == 0)
+                    break;
+
+                skip_n(entry->linewidth - entry->linebases);
+                col = 0;
+            }
+        };
+
+        uint64_t offset = entry->offset_of(beg);
+#ifdef BIOCPP_IO_HAS_ZLIB
+        // decompress only the blocks that contain the region instead of re-creating the decompression stream
+        if (stream.compression() == compression_format::bgzf || stream.compression() == compression_format::gz)
+        {
+            io::detail::load_gzi_index(stream, gzi);
+            if (!bgzf_blocks.has_value())
+                bgzf_blocks.emplace(stream.filename());
+
+            copy_bases(
+              [&](uint64_t const n, char * const out)
+              {
+                  bgzf_blocks->read(*gzi, offset, n, out);
+                  offset += n;
+              },
+              [&](uint64_t const n) { offset += n; });
+            return fetch_buffer;
+        }
+#endif
+
+        io::detail::seek_to_uncompressed_offset(stream, gzi, offset);
+        io::detail::fast_istreambuf_iterator<char> it{stream};
+        copy_bases([&](uint64_t const n, char * const out) { it.read_n_chars_into(n, out); },
+                   [&](uint64_t const n) { it.skip_n(n); });
+
+        return fetch_buffer;
+    }
+
+    using base_t::at_end;
+    using base_t::format;
+    using base_t::format_handler;
+    using base_t::init_state;
+    using base_t::options;
+    using base_t::record_buffer;
+    using base_t::stream;
+
+    //!\brief The FAI index (used for fetching subsequences).
+    std::optional<fai_index>             fai;
+    //!\brief GZI index (used for fetching subsequences and for sharding in BGZF files).
+    std::optional<io::detail::gzi_index> gzi;
+    //!\brief The offset at which the shard ends; records that begin here or behind are not read.
+    uint64_t                             shard_end = std::numeric_limits<uint64_t>::max();
+    //!\brief The (compressed, uncompressed) offset of the block that decompression started at (for sharding).
+    std::pair<uint64_t, uint64_t>        decompression_start{};
+    //!\brief Buffer for fetched subsequences.
+    std::string                          fetch_buffer;
+    //!\brief Data read by read_batch_parallel() that has not been parsed (an incomplete record).
+    std::string                          parallel_buffer;
+    //!\brief Whether read_batch_parallel() has been called since the last (re-)initialisation.
+    bool                                 parallel_mode = false;
+    //!\brief The statistics (see bio::io::seq::reader_options::compute_statistics).
+    seq::statistics                      stats;
+#ifdef BIOCPP_IO_HAS_ZLIB
+    //!\brief Decompresses single blocks of BGZF files (used for fetching subsequences).
+    std::optional<io::detail::bgzf_block_reader> bgzf_blocks;
+#endif
 };
 
 } // namespace bio::io::seq
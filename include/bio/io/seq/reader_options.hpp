@@ -13,6 +13,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -29,6 +30,8 @@
 #include <bio/io/detail/range.hpp>
 #include <bio/io/format/fasta.hpp>
 #include <bio/io/format/fastq.hpp>
+#include <bio/io/format/twobit.hpp>
+#include <bio/io/format/ubam.hpp>
 #include <bio/io/misc.hpp>
 #include <bio/io/seq/record.hpp>
 #include <bio/io/stream/transparent_istream.hpp>
@@ -36,6 +39,17 @@
 namespace bio::io::seq
 {
 
+/*!\brief Selects one of several parts of a file, see bio::io::seq::reader_options::shard.
+ * \ingroup seq
+ */
+struct shard_spec
+{
+    //!\brief The 0-based index of the part; must be smaller than #count.
+    size_t index = 0;
+    //!\brief The number of parts; 1 means that the whole file is read.
+    size_t count = 1;
+};
+
 /*!\brief Options that can be used to configure the behaviour of bio::io::seq::reader.
  * \ingroup seq
  * \tparam record_t      Type of the record member (usually deduced).
@@ -78,16 +92,42 @@ namespace bio::io::seq
  *
  * \snippet test/snippet/seq/seq_reader_options.cpp example_advanced
  */
-template <typename record_t = record_dna_shallow, typename formats_t = meta::type_list<fasta, fastq>>
+template <typename record_t = record_dna_shallow, typename formats_t = meta::type_list<fasta, fastq, twobit, ubam>>
 struct reader_options
 {
+    /*!\brief Compute the mean and minimum quality of every record.
+     * \details
+     *
+     * The statistics are computed in the same pass that validates the qualities; they can be retrieved via
+     * bio::io::seq::reader::current_qual_stats(). Only relevant for FastQ.
+     */
+    bool compute_qual_stats = false;
+
+    /*!\brief Accumulate statistics over all records (read lengths, base composition, quality profile).
+     * \details
+     *
+     * The statistics are computed from the characters of the file while the records are parsed; they can be
+     * retrieved via bio::io::seq::reader::statistics(). See bio::io::seq::statistics for the available values.
+     * This is also supported by bio::io::seq::reader::read_batch_parallel().
+     */
+    bool compute_statistics = false;
+
     /*!\brief The formats that input files can take; a bio::meta::ttag over the types.
      *
      * \details
      *
      * See bio::io::seq::reader for an overview of the the supported formats.
      */
-    formats_t formats = meta::ttag<fasta, fastq>;
+    formats_t formats = meta::ttag<fasta, fastq, twobit, ubam>;
+
+    /*!\brief The ASCII offset of the qualities in the file.
+     * \details
+     *
+     * Set this to 64 for files with Phred+64 encoding (old Illumina pipelines). The qualities are converted to
+     * Phred+33 while reading, i.e. records always contain Phred+33 characters (or the respective quality alphabet).
+     * Qualities outside of `[qual_offset, '~']` result in a bio::io::parse_error. Only relevant for FastQ.
+     */
+    uint8_t qual_offset = 33;
 
     /*!\brief A record that can store the fields read from disk.
      * \details
@@ -96,6 +136,31 @@ struct reader_options
      */
     record_t record{};
 
+    /*!\brief Read only one of several parts of the file, e.g. `{.index = 3, .count = 64}`.
+     * \details
+     *
+     * The file is split into `count` parts of roughly equal size (on disk), and only the records of the part with
+     * the given index are read. Every record belongs to exactly one part, i.e. the union of all parts is the file.
+     * This allows processing a large file on multiple nodes of a cluster, where every node reads and decompresses
+     * only its part of the file.
+     *
+     * A record belongs to a part if it begins in the part. The boundaries between the parts are:
+     *
+     *   * for uncompressed files, `index * file_size / count`;
+     *   * for BGZF compressed files, the beginning of the first block at or behind `index * file_size / count`; the
+     *     GZI index is read from "FILENAME.gzi" if present or created from the block headers.
+     *
+     * When opening the file, the reader moves to the first record that begins at or behind the boundary. For FastA
+     * files, the record beginnings are located with the FAI index if "FILENAME.fai" exists; otherwise (and for
+     * FastQ) the data behind the boundary is searched for the next record; see
+     * bio::io::format_input_handler<bio::io::fastq>::find_record_start() for how this is done for FastQ.
+     *
+     * Only FastA and FastQ files that are opened via their file name and that are uncompressed or BGZF compressed
+     * are supported; other files result in a bio::io::bio_error when opening the file. This option cannot be
+     * combined with bio::io::seq::reader::read_batch_parallel().
+     */
+    shard_spec shard{};
+
     //!\brief Options that are passed on to the internal stream oject.
     transparent_istream_options stream_options{};
 
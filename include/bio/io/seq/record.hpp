@@ -13,6 +13,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <ranges>
 #include <string>
 #include <type_traits>
@@ -35,6 +36,7 @@
 #include <bio/io/format/fasta.hpp>
 #include <bio/io/format/fastq.hpp>
 #include <bio/io/misc.hpp>
+#include <bio/io/seq/packed_dna5_vector.hpp>
 #include <bio/io/stream/transparent_istream.hpp>
 
 namespace bio::io::seq
@@ -275,6 +277,11 @@ using record_dna_shallow = record<std::string_view,
                                   views::char_conversion_view_t<alphabet::dna5>,
                                   views::char_conversion_view_t<alphabet::phred42>>;
 
+//!\brief Record type that reads DNA sequences into two-bit packed storage (bio::io::seq::packed_dna5_vector)
+// and corresponding qualities ( bio::alphabet::phred42).
+//!\ingroup seq
+using record_dna_packed = record<std::string, packed_dna5_vector, std::vector<alphabet::phred42>>;
+
 //!\brief Record type that reads Protein sequences (bio::alphabet::aa27) and ignores qualities.
 //!\ingroup seq
 using record_protein_deep = record<std::string, std::vector<alphabet::aa27>, meta::ignore_t>;
@@ -285,6 +292,21 @@ using record_protein_shallow = record<std::string_view, views::char_conversion_v
 
 //!\}
 
+/*!\brief Mean and minimum Phred score of a record's qualities.
+ * \ingroup seq
+ * \details
+ *
+ * See bio::io::seq::reader_options::compute_qual_stats and bio::io::seq::reader::current_qual_stats().
+ * Both members are 0 if the record has no qualities.
+ */
+struct qual_stats
+{
+    //!\brief The mean Phred score.
+    double  mean = 0;
+    //!\brief The smallest Phred score.
+    uint8_t min  = 0;
+};
+
 } // namespace bio::io::seq
 
 //-----------------------------------------------------------------------------
@@ -305,7 +327,9 @@ constexpr bool record_read_concept_checker(std::type_identity<seq::record<id_t,
     static_assert(io::detail::lazy_concept_checker([]<typename t = seq_t>(auto) requires(
                     meta::one_of<t, std::string_view, meta::ignore_t, meta::ignore_t const> ||
                     (ranges::back_insertable<t> && alphabet::alphabet<std::ranges::range_reference_t<t>>) ||
-                    io::detail::transform_view_on_string_view<t>) { return std::true_type{}; }),
+                    io::detail::bulk_char_convertible<t> || io::detail::transform_view_on_string_view<t>) {
+                      return std::true_type{};
+                  }),
                   "Requirements for the type of the SEQ-field not met. See documentation for bio::io::seq::record.");
     static_assert(io::detail::lazy_concept_checker([]<typename t = qual_t>(auto) requires(
                     meta::one_of<t, std::string_view, meta::ignore_t, meta::ignore_t const> ||
@@ -0,0 +1,115 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2022, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2022, Knut Reinert & MPI für molekulare Genetik
+// Copyright (c) 2020-2022, deCODE Genetics
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/bio/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides bio::io::seq::record_batch.
+ * \author Hannes Hauswedell <hannes.hauswedell AT decode.is>
+ */
+
+#pragma once
+
+#include <ranges>
+#include <string>
+#include <type_traits>
+
+#include <bio/alphabet/concept.hpp>
+#include <bio/ranges/container/concatenated_sequences.hpp>
+#include <bio/ranges/views/char_strictly_to.hpp>
+#include <bio/ranges/views/to_char.hpp>
+
+#include <bio/io/seq/record.hpp>
+
+namespace bio::io::seq
+{
+
+/*!\brief A batch of sequence records stored as a structure of arrays.
+ * \ingroup seq
+ * \tparam seq_t  The type of a single sequence, e.g. std::string or std::vector<bio::alphabet::dna5>.
+ * \tparam qual_t The type of a single quality string, e.g. std::string or std::vector<bio::alphabet::phred42>.
+ * \details
+ *
+ * The IDs, sequences and qualities of all records are stored in three bio::ranges::concatenated_sequences, i.e.
+ * each field of all records is stored contiguously in memory (plus a vector of offsets). Clearing the batch
+ * does not free the memory, so a batch that is reused via bio::io::seq::reader::read_batch() does not allocate
+ * once it has reached its final size.
+ *
+ * The i-th record can be accessed via `operator[]`; it returns a bio::io::seq::record of views into the batch.
+ * Qualities are empty for formats that do not have them (e.g. FastA).
+ */
+template <typename seq_t = std::string, typename qual_t = std::string>
+struct record_batch
+{
+    //!\brief The IDs.
+    ranges::concatenated_sequences<std::string> ids;
+    //!\brief The sequences.
+    ranges::concatenated_sequences<seq_t>       seqs;
+    //!\brief The qualities.
+    ranges::concatenated_sequences<qual_t>      quals;
+
+    //!\brief The type returned by operator[].
+    using const_reference = record<typename ranges::concatenated_sequences<std::string>::const_reference,
+                                   typename ranges::concatenated_sequences<seq_t>::const_reference,
+                                   typename ranges::concatenated_sequences<qual_t>::const_reference>;
+
+    //!\brief The number of records.
+    size_t size() const noexcept { return ids.size(); }
+    //!\brief Whether the batch is empty.
+    bool   empty() const noexcept { return ids.empty(); }
+
+    //!\brief Remove all records (keeps the memory).
+    void clear() noexcept
+    {
+        ids.clear();
+        seqs.clear();
+        quals.clear();
+    }
+
+    //!\brief Return the i-th record as a record of views.
+    const_reference operator[](size_t const i) const { return const_reference{ids[i], seqs[i], quals[i]}; }
+
+    /*!\brief Append a record.
+     * \param[in] rec The record; its fields are converted to the alphabets of the batch if necessary.
+     * \throws bio::alphabet::invalid_char_assignment If characters need to be converted and are invalid.
+     */
+    template <typename... field_ts>
+    void push_back(record<field_ts...> const & rec)
+    {
+        append_field(ids, rec.id);
+        append_field(seqs, rec.seq);
+        append_field(quals, rec.qual);
+    }
+
+private:
+    //!\brief Append a field, converting from/to characters if necessary.
+    template <typename inner_t, typename field_t>
+    static void append_field(ranges::concatenated_sequences<inner_t> & out, field_t const & field)
+    {
+        using out_alph_t = std::ranges::range_value_t<inner_t>;
+
+        if constexpr (std::same_as<std::remove_cvref_t<field_t>, meta::ignore_t>)
+        {
+            out.push_back();
+        }
+        else
+        {
+            using in_alph_t = std::remove_cvref_t<std::ranges::range_reference_t<field_t const>>;
+
+            if constexpr (std::same_as<in_alph_t, out_alph_t>)
+                out.push_back(field);
+            else if constexpr (std::same_as<in_alph_t, char>)
+                out.push_back(field | views::char_strictly_to<out_alph_t>);
+            else if constexpr (std::same_as<out_alph_t, char>)
+                out.push_back(field | views::to_char);
+            else
+                static_assert(std::same_as<in_alph_t, out_alph_t>,
+                              "The field of the record cannot be converted to the type of the batch.");
+        }
+    }
+};
+
+} // namespace bio::io::seq
@@ -0,0 +1,479 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2022, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2022, Knut Reinert & MPI für molekulare Genetik
+// Copyright (c) 2020-2022, deCODE Genetics
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/bio/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides bio::io::seq::sort_records() and bio::io::seq::sort_options.
+ * \author Hannes Hauswedell <hannes.hauswedell AT decode.is>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <bio/alphabet/custom/char.hpp> // the records are written as characters
+
+#include <bio/io/exception.hpp>
+#include <bio/io/seq/reader.hpp>
+#include <bio/io/seq/record_batch.hpp>
+#include <bio/io/seq/writer.hpp>
+#include <bio/io/stream/detail/fast_streambuf_iterator.hpp>
+#include <bio/io/stream/transparent_istream.hpp>
+#include <bio/io/stream/transparent_ostream.hpp>
+
+namespace bio::io::seq
+{
+
+//!\brief The key by which bio::io::seq::sort_records() sorts.
+//!\ingroup seq
+enum class sort_key
+{
+    id, //!< Sort by ID (byte-wise), e.g. to bring the mates of pairs together.
+    seq //!< Sort by sequence (byte-wise), e.g. to improve compression or to find duplicate reads.
+};
+
+/*!\brief Options for bio::io::seq::sort_records().
+ * \ingroup seq
+ * \details
+ *
+ * Please be aware that those options that you modify need to be set in the correct order -- **which is
+ * alphabetical order** for all option classes in this library.
+ */
+struct sort_options
+{
+    /*!\brief Write only the first of all records with the same key.
+     * \details
+     *
+     * Since sorting is stable, this is the record that occurs first in the input.
+     */
+    bool collapse_duplicates = false;
+
+    //!\brief The key by which the records are sorted.
+    sort_key key = sort_key::id;
+
+    /*!\brief The (approximate) maximum number of bytes used for holding records in memory.
+     * \details
+     *
+     * Records are read until their characters and the bookkeeping data (32 bytes per record) exceed this value.
+     * If the input is larger, the sorted runs are written to temporary files and merged afterwards. The
+     * buffers for reading the temporary files during the merge (up to 64 files with 320KiB each) are not included.
+     */
+    size_t memory = 1ull << 30;
+
+    /*!\brief The number of threads used for sorting the runs and for compressing the temporary files.
+     * \details
+     *
+     * The temporary files are BGZF compressed, which requires at least two threads; if this value is 1, one extra
+     * compression thread is spawned.
+     */
+    size_t threads = std::max<size_t>(1, std::min<size_t>(8, std::thread::hardware_concurrency()));
+
+    /*!\brief The directory in which the temporary files are created.
+     * \details
+     *
+     * Defaults to std::filesystem::temp_directory_path(). A new sub-directory is created and removed afterwards.
+     */
+    std::filesystem::path tmp_dir{};
+};
+
+} // namespace bio::io::seq
+
+namespace bio::io::seq::detail
+{
+
+/*!\brief Implementation of bio::io::seq::sort_records().
+ * \ingroup seq
+ * \details
+ *
+ * Records are collected in a bio::io::seq::record_batch until the memory budget is exhausted. The batch is sorted
+ * via a permutation (the records themselves are not moved): every thread sorts a contiguous part, and the parts
+ * are merged pairwise, also in parallel. Sorted runs are written to BGZF compressed temporary files in a simple
+ * binary layout (three 32bit lengths followed by the characters of ID, sequence and qualities), so they are read
+ * back without parsing. Finally, all runs are merged via a heap; if there are more than 64 runs, groups of runs
+ * are first merged into new runs, so the number of open files is bounded.
+ */
+class external_sorter
+{
+public:
+    //!\brief Constructor.
+    explicit external_sorter(sort_options const & opt) : options{opt} {}
+
+    //!\brief Remove the temporary files.
+    ~external_sorter()
+    {
+        if (!run_dir.empty())
+        {
+            std::error_code ec; // ignore errors in the destructor
+            std::filesystem::remove_all(run_dir, ec);
+        }
+    }
+
+    //!\brief Sort the records of the reader and write them to the writer.
+    uint64_t operator()(auto & in, auto & out)
+    {
+        for (auto & rec : in)
+        {
+            batch.push_back(rec);
+            if (batch_bytes() >= options.memory)
+                write_run();
+        }
+
+        if (n_runs == 0) // everything fits into memory
+        {
+            sort_batch();
+            uint64_t n_written = 0;
+            for_each_sorted(
+              [&](std::string_view const id, std::string_view const seq, std::string_view const qual)
+              {
+                  out.emplace_back(id, seq, qual);
+                  ++n_written;
+              });
+            return n_written;
+        }
+
+        if (!batch.empty())
+            write_run();
+        return merge_runs(out);
+    }
+
+private:
+    //!\brief Bookkeeping bytes per record: three delimiters in the batch and one element of the permutation.
+    static constexpr size_t overhead_per_record = 4 * sizeof(size_t);
+    //!\brief The maximum number of temporary files that are read at the same time.
+    static constexpr size_t max_fan_in          = 64;
+
+    //!\brief The options.
+    sort_options              options;
+    //!\brief The records that have been read but not sorted.
+    record_batch<std::string> batch;
+    //!\brief The sorted permutation of #batch.
+    std::vector<size_t>       order;
+    //!\brief The directory of the temporary files (empty until the first run is written).
+    std::filesystem::path     run_dir;
+    //!\brief The number of runs written.
+    size_t                    n_runs = 0;
+
+    //!\brief The approximate memory usage of #batch and #order.
+    size_t batch_bytes() const noexcept
+    {
+        return batch.ids.concat_size() + batch.seqs.concat_size() + batch.quals.concat_size() +
+               batch.size() * overhead_per_record;
+    }
+
+    //!\brief Convert an element of a batch to std::string_view.
+    static std::string_view to_view(auto const & chars) { return {chars.data(), chars.size()}; }
+
+    //!\brief The key of the i-th record of the batch.
+    std::string_view key_of(size_t const i) const
+    {
+        return options.key == sort_key::id ? to_view(batch.ids[i]) : to_view(batch.seqs[i]);
+    }
+
+    //!\brief Sort #order; every thread sorts a part, and the parts are merged pairwise.
+    void sort_batch()
+    {
+        order.resize(batch.size());
+        std::iota(order.begin(), order.end(), 0);
+
+        auto less = [this](size_t const lhs, size_t const rhs) { return key_of(lhs) < key_of(rhs); };
+
+        // small inputs are not worth spawning threads
+        size_t const n_parts = std::clamp<size_t>(order.size() / 4096, 1, std::max<size_t>(options.threads, 1));
+
+        std::vector<size_t> bounds(n_parts + 1);
+        for (size_t i = 0; i <= n_parts; ++i)
+            bounds[i] = i * order.size() / n_parts;
+        auto at = [&](size_t const part) { return order.begin() + bounds[std::min(part, n_parts)]; };
+
+        {
+            std::vector<std::jthread> threads;
+            for (size_t i = 1; i < n_parts; ++i)
+                threads.emplace_back([&, i]() { std::stable_sort(at(i), at(i + 1), less); });
+            std::stable_sort(at(0), at(1), less);
+        } // joins
+
+        for (size_t width = 1; width < n_parts; width *= 2)
+        {
+            std::vector<std::jthread> threads;
+            for (size_t i = 2 * width; i < n_parts; i += 2 * width)
+                threads.emplace_back([&, i]() { std::inplace_merge(at(i), at(i + width), at(i + 2 * width), less); });
+            std::inplace_merge(at(0), at(width), at(2 * width), less);
+        } // joins
+    }
+
+    //!\brief Call `fn(id, seq, qual)` for the records of the batch in sorted order (and without duplicates).
+    void for_each_sorted(auto && fn) const
+    {
+        for (size_t j = 0; j < order.size(); ++j)
+        {
+            size_t const i = order[j];
+            if (options.collapse_duplicates && j > 0 && key_of(i) == key_of(order[j - 1]))
+                continue;
+            fn(to_view(batch.ids[i]), to_view(batch.seqs[i]), to_view(batch.quals[i]));
+        }
+    }
+
+    //!\brief The path of a temporary file.
+    std::filesystem::path run_path(size_t const run) const { return run_dir / ("run" + std::to_string(run) + ".gz"); }
+
+    //!\brief Create a new directory for the temporary files.
+    void create_run_dir()
+    {
+        std::filesystem::path const base =
+          options.tmp_dir.empty() ? std::filesystem::temp_directory_path() : options.tmp_dir;
+
+        std::random_device rd;
+        std::error_code    ec;
+        for (size_t i = 0; i < 100 && !ec; ++i)
+        {
+            std::filesystem::path const dir = base / ("bio_sort_" + std::to_string(rd()));
+            if (std::filesystem::create_directory(dir, ec))
+            {
+                run_dir = dir;
+                return;
+            }
+        }
+        throw file_open_error{"Could not create a temporary directory in ", base.string(), ": ", ec.message()};
+    }
+
+    //!\brief Open a temporary file for writing.
+    transparent_ostream open_run(size_t const run) const
+    {
+        return transparent_ostream{run_path(run),
+                                   {.compression       = compression_format::bgzf,
+                                    .compression_level = 1,
+                                    .threads           = std::max<size_t>(options.threads, 2)}};
+    }
+
+    //!\brief Write a record to a temporary file.
+    static void write_record(io::detail::fast_ostreambuf_iterator<char> & it,
+                             std::string_view const                     id,
+                             std::string_view const                     seq,
+                             std::string_view const                     qual)
+    {
+        for (std::string_view const field : {id, seq, qual})
+        {
+            if (field.size() > std::numeric_limits<uint32_t>::max())
+                throw bio_error{"Records with fields longer than 4GiB cannot be sorted."};
+            it.write_as_binary(static_cast<uint32_t>(field.size()));
+        }
+        it.write_range(id);
+        it.write_range(seq);
+        it.write_range(qual);
+    }
+
+    //!\brief Sort the batch and write it to a temporary file.
+    void write_run()
+    {
+        if (run_dir.empty())
+            create_run_dir();
+
+        sort_batch();
+
+        {
+            transparent_ostream                        stream = open_run(n_runs);
+            io::detail::fast_ostreambuf_iterator<char> it{stream};
+            for_each_sorted([&](std::string_view const id, std::string_view const seq, std::string_view const qual)
+                            { write_record(it, id, seq, qual); });
+        }
+
+        ++n_runs;
+        batch.clear();
+        order.clear();
+    }
+
+    //!\brief A temporary file that is being read.
+    struct run_cursor
+    {
+        //!\brief The stream.
+        transparent_istream stream;
+        //!\brief The ID of the current record.
+        std::string         id{};
+        //!\brief The sequence of the current record.
+        std::string         seq{};
+        //!\brief The qualities of the current record.
+        std::string         qual{};
+
+        //!\brief Read the next record; returns false at the end of the file.
+        bool next()
+        {
+            if (std::istreambuf_iterator<char>{stream} == std::istreambuf_iterator<char>{})
+                return false;
+
+            io::detail::fast_istreambuf_iterator<char> it{stream};
+            uint32_t                                   sizes[3]{};
+            for (uint32_t & size : sizes)
+                it.read_as_binary(size);
+
+            id.resize(sizes[0]);
+            seq.resize(sizes[1]);
+            qual.resize(sizes[2]);
+            it.read_n_chars_into(sizes[0], id.data());
+            it.read_n_chars_into(sizes[1], seq.data());
+            it.read_n_chars_into(sizes[2], qual.data());
+            return true;
+        }
+    };
+
+    /*!\brief Merge the given temporary files and call `fn(id, seq, qual)` for every record (without duplicates).
+     * \details
+     *
+     * The runs need to be given in input order, so that ties can be resolved by the position in `run_ids`.
+     */
+    void merge(std::span<size_t const> const run_ids, auto && fn) const
+    {
+        std::vector<run_cursor> runs;
+        runs.reserve(run_ids.size());
+        for (size_t const run : run_ids)
+        {
+            runs.push_back(run_cursor{
+              transparent_istream{run_path(run), {.buffer1_size = 1ull << 16, .buffer2_size = 1ull << 18, .threads = 1}}
+            });
+        }
+
+        auto key = [&](size_t const r) -> std::string_view
+        { return options.key == sort_key::id ? runs[r].id : runs[r].seq; };
+
+        // min-heap; ties are resolved by the number of the run, so the merge is stable
+        auto greater = [&](size_t const lhs, size_t const rhs)
+        {
+            std::string_view const l = key(lhs);
+            std::string_view const r = key(rhs);
+            return l > r || (l == r && lhs > rhs);
+        };
+
+        std::vector<size_t> heap;
+        for (size_t r = 0; r < runs.size(); ++r)
+            if (runs[r].next())
+                heap.push_back(r);
+        std::ranges::make_heap(heap, greater);
+
+        std::string previous_key;
+        bool        first = true;
+        while (!heap.empty())
+        {
+            std::ranges::pop_heap(heap, greater);
+            size_t const r = heap.back();
+
+            if (!options.collapse_duplicates || first || key(r) != previous_key)
+            {
+                fn(runs[r].id, runs[r].seq, runs[r].qual);
+                if (options.collapse_duplicates)
+                    previous_key = key(r);
+                first = false;
+            }
+
+            if (runs[r].next())
+                std::ranges::push_heap(heap, greater);
+            else
+                heap.pop_back();
+        }
+    }
+
+    //!\brief Merge the temporary files into the writer; more than #max_fan_in runs are merged in multiple passes.
+    uint64_t merge_runs(auto & out)
+    {
+        std::vector<size_t> run_ids(n_runs);
+        std::iota(run_ids.begin(), run_ids.end(), 0);
+
+        while (run_ids.size() > max_fan_in)
+        {
+            // consecutive groups are merged into new runs, so the input order is retained
+            std::vector<size_t> merged_ids;
+            for (size_t i = 0; i < run_ids.size(); i += max_fan_in)
+            {
+                std::span<size_t const> const group{run_ids.data() + i, std::min(max_fan_in, run_ids.size() - i)};
+
+                {
+                    transparent_ostream                        stream = open_run(n_runs);
+                    io::detail::fast_ostreambuf_iterator<char> it{stream};
+                    merge(group,
+                          [&](std::string_view const id, std::string_view const seq, std::string_view const qual)
+                          { write_record(it, id, seq, qual); });
+                }
+
+                for (size_t const run : group)
+                    std::filesystem::remove(run_path(run));
+                merged_ids.push_back(n_runs++);
+            }
+            run_ids = std::move(merged_ids);
+        }
+
+        uint64_t n_written = 0;
+        merge(run_ids,
+              [&](std::string_view const id, std::string_view const seq, std::string_view const qual)
+              {
+                  out.emplace_back(id, seq, qual);
+                  ++n_written;
+              });
+        return n_written;
+    }
+};
+
+} // namespace bio::io::seq::detail
+
+namespace bio::io::seq
+{
+
+/*!\brief Sort the records of a reader (in external memory) and write them to a writer.
+ * \ingroup seq
+ * \param[in,out] in The reader; records are read from the current one to the end of the file.
+ * \param[in,out] out The writer.
+ * \param[in] options The options, see bio::io::seq::sort_options.
+ * \returns The number of records written.
+ * \throws bio::io::file_open_error If the temporary files cannot be created.
+ * \details
+ *
+ * The records are sorted by ID or by sequence (byte-wise); sorting is stable. The memory used for the records is
+ * bounded by bio::io::seq::sort_options::memory:
+ *
+ *   1. Records are read into a bio::io::seq::record_batch until the memory budget is exhausted.
+ *   2. The batch is sorted on bio::io::seq::sort_options::threads threads and written to a BGZF compressed
+ *      temporary file (a *run*).
+ *   3. After the input is exhausted, the runs are merged and written to the writer. At most 64 runs are merged at
+ *      a time; larger numbers are reduced by intermediate merge passes.
+ *
+ * If all records fit into memory, no temporary files are created. The temporary files have a simple binary layout
+ * and are read back without parsing; they are removed afterwards (also if an exception is thrown).
+ *
+ * Records are converted to characters when they are stored in the batch, i.e. the reader's record type can be
+ * chosen freely; use e.g. bio::io::seq::record_char_shallow to avoid converting the sequences to an alphabet and back.
+ *
+ * ### Example
+ *
+ * ```cpp
+ * bio::io::seq::reader reader{"reads.fastq.gz",
+ *                             bio::io::seq::reader_options{.record = bio::io::seq::record_char_shallow{}}};
+ * bio::io::seq::writer writer{"sorted.fastq.gz"};
+ *
+ * bio::io::seq::sort_records(reader,
+ *                            writer,
+ *                            bio::io::seq::sort_options{.collapse_duplicates = true,
+ *                                                       .key                 = bio::io::seq::sort_key::seq,
+ *                                                       .memory              = 16ull << 30});
+ * ```
+ */
+template <typename... reader_args_t, typename... writer_args_t>
+uint64_t sort_records(reader<reader_args_t...> & in, writer<writer_args_t...> & out, sort_options const & options = {})
+{
+    return detail::external_sorter{options}(in, out);
+}
+
+} // namespace bio::io::seq
@@ -0,0 +1,187 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2022, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2022, Knut Reinert & MPI für molekulare Genetik
+// Copyright (c) 2020-2022, deCODE Genetics
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/bio/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides bio::io::seq::statistics.
+ * \author Hannes Hauswedell <hannes.hauswedell AT decode.is>
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace bio::io::seq
+{
+
+/*!\brief Summary statistics over the sequences and qualities of many records (read lengths, base composition,
+ * quality profile).
+ * \ingroup seq
+ * \details
+ *
+ * Records are added via add(); partial results, e.g. of different threads or files, are merged via operator+=().
+ * The reader accumulates the statistics while parsing if bio::io::seq::reader_options::compute_statistics is set,
+ * see bio::io::seq::reader::statistics().
+ *
+ * Per record, add() performs one table lookup and one increment per base, and one addition per quality. All
+ * derived values (base counts, GC content, mean qualities) are computed from the per-position data on request.
+ *
+ * Bases are counted case-insensitively as `A`, `C`, `G`, `T` (or `U`) and "other", which contains `N` and all
+ * other characters. Qualities are expected as Phred+33 characters; records without qualities only contribute to
+ * the sequence statistics.
+ */
+struct statistics
+{
+    //!\brief The indexes of the base counts in #position_base_counts and base_counts().
+    enum base : uint8_t
+    {
+        A,    //!< `A` and `a`.
+        C,    //!< `C` and `c`.
+        G,    //!< `G` and `g`.
+        T,    //!< `T`, `t`, `U` and `u`.
+        other //!< `N` and all other characters.
+    };
+
+    //!\brief The number of records.
+    uint64_t                             n_records = 0;
+    //!\brief The number of records with a given sequence length (the index).
+    std::vector<uint64_t>                length_histogram;
+    //!\brief The base counts at every position of the sequences (see bio::io::seq::statistics::base).
+    std::vector<std::array<uint64_t, 5>> position_base_counts;
+    //!\brief The number of records with a given number of qualities (the index).
+    std::vector<uint64_t>                qual_length_histogram;
+    //!\brief The sum of Phred scores at every position.
+    std::vector<uint64_t>                position_qual_sums;
+
+    /*!\brief Add the sequence and the qualities of a record.
+     * \param[in] seq The sequence (as characters).
+     * \param[in] qual The qualities (as Phred+33 characters); may be empty.
+     */
+    void add(std::string_view const seq, std::string_view const qual)
+    {
+        ++n_records;
+
+        grow(length_histogram, seq.size() + 1);
+        ++length_histogram[seq.size()];
+
+        grow(position_base_counts, seq.size());
+        std::array<uint64_t, 5> * counts = position_base_counts.data();
+        for (size_t i = 0; i < seq.size(); ++i)
+            ++counts[i][char_to_base[static_cast<uint8_t>(seq[i])]];
+
+        if (qual.empty())
+            return;
+
+        grow(qual_length_histogram, qual.size() + 1);
+        ++qual_length_histogram[qual.size()];
+
+        grow(position_qual_sums, qual.size());
+        uint64_t * sums = position_qual_sums.data();
+        for (size_t i = 0; i < qual.size(); ++i)
+            sums[i] += static_cast<uint8_t>(qual[i]) - uint8_t{'!'};
+    }
+
+    //!\brief Merge the statistics of other records into these.
+    statistics & operator+=(statistics const & other)
+    {
+        n_records += other.n_records;
+        merge(length_histogram, other.length_histogram);
+        merge(qual_length_histogram, other.qual_length_histogram);
+        merge(position_qual_sums, other.position_qual_sums);
+
+        grow(position_base_counts, other.position_base_counts.size());
+        for (size_t i = 0; i < other.position_base_counts.size(); ++i)
+            for (size_t j = 0; j < 5; ++j)
+                position_base_counts[i][j] += other.position_base_counts[i][j];
+        return *this;
+    }
+
+    //!\brief Remove all data.
+    void clear() { *this = statistics{}; }
+
+    //!\brief Compare all data.
+    friend bool operator==(statistics const &, statistics const &) = default;
+
+    /*!\name Derived values
+     * \{
+     */
+    //!\brief The total number of bases.
+    uint64_t n_bases() const noexcept
+    {
+        uint64_t ret = 0;
+        for (size_t i = 0; i < length_histogram.size(); ++i)
+            ret += i * length_histogram[i];
+        return ret;
+    }
+
+    //!\brief The total count of every base (see bio::io::seq::statistics::base).
+    std::array<uint64_t, 5> base_counts() const noexcept
+    {
+        std::array<uint64_t, 5> ret{};
+        for (std::array<uint64_t, 5> const & counts : position_base_counts)
+            for (size_t j = 0; j < 5; ++j)
+                ret[j] += counts[j];
+        return ret;
+    }
+
+    //!\brief The fraction of `G` and `C` among `A`, `C`, `G` and `T`; 0 if there are none.
+    double gc_content() const noexcept
+    {
+        std::array<uint64_t, 5> const counts = base_counts();
+        uint64_t const                acgt   = counts[A] + counts[C] + counts[G] + counts[T];
+        return acgt == 0 ? 0 : static_cast<double>(counts[C] + counts[G]) / acgt;
+    }
+
+    //!\brief The mean Phred score at every position.
+    std::vector<double> mean_qual_per_position() const
+    {
+        std::vector<double> ret(position_qual_sums.size());
+        uint64_t            n = 0; // number of records with a quality at the position
+        for (size_t i = ret.size(); i > 0; --i)
+        {
+            n += qual_length_histogram[i];
+            ret[i - 1] = static_cast<double>(position_qual_sums[i - 1]) / n;
+        }
+        return ret;
+    }
+    //!\}
+
+private:
+    //!\brief Maps characters to bio::io::seq::statistics::base.
+    static constexpr std::array<uint8_t, 256> char_to_base = []()
+    {
+        std::array<uint8_t, 256> ret{};
+        ret.fill(other);
+        for (auto [c, b] : {std::pair{'A', A}, {'C', C}, {'G', G}, {'T', T}, {'U', T}})
+        {
+            ret[static_cast<uint8_t>(c)]        = b;
+            ret[static_cast<uint8_t>(c | 0x20)] = b; // lower-case
+        }
+        return ret;
+    }();
+
+    //!\brief Resize the vector if it is smaller than `size`.
+    static void grow(auto & vec, size_t const size)
+    {
+        if (vec.size() < size)
+            vec.resize(size);
+    }
+
+    //!\brief Add the elements of `in` to those of `out`.
+    static void merge(std::vector<uint64_t> & out, std::vector<uint64_t> const & in)
+    {
+        grow(out, in.size());
+        for (size_t i = 0; i < in.size(); ++i)
+            out[i] += in[i];
+    }
+};
+
+} // namespace bio::io::seq
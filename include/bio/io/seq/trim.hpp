@@ -0,0 +1,474 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2022, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2022, Knut Reinert & MPI für molekulare Genetik
+// Copyright (c) 2020-2022, deCODE Genetics
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/bio/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides bio::io::seq::trimmer, bio::io::seq::trimmed_batch and bio::io::seq::trim_options.
+ * \author Hannes Hauswedell <hannes.hauswedell AT decode.is>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <bio/io/exception.hpp>
+#include <bio/io/seq/record.hpp>
+#include <bio/io/seq/record_batch.hpp>
+
+namespace bio::io::seq
+{
+
+/*!\brief Options for bio::io::seq::trimmer.
+ * \ingroup seq
+ * \details
+ *
+ * All trimming steps are disabled by default.
+ *
+ * Please be aware that those options that you modify need to be set in the correct order -- **which is
+ * alphabetical order** for all option classes in this library.
+ */
+struct trim_options
+{
+    //!\brief The maximum number of errors (substitutions and indels) per base of an adapter match.
+    double adapter_error_rate = 0.1;
+
+    //!\brief The minimum length of a partial adapter match at the end (3') or the beginning (5') of a read.
+    size_t adapter_min_overlap = 3;
+
+    /*!\brief Adapters ligated to the 3' end; the adapter and everything behind it are removed.
+     * \details
+     *
+     * An adapter is found anywhere in the read, or a prefix of it (of at least #adapter_min_overlap bases) at the
+     * end of the read. Only the first 64 bases of each adapter are used; `N` in an adapter matches every base.
+     */
+    std::vector<std::string> adapters_3p{};
+
+    /*!\brief Adapters ligated to the 5' end; the adapter and everything before it are removed.
+     * \details
+     *
+     * An adapter is found anywhere in the read, or a suffix of it (of at least #adapter_min_overlap bases) at the
+     * beginning of the read. Only the last 64 bases of each adapter are used; `N` in an adapter matches every base.
+     */
+    std::vector<std::string> adapters_5p{};
+
+    /*!\brief The minimum length of a poly-G tail that is clipped; 0 disables clipping.
+     * \details
+     *
+     * Poly-G tails are produced by two-colour sequencers (where `G` means "no signal"). One non-`G` base per 8 bases
+     * is tolerated, but the tail needs to begin with at least two `G`.
+     */
+    size_t poly_g_min_length = 0;
+
+    /*!\brief The mean Phred score below which a window of qualities is trimmed; 0 disables quality trimming.
+     * \details
+     *
+     * The windows of #qual_window bases are checked from the 5' end; the read is cut at the first window whose
+     * mean score is below this value (the leading bases of the window that reach the value are kept). Records
+     * without qualities are not quality trimmed.
+     */
+    uint8_t qual_cutoff = 0;
+
+    //!\brief The offset of the quality characters (33 for Sanger/Illumina 1.8+, 64 for old Illumina files).
+    uint8_t qual_offset = 33;
+
+    //!\brief The number of bases per window of quality trimming.
+    size_t qual_window = 4;
+
+    //!\brief The number of threads used for trimming a batch.
+    size_t threads = std::max<size_t>(1, std::min<size_t>(8, std::thread::hardware_concurrency()));
+};
+
+//!\brief The part of a record that is retained by trimming (0-based, half-open).
+//!\ingroup seq
+struct trim_interval
+{
+    size_t beg = 0; //!< The first retained position.
+    size_t end = 0; //!< The position behind the last retained position.
+
+    //!\brief Defaulted comparison.
+    friend bool operator==(trim_interval const &, trim_interval const &) = default;
+};
+
+/*!\brief The records of a bio::io::seq::record_batch with trimmed sequences and qualities (views into the batch).
+ * \ingroup seq
+ * \details
+ *
+ * Created by bio::io::seq::trimmer; the batch is not modified, and the records are returned as views into it. Can be
+ * passed to bio::io::seq::writer::push_back_batch() directly. The object remains valid until the batch is modified.
+ */
+class trimmed_batch
+{
+public:
+    //!\brief The type returned by operator[].
+    using const_reference = record<std::string_view, std::string_view, std::string_view>;
+
+    //!\brief The number of records.
+    size_t size() const noexcept { return intervals_.size(); }
+    //!\brief Whether there are no records.
+    bool   empty() const noexcept { return intervals_.empty(); }
+
+    //!\brief The retained part of every record.
+    std::vector<trim_interval> const & intervals() const noexcept { return intervals_; }
+
+    //!\brief Return the i-th record with trimmed sequence and qualities.
+    const_reference operator[](size_t const i) const
+    {
+        trim_interval const &  iv   = intervals_[i];
+        std::string_view const qual = to_view(batch->quals[i]);
+        return const_reference{to_view(batch->ids[i]),
+                               to_view(batch->seqs[i]).substr(iv.beg, iv.end - iv.beg),
+                               qual.empty() ? qual : qual.substr(iv.beg, iv.end - iv.beg)};
+    }
+
+private:
+    //!\brief Befriend the class that fills this object.
+    friend class trimmer;
+
+    //!\brief The batch.
+    record_batch<> const *     batch = nullptr;
+    //!\brief The retained part of every record.
+    std::vector<trim_interval> intervals_;
+
+    //!\brief Convert an element of a batch to std::string_view.
+    static std::string_view to_view(auto const & chars) { return {chars.data(), chars.size()}; }
+};
+
+/*!\brief Quality, adapter and poly-G trimming of sequence records.
+ * \ingroup seq
+ * \details
+ *
+ * The trimmer computes the part of every record that is retained; the records themselves are not copied or
+ * modified. It can be applied to single records, or to a whole bio::io::seq::record_batch (of characters) on multiple
+ * threads, which results in a bio::io::seq::trimmed_batch that can be written directly.
+ *
+ * The following steps are performed in this order (see bio::io::seq::trim_options for details):
+ *
+ *   1. Poly-G tails are clipped.
+ *   2. The read is cut at the first window of low quality.
+ *   3. 3' adapters are removed.
+ *   4. 5' adapters are removed.
+ *
+ * Adapters are found via Myers' bit-parallel algorithm, which computes the edit distance of an adapter (of up to 64
+ * bases) to all positions of a read with a few word operations per base. After the last base, the same bit-vectors
+ * hold the edit distances of all prefixes of the adapter to the end of the read, so partial adapters are found
+ * without extra work. The beginning of a complete match is found by aligning the adapter backwards from the end of
+ * the match; a partial adapter at the end of a read is assumed to be as long as the matching prefix.
+ *
+ * ### Example
+ *
+ * ```cpp
+ * bio::io::seq::reader reader{"reads.fastq.gz"};
+ * bio::io::seq::writer writer{"trimmed.fastq.gz"};
+ *
+ * bio::io::seq::trimmer const trimmer{bio::io::seq::trim_options{.adapters_3p       = {"AGATCGGAAGAGC"},
+ *                                                                .poly_g_min_length = 10,
+ *                                                                .qual_cutoff       = 20}};
+ *
+ * bio::io::seq::record_batch<> batch;
+ * bio::io::seq::trimmed_batch  trimmed;
+ * while (reader.read_batch(batch, 100'000) > 0)
+ * {
+ *     trimmer(batch, trimmed);
+ *     writer.push_back_batch(trimmed);
+ * }
+ * ```
+ */
+class trimmer
+{
+public:
+    /*!\brief Constructor.
+     * \param[in] opt The options.
+     * \throws bio::io::bio_error If an adapter is empty or the options are invalid.
+     */
+    explicit trimmer(trim_options opt) : options{std::move(opt)}
+    {
+        if (options.adapter_error_rate < 0 || options.adapter_error_rate >= 1)
+            throw bio_error{"The adapter error rate must be in [0, 1)."};
+        if (options.qual_window == 0)
+            throw bio_error{"The quality window must not be empty."};
+
+        for (std::string const & adapter : options.adapters_3p)
+            patterns_3p.push_back(make_pattern(adapter, false));
+        for (std::string const & adapter : options.adapters_5p)
+            patterns_5p.push_back(make_pattern(adapter, true));
+    }
+
+    /*!\brief Trim a single record.
+     * \param[in] seq The sequence (as characters).
+     * \param[in] qual The qualities (as characters); may be empty.
+     * \returns The retained part of the record.
+     */
+    trim_interval operator()(std::string_view const seq, std::string_view const qual) const
+    {
+        trim_interval iv{0, seq.size()};
+
+        if (options.poly_g_min_length > 0)
+            iv.end = clip_poly_g(seq, iv);
+
+        if (options.qual_cutoff > 0 && qual.size() == seq.size())
+            iv.end = trim_qual(qual, iv);
+
+        for (pattern const & p : patterns_3p)
+            iv.end = iv.beg + retained_length(p, seq.substr(iv.beg, iv.end - iv.beg), false);
+
+        for (pattern const & p : patterns_5p)
+            iv.beg = iv.end - retained_length(p, seq.substr(iv.beg, iv.end - iv.beg), true);
+
+        return iv;
+    }
+
+    /*!\brief Trim all records of a batch.
+     * \param[in] batch The batch; it is not modified.
+     * \param[out] out The trimmed records; refers to `batch`. Memory is reused if the same object is passed again.
+     * \details
+     *
+     * The records are split into bio::io::seq::trim_options::threads contiguous parts that are trimmed in parallel.
+     */
+    void operator()(record_batch<> const & batch, trimmed_batch & out) const
+    {
+        out.batch = &batch;
+        out.intervals_.resize(batch.size());
+
+        auto trim_part = [&](size_t const beg, size_t const end)
+        {
+            for (size_t i = beg; i < end; ++i)
+                out.intervals_[i] = (*this)(trimmed_batch::to_view(batch.seqs[i]),
+                                            trimmed_batch::to_view(batch.quals[i]));
+        };
+
+        // small batches are not worth spawning threads
+        size_t const n_parts = std::clamp<size_t>(batch.size() / 1024, 1, std::max<size_t>(options.threads, 1));
+
+        std::vector<std::jthread> threads;
+        for (size_t i = 1; i < n_parts; ++i)
+            threads.emplace_back(trim_part, i * batch.size() / n_parts, (i + 1) * batch.size() / n_parts);
+        trim_part(0, batch.size() / n_parts);
+    }
+
+private:
+    //!\brief An adapter prepared for Myers' algorithm.
+    struct pattern
+    {
+        //!\brief For every character, the bit-vector of the adapter positions that it matches.
+        std::array<uint64_t, 256> peq{};
+        //!\brief The same for the reversed adapter (used for finding the beginning of a match).
+        std::array<uint64_t, 256> peq_reverse{};
+        //!\brief The length of the adapter (at most 64).
+        size_t                    length = 0;
+    };
+
+    //!\brief The options.
+    trim_options         options;
+    //!\brief The 3' adapters.
+    std::vector<pattern> patterns_3p;
+    //!\brief The 5' adapters (reversed).
+    std::vector<pattern> patterns_5p;
+
+    //!\brief Create the bit-vectors of an adapter; 5' adapters are reversed, so they are matched from the 3' end.
+    static pattern make_pattern(std::string_view const adapter, bool const reverse)
+    {
+        if (adapter.empty())
+            throw bio_error{"Adapters must not be empty."};
+
+        pattern ret;
+        ret.length = std::min<size_t>(adapter.size(), 64);
+
+        auto set_bit = [](std::array<uint64_t, 256> & peq, char const c, size_t const i)
+        {
+            if (c == 'N' || c == 'n')
+            {
+                for (uint64_t & bits : peq)
+                    bits |= 1ull << i;
+            }
+            else
+            {
+                peq[static_cast<uint8_t>(c) & ~0x20] |= 1ull << i; // upper-case
+                peq[static_cast<uint8_t>(c) | 0x20] |= 1ull << i;  // lower-case
+            }
+        };
+
+        for (size_t i = 0; i < ret.length; ++i)
+        {
+            char const c = reverse ? adapter[adapter.size() - 1 - i] : adapter[i];
+            set_bit(ret.peq, c, i);
+            set_bit(ret.peq_reverse, c, ret.length - 1 - i);
+        }
+        return ret;
+    }
+
+    /*!\brief Find an adapter via Myers' algorithm and return the number of bases before it.
+     * \param[in] p The adapter.
+     * \param[in] seq The sequence.
+     * \param[in] reverse Whether the sequence is processed from the end (for 5' adapters).
+     * \returns The number of bases before the adapter (in the direction of processing); `seq.size()` if none is found.
+     */
+    size_t retained_length(pattern const & p, std::string_view const seq, bool const reverse) const
+    {
+        size_t const   n          = seq.size();
+        size_t const   m          = p.length;
+        uint64_t const last_bit   = 1ull << (m - 1);
+        size_t const   max_errors = static_cast<size_t>(m * options.adapter_error_rate);
+
+        uint64_t pv    = ~0ull; // vertical deltas of +1
+        uint64_t mv    = 0;     // vertical deltas of -1
+        size_t   score = m;     // edit distance of the whole adapter ending at the current position
+
+        for (size_t j = 0; j < n; ++j)
+        {
+            uint64_t const eq = p.peq[static_cast<uint8_t>(seq[reverse ? n - 1 - j : j])];
+            uint64_t const xv = eq | mv;
+            uint64_t const xh = (((eq & pv) + pv) ^ pv) | eq;
+            uint64_t       ph = mv | ~(xh | pv);
+            uint64_t       mh = pv & xh;
+
+            if (ph & last_bit)
+                ++score;
+            else if (mh & last_bit)
+                --score;
+
+            // no carry-in: a match may begin at any position of the sequence
+            ph <<= 1;
+            mh <<= 1;
+            pv = mh | ~(xv | ph);
+            mv = ph & xv;
+
+            if (score <= max_errors) // leftmost occurrence of the whole adapter
+                return match_begin(p, seq, j, reverse, max_errors);
+        }
+
+        // partial adapter at the end; the longest prefix that matches well enough is removed
+        size_t  ret      = n;
+        int64_t distance = 0; // edit distance of the adapter's prefix of length i
+        for (size_t i = 1; i <= std::min(m, n); ++i)
+        {
+            distance += static_cast<int64_t>((pv >> (i - 1)) & 1) - static_cast<int64_t>((mv >> (i - 1)) & 1);
+            if (i >= options.adapter_min_overlap && distance <= static_cast<int64_t>(i * options.adapter_error_rate))
+                ret = n - i;
+        }
+        return ret;
+    }
+
+    /*!\brief Find the beginning of a match of the whole adapter that ends at `last`.
+     * \details
+     *
+     * The reversed adapter is aligned (via Myers' algorithm with a fixed beginning) to the reversed sequence,
+     * starting at `last`. The longest of the best alignments determines the beginning, so no adapter bases are kept.
+     */
+    static size_t match_begin(pattern const &        p,
+                              std::string_view const seq,
+                              size_t const           last,
+                              bool const             reverse,
+                              size_t const           max_errors)
+    {
+        size_t const   n        = seq.size();
+        size_t const   m        = p.length;
+        uint64_t const last_bit = 1ull << (m - 1);
+
+        uint64_t pv         = ~0ull;
+        uint64_t mv         = 0;
+        size_t   score      = m;
+        size_t   best_score = m;
+        size_t   best_begin = last + 1;
+
+        for (size_t k = last + 1; k > 0 && last + 1 - k < m + max_errors; --k)
+        {
+            size_t const   j  = k - 1;
+            uint64_t const eq = p.peq_reverse[static_cast<uint8_t>(seq[reverse ? n - 1 - j : j])];
+            uint64_t const xv = eq | mv;
+            uint64_t const xh = (((eq & pv) + pv) ^ pv) | eq;
+            uint64_t       ph = mv | ~(xh | pv);
+            uint64_t       mh = pv & xh;
+
+            if (ph & last_bit)
+                ++score;
+            else if (mh & last_bit)
+                --score;
+
+            // carry-in: the alignment begins at `last`
+            ph = (ph << 1) | 1;
+            mh <<= 1;
+            pv = mh | ~(xv | ph);
+            mv = ph & xv;
+
+            if (score <= best_score)
+            {
+                best_score = score;
+                best_begin = j;
+            }
+        }
+
+        return best_begin;
+    }
+
+    //!\brief Return the end of the sequence without poly-G tail.
+    size_t clip_poly_g(std::string_view const seq, trim_interval const iv) const
+    {
+        size_t ret        = iv.end;
+        size_t mismatches = 0;
+        size_t run        = 0; // number of consecutive Gs
+        for (size_t pos = iv.end; pos > iv.beg; --pos)
+        {
+            size_t const length = iv.end - pos + 1;
+            if ((seq[pos - 1] | 0x20) == 'g')
+            {
+                // the tail does not begin with a single G behind a mismatch
+                if (++run >= 2 && length >= options.poly_g_min_length && mismatches * 8 <= length)
+                    ret = pos - 1;
+            }
+            else if (++mismatches * 8 > length + 8) // no chance of getting back to one mismatch per 8 bases
+            {
+                break;
+            }
+            else
+            {
+                run = 0;
+            }
+        }
+        return ret;
+    }
+
+    //!\brief Return the end of the sequence after quality trimming.
+    size_t trim_qual(std::string_view const qual, trim_interval const iv) const
+    {
+        size_t const w = std::min(options.qual_window, iv.end - iv.beg);
+        if (w == 0)
+            return iv.end;
+
+        // compare the sums of the characters, so the offset need not be subtracted per base
+        uint64_t const cutoff    = options.qual_cutoff + options.qual_offset;
+        uint64_t const threshold = cutoff * w;
+
+        uint64_t sum = 0;
+        for (size_t i = iv.beg; i < iv.beg + w; ++i)
+            sum += static_cast<uint8_t>(qual[i]);
+
+        for (size_t i = iv.beg;; ++i)
+        {
+            if (sum < threshold)
+            {
+                while (i < iv.end && static_cast<uint8_t>(qual[i]) >= cutoff)
+                    ++i;
+                return i;
+            }
+
+            if (i + w >= iv.end)
+                return iv.end;
+
+            sum += static_cast<uint8_t>(qual[i + w]);
+            sum -= static_cast<uint8_t>(qual[i]);
+        }
+    }
+};
+
+} // namespace bio::io::seq
@@ -13,9 +13,14 @@
 
 #pragma once
 
+#include <algorithm>
 #include <filesystem>
 #include <iosfwd>
+#include <sstream>
+#include <string>
+#include <thread>
 
+#include <bio/io/detail/parallel_format.hpp>
 #include <bio/io/detail/writer_base.hpp>
 #include <bio/io/format/fasta_output_handler.hpp>
 #include <bio/io/format/fastq_output_handler.hpp>
@@ -90,6 +95,9 @@ namespace bio::io::seq
  *
  * \snippet test/snippet/seq/seq_writer.cpp inout3
  *
+ * ### Writing in parallel
+ *
+ * Many records can be formatted on multiple threads via push_back_batch().
  */
 template <typename... option_args_t>
 class writer : public writer_base<writer<option_args_t...>, writer_options<option_args_t...>>
@@ -109,6 +117,8 @@ private:
     //!\brief Make the init_state handler visible.
     using base_t::init_state;
 
+    using base_t::options;
+    using base_t::stream;
     using base_t::write_record;
 
 public:
@@ -223,6 +233,86 @@ public:
         static_assert(detail::record_write_concept_checker(std::type_identity<record<member_types...>>{}));
         write_record(r); // pass as non-const to allow parsing views that are not const-iterable
     }
+
+    /*!\brief Format and write many records using multiple threads.
+     * \tparam records_t Type of the input; see below.
+     * \param[in] records The records, e.g. a std::vector of bio::io::seq::record or a bio::io::seq::record_batch.
+     * \param[in] n_threads The number of threads to use for formatting.
+     * \throws bio::io::bio_error If a FAI index is created (bio::io::seq::writer_options::fai_file).
+     *
+     * \details
+     *
+     * The input needs to provide `size()` and `operator[]`, and the elements need to be bio::io::seq::record.
+     *
+     * The records are split into `n_threads` contiguous chunks that are formatted into separate buffers and then
+     * written in order (see also bio::io::txt::writer::push_back_batch()). Writing a buffer to the stream overlaps
+     * with formatting the later chunks; with BGZF output and multiple compression threads (see
+     * bio::io::transparent_ostream_options::threads), formatting and compression both happen in parallel.
+     * The output is identical to writing the records one-by-one, and push_back_batch() and push_back() can be mixed.
+     *
+     * Large batches result in better parallelisation; all formatted records of one batch are held in memory.
+     */
+    template <typename records_t>
+        //!\cond REQ
+        requires(requires(records_t & records) {
+                     records[size_t{}];
+                     std::ranges::size(records);
+                 })
+    //!\endcond
+    void push_back_batch(records_t && records,
+                         size_t const n_threads = std::max<size_t>(1, std::thread::hardware_concurrency()))
+    {
+        using record_t = std::remove_cvref_t<decltype(records[size_t{}])>;
+        static_assert(detail::record_write_concept_checker(std::type_identity<record_t>{}));
+
+        if (!options.fai_file.empty())
+            throw bio_error{"push_back_batch() does not support creating FAI indexes."};
+
+        size_t const n = std::ranges::size(records);
+        if (n == 0)
+            return;
+
+        init_state = false;
+        std::visit(meta::overloaded([](std::monostate) {},
+                                    [&](auto & handler) { push_back_batch_impl(handler, records, n, n_threads); }),
+                   format_handler);
+    }
+
+private:
+    //!\brief Implementation of push_back_batch() for a specific format handler.
+    template <typename handler_t, typename records_t>
+    void push_back_batch_impl(handler_t & handler, records_t & records, size_t const n, size_t const n_threads)
+    {
+        constexpr bool continuable = requires { handler.continue_after(records[0]); };
+
+        auto format_fn = [&](size_t const beg, size_t const end, std::string & buf)
+        {
+            if (beg == 0) // the first chunk is formatted on the calling thread before anything else is written
+            {
+                for (size_t i = beg; i < end; ++i)
+                    handler.write_record(records[i]);
+                return;
+            }
+
+            std::ostringstream str;
+            {
+                handler_t chunk_handler{str, options};
+                if constexpr (continuable)
+                    chunk_handler.continue_after(records[beg - 1]);
+
+                for (size_t i = beg; i < end; ++i)
+                    chunk_handler.write_record(records[i]);
+            }
+            buf = std::move(str).str();
+        };
+
+        auto sink_fn = [&](std::string const & buf) { stream.write(buf.data(), buf.size()); };
+
+        io::detail::parallel_format(n, n_threads, format_fn, sink_fn);
+
+        if constexpr (continuable)
+            handler.continue_after(records[n - 1]);
+    }
 };
 
 } // namespace bio::io::seq
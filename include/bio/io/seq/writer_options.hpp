@@ -13,6 +13,8 @@
 
 #pragma once
 
+#include <filesystem>
+
 #include <bio/meta/tag/ttag.hpp>
 
 #include <bio/io/format/fasta.hpp>
@@ -53,6 +55,18 @@ struct writer_options
      */
     bool double_id = false;
 
+    /*!\brief Create a FAI index of the output and write it to this file (FastA-only).
+     *
+     * \details
+     *
+     * **FastA-only**
+     *
+     * If set, a bio::io::seq::fai_index is created while writing and written to the given file when the writer
+     * is destructed. The output must be uncompressed or BGZF-compressed. Typically, the file name is the name of the
+     * output file plus ".fai".
+     */
+    std::filesystem::path fai_file{};
+
     /*!\brief The formats that output files can take; a bio::meta::ttag over the types.
      *
      * \details
@@ -115,6 +115,7 @@ public:
     Serializer<OutputBuffer, BufferWriter> serializer;
     size_t                                 currentJobId;
     bool                                   currentJobAvail;
+    uint64_t                               uncompressedSize = 0; // bytes handed to compression so far
 
     struct CompressionThread
     {
@@ -217,6 +218,7 @@ public:
         if (currentJobAvail)
         {
             jobs[currentJobId].size = size;
+            uncompressedSize += size;
             appendValue(jobQueue, currentJobId);
         }
 
@@ -280,6 +282,15 @@ public:
         return 0;
     }
 
+    // only supports querying the current position (in uncompressed bytes)
+    virtual pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which)
+    {
+        if (off != 0 || dir != std::ios_base::cur || !(which & std::ios_base::out))
+            return pos_type(off_type(-1));
+
+        return pos_type(static_cast<off_type>(uncompressedSize + (this->pptr() - this->pbase())));
+    }
+
     void addFooter()
     {
         // we flush the filled buffer here, so that an empty (EOF) buffer is flushed in the d'tor
@@ -26,6 +26,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <cstring>
 #include <iostream>
 #include <vector>
@@ -64,6 +65,8 @@ public:
     typedef Tr                                          traits_type;
     typedef typename Tr::char_type                      char_type;
     typedef typename Tr::int_type                       int_type;
+    typedef typename Tr::off_type                       off_type;
+    typedef typename Tr::pos_type                       pos_type;
     typedef std::vector<byte_type, byte_allocator_type> byte_vector_type;
     typedef std::vector<char_type, char_allocator_type> char_vector_type;
 
@@ -78,6 +81,9 @@ public:
 
     int_type underflow();
 
+    // only supports querying the position, i.e. the number of decompressed characters consumed so far
+    pos_type seekoff(off_type ofs, std::ios_base::seekdir dir, std::ios_base::openmode openMode);
+
     // returns the compressed input istream
     istream_reference get_istream() { return m_istream; }
     // returns the zlib stream structure
@@ -93,6 +99,7 @@ private:
     int               m_err;
     byte_vector_type  m_input_buffer;
     char_vector_type  m_buffer;
+    uint64_t          m_n_decompressed = 0;
 };
 
 // --------------------------------------------------------------------------
@@ -147,6 +154,8 @@ basic_gz_istreambuf<Elem, Tr, ElemA, ByteT, ByteAT>::underflow()
     if (num <= 0) // ERROR or EOF
         return traits_type::eof();
 
+    m_n_decompressed += num;
+
     // reset buffer pointers
     this->setg(&(m_buffer[0]) + (4 - n_putback), // beginning of putback area
                &(m_buffer[0]) + 4,               // read position
@@ -156,6 +165,18 @@ basic_gz_istreambuf<Elem, Tr, ElemA, ByteT, ByteAT>::underflow()
     return *reinterpret_cast<unsigned char *>(this->gptr());
 }
 
+template <typename Elem, typename Tr, typename ElemA, typename ByteT, typename ByteAT>
+typename basic_gz_istreambuf<Elem, Tr, ElemA, ByteT, ByteAT>::pos_type
+basic_gz_istreambuf<Elem, Tr, ElemA, ByteT, ByteAT>::seekoff(off_type                ofs,
+                                                            std::ios_base::seekdir  dir,
+                                                            std::ios_base::openmode openMode)
+{
+    if (ofs != 0 || dir != std::ios_base::cur || (openMode & std::ios_base::in) == 0)
+        return pos_type(off_type(-1));
+
+    return pos_type(off_type(m_n_decompressed - (this->egptr() - this->gptr())));
+}
+
 template <typename Elem, typename Tr, typename ElemA, typename ByteT, typename ByteAT>
 std::streamsize basic_gz_istreambuf<Elem, Tr, ElemA, ByteT, ByteAT>::unzip_from_stream(char_type *     buffer_,
                                                                                        std::streamsize buffer_size_)
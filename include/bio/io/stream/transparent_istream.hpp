@@ -203,8 +203,6 @@ private:
         if (primary_stream->fail())
             throw bio_error{"Seek failed on input stream."};
 
-        secondary_stream.reset();
-
         options_.compression = compression_format::detect;
         init();
 
@@ -309,6 +307,14 @@ public:
      */
     std::filesystem::path const & truncated_filename() { return truncated_filename_; }
 
+    /*!\brief The compression format that was selected for decompression.
+     * \details
+     *
+     * Note that BGZF compressed files are decompressed as regular GZ files if only a single thread is used; this
+     * function will then return bio::io::compression_format::gz.
+     */
+    compression_format compression() const noexcept { return selected_compression; }
+
     /*!\brief Seek on the primary stream and reset secondary stream.
      * \details
      *
@@ -320,6 +326,10 @@ public:
     {
         compression_format old_compression = selected_compression;
 
+        // destroy decompression layer first; it may have threads that are still reading from the primary stream
+        secondary_stream.reset();
+
+        primary_stream->clear(); // reset EOF/fail state after having read to the end
         primary_stream->seekg(pos);
 
         post_seek(old_compression);
@@ -332,6 +342,10 @@ public:
     {
         compression_format old_compression = selected_compression;
 
+        // destroy decompression layer first; it may have threads that are still reading from the primary stream
+        secondary_stream.reset();
+
+        primary_stream->clear(); // reset EOF/fail state after having read to the end
         primary_stream->seekg(off, dir);
 
         post_seek(old_compression);
@@ -0,0 +1,195 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2022, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2022, Knut Reinert & MPI für molekulare Genetik
+// Copyright (c) 2020-2022, deCODE Genetics
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/bio/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides bio::io::txt::line_index.
+ * \author Hannes Hauswedell <hannes.hauswedell AT decode.is>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string_view>
+#include <vector>
+
+#include <bio/io/detail/to_little_endian.hpp>
+#include <bio/io/exception.hpp>
+#include <bio/io/stream/detail/fast_streambuf_iterator.hpp>
+#include <bio/io/stream/transparent_istream.hpp>
+
+namespace bio::io::txt
+{
+
+/*!\brief A sparse index of line offsets in a plaintext file.
+ * \ingroup txt
+ * \details
+ *
+ * Stores the offset of every N-th line (N is the #stride) in the **uncompressed** data. For uncompressed files
+ * these are plain byte offsets. For BGZF compressed files, the offsets are translated into on-disk positions via the
+ * GZI index of the file (which is read from "FILE.gzi" if present or is created by scanning the block headers).
+ * Other compression formats do not support random access.
+ *
+ * Lines are counted from the beginning of the file, including any header lines.
+ *
+ * The index can be created in one of the following ways:
+ *
+ *   1. By reading the file: bio::io::txt::line_index::build().
+ *   2. While writing the file: bio::io::txt::writer::record_line_index().
+ *
+ * It is used via bio::io::txt::reader::set_line_index().
+ *
+ * ### File format
+ *
+ * All numbers are stored as little-endian uint64_t:
+ *
+ * ```
+ * magic ("TXL\1")    4 bytes
+ * stride             8 bytes
+ * n_lines            8 bytes
+ * n_offsets          8 bytes
+ * offsets            n_offsets * 8 bytes
+ * ```
+ */
+struct line_index
+{
+    //!\brief Magic bytes of the file format.
+    static constexpr char magic_bytes[4] = {'T', 'X', 'L', 1};
+
+    //!\brief The distance (in lines) between indexed lines.
+    uint64_t              stride  = 1024;
+    //!\brief The total number of lines in the file.
+    uint64_t              n_lines = 0;
+    //!\brief Offsets of line `i * stride`.
+    std::vector<uint64_t> offsets;
+
+    //!\brief Read an index from disk.
+    void read(std::filesystem::path const & path);
+    //!\brief Write an index to disk.
+    void write(std::filesystem::path const & path) const;
+
+    /*!\brief Create an index by reading the given file.
+     * \param[in] path The file to index; may be compressed.
+     * \param[in] stride Every stride-th line is indexed.
+     * \param[in] istream_options Options passed to the underlying stream.
+     * \details
+     *
+     * This scans the decompressed data for newline characters but does not otherwise process the lines.
+     */
+    static line_index build(std::filesystem::path const &       path,
+                            uint64_t const                      stride          = 1024,
+                            transparent_istream_options const & istream_options = transparent_istream_options{});
+};
+
+inline void line_index::read(std::filesystem::path const & path)
+{
+    std::ifstream istream{path, std::ios::binary};
+    if (!istream.good())
+        throw file_open_error{"Could not open line index file ", path.string(), " for reading."};
+
+    io::detail::fast_istreambuf_iterator<char> it{istream};
+
+    char magic[4]{};
+    it.read_n_chars_into(4, magic);
+    if (!std::ranges::equal(magic, magic_bytes))
+        throw format_error{"The file ", path.string(), " is not a line index."};
+
+    uint64_t n_offsets = 0;
+    it.read_as_binary(stride);
+    it.read_as_binary(n_lines);
+    it.read_as_binary(n_offsets);
+    stride    = io::detail::to_little_endian(stride);
+    n_lines   = io::detail::to_little_endian(n_lines);
+    n_offsets = io::detail::to_little_endian(n_offsets);
+
+    if (stride == 0)
+        throw format_error{"The line index ", path.string(), " has a stride of 0."};
+
+    offsets.resize(n_offsets);
+    it.read_n_chars_into(n_offsets * sizeof(uint64_t), reinterpret_cast<char *>(offsets.data()));
+    for (uint64_t & o : offsets)
+        o = io::detail::to_little_endian(o);
+}
+
+inline void line_index::write(std::filesystem::path const & path) const
+{
+    std::ofstream ostream{path, std::ios::binary};
+    if (!ostream.good())
+        throw file_open_error{"Could not open file ", path.string(), " for writing."};
+
+    io::detail::fast_ostreambuf_iterator<char> it{ostream};
+
+    it.write_range(std::string_view{magic_bytes, 4});
+    it.write_as_binary(io::detail::to_little_endian(stride));
+    it.write_as_binary(io::detail::to_little_endian(n_lines));
+    it.write_as_binary(io::detail::to_little_endian(static_cast<uint64_t>(offsets.size())));
+    for (uint64_t const o : offsets)
+        it.write_as_binary(io::detail::to_little_endian(o));
+}
+
+inline line_index line_index::build(std::filesystem::path const &       path,
+                                    uint64_t const                      stride,
+                                    transparent_istream_options const & istream_options)
+{
+    if (stride == 0)
+        throw bio_error{"The stride of a line index must be larger than 0."};
+
+    line_index ret;
+    ret.stride = stride;
+
+    transparent_istream istream{path, istream_options};
+    auto * stream_buf = reinterpret_cast<io::detail::stream_buffer_exposer<char> *>(istream.rdbuf());
+
+    uint64_t buffer_offset = 0;    // uncompressed offset of gptr()
+    bool     at_line_start = true; // whether the next character begins a line
+
+    while (true)
+    {
+        if (stream_buf->gptr() == stream_buf->egptr())
+        {
+            stream_buf->underflow();
+            if (stream_buf->gptr() == stream_buf->egptr())
+                break;
+        }
+
+        char const * const beg = stream_buf->gptr();
+        char const * const end = stream_buf->egptr();
+        char const *       cur = beg;
+
+        while (cur != end)
+        {
+            if (at_line_start)
+            {
+                if (ret.n_lines % stride == 0)
+                    ret.offsets.push_back(buffer_offset + (cur - beg));
+                at_line_start = false;
+            }
+
+            char const * const eol = static_cast<char const *>(std::memchr(cur, '\n', end - cur));
+            if (eol == nullptr)
+                break;
+
+            ++ret.n_lines;
+            at_line_start = true;
+            cur           = eol + 1;
+        }
+
+        buffer_offset += end - beg;
+        stream_buf->gbump(end - beg);
+    }
+
+    if (!at_line_start) // last line without newline
+        ++ret.n_lines;
+
+    return ret;
+}
+
+} // namespace bio::io::txt
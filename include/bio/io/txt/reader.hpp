@@ -13,14 +13,22 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <optional>
 #include <ranges>
 #include <string_view>
 
 #include <bio/alphabet/concept.hpp>
 #include <bio/ranges/views/to_char.hpp>
 
+#include <bio/io/detail/count_char.hpp>
+#include <bio/io/detail/index_gzi.hpp>
 #include <bio/io/stream/detail/fast_streambuf_iterator.hpp>
 #include <bio/io/stream/transparent_istream.hpp>
+#include <bio/io/txt/line_index.hpp>
 #include <bio/io/txt/misc.hpp>
 
 namespace bio::io::txt::detail
@@ -45,6 +53,9 @@ private:
     //!\brief The record.
     record record_;
 
+    //!\brief Number of lines that may still be read (see #limit_lines()).
+    uint64_t lines_left = std::numeric_limits<uint64_t>::max();
+
     //!\brief Whether iterator is at end.
     bool at_end     = false;
     //!\brief Delimiter between fields.
@@ -136,6 +147,13 @@ public:
         if (at_end)
             return *this;
 
+        if (lines_left == 0)
+        {
+            at_end = true;
+            return *this;
+        }
+        --lines_left;
+
         if (stream_buf->gptr() == stream_buf->egptr()) // possible to be on empty buffer
         {
             stream_buf->underflow();
@@ -158,26 +176,35 @@ public:
 
         while (!rec_end_found)
         {
-            for (count = 0; count < static_cast<size_t>(stream_buf->egptr() - stream_buf->gptr()); ++count)
+            size_t const available = stream_buf->egptr() - stream_buf->gptr();
+            if constexpr (record_kind_ == record_kind::line_and_fields)
             {
-                if (stream_buf->gptr()[count] == record_sep)
+                for (count = 0; count < available; ++count)
                 {
-                    rec_end_found = true;
-                    break;
-                }
-                else
-                {
-                    if constexpr (record_kind_ == record_kind::line_and_fields)
-                        if (stream_buf->gptr()[count] == field_sep)
-                            field_end_positions.push_back(old_count + count);
+                    if (stream_buf->gptr()[count] == record_sep)
+                    {
+                        rec_end_found = true;
+                        break;
+                    }
+                    else if (stream_buf->gptr()[count] == field_sep)
+                    {
+                        field_end_positions.push_back(old_count + count);
+                    }
                 }
             }
+            else // no per-character work, so the separator can be found via memchr
+            {
+                char const * const sep =
+                  static_cast<char const *>(std::memchr(stream_buf->gptr(), record_sep, available));
+                rec_end_found = sep != nullptr;
+                count         = rec_end_found ? sep - stream_buf->gptr() : available;
+            }
 
             if (!rec_end_found)
             {
+                // the buffer is kept between lines and grows geometrically, so long lines are copied only once
                 has_overflowed = true;
-                overflow_buffer.resize(old_count + count);
-                std::ranges::copy(stream_buf->gptr(), stream_buf->egptr(), overflow_buffer.data() + old_count);
+                overflow_buffer.insert(overflow_buffer.end(), stream_buf->gptr(), stream_buf->egptr());
 
                 old_count += count;
                 stream_buf->gbump(count);
@@ -196,8 +223,7 @@ public:
         if (has_overflowed)
         {
             // need to copy last data
-            overflow_buffer.resize(old_count + count);
-            std::ranges::copy(stream_buf->gptr(), stream_buf->gptr() + count, overflow_buffer.data() + old_count);
+            overflow_buffer.insert(overflow_buffer.end(), stream_buf->gptr(), stream_buf->gptr() + count);
 
             // make data pointer point into overflow
             data_begin = overflow_buffer.data();
@@ -205,7 +231,8 @@ public:
 
         size_t end_of_record = old_count + count;
         // dirty hack for CR: skip it in the buffer but don't add to output
-        if (count > 0 && (stream_buf->gptr()[count - 1] == '\r'))
+        // (it may be the last character before a buffer boundary, so check the assembled line)
+        if (end_of_record > 0 && data_begin[end_of_record - 1] == '\r')
             --end_of_record;
 
         if (rec_end_found)                // whe are not yet at end of file
@@ -262,6 +289,86 @@ public:
             return &record_.line;
     }
 
+    /*!\brief Stop iterating after at most n further lines.
+     * \details
+     *
+     * The current line is not counted, i.e. after calling `limit_lines(0)`, the iterator is at end after the
+     * next increment.
+     */
+    void limit_lines(uint64_t const n) noexcept { lines_left = n; }
+
+    /*!\brief Skip lines behind the current one without creating records.
+     * \param[in] n The number of lines to skip.
+     * \returns The number of lines skipped; smaller than `n` only if the end of input was reached.
+     * \details
+     *
+     * This operates directly on the stream buffer and never copies data. Newlines are counted blockwise via
+     * bio::io::detail::count_char() and located via `memchr`. A final line without newline character is counted.
+     *
+     * The current record is invalidated; increment the iterator to read the line behind the skipped ones.
+     */
+    uint64_t skip_lines(uint64_t n)
+    {
+        assert(stream_buf != nullptr);
+
+        constexpr ptrdiff_t block_size = 256;
+
+        n = std::min(n, lines_left);
+
+        uint64_t skipped = 0;
+        bool     in_line = false; // whether the last character skipped was not a newline
+
+        while (skipped < n)
+        {
+            if (stream_buf->gptr() == stream_buf->egptr())
+            {
+                stream_buf->underflow();
+                if (stream_buf->gptr() == stream_buf->egptr())
+                {
+                    if (in_line) // last line without newline
+                        ++skipped;
+                    break;
+                }
+            }
+
+            char const *       cur = stream_buf->gptr();
+            char const * const end = stream_buf->egptr();
+
+            while (skipped < n && cur != end)
+            {
+                // skip whole blocks that contain fewer newlines than still need to be skipped
+                if (uint64_t const remaining = n - skipped; remaining > 8 && end - cur >= block_size)
+                {
+                    if (size_t const c = io::detail::count_char(cur, cur + block_size, record_sep); c < remaining)
+                    {
+                        skipped += c;
+                        cur += block_size;
+                        in_line = cur[-1] != record_sep;
+                        continue;
+                    }
+                }
+
+                char const * const eol = static_cast<char const *>(std::memchr(cur, record_sep, end - cur));
+                if (eol == nullptr)
+                {
+                    cur     = end;
+                    in_line = true;
+                }
+                else
+                {
+                    ++skipped;
+                    cur     = eol + 1;
+                    in_line = false;
+                }
+            }
+
+            stream_buf->gbump(cur - stream_buf->gptr());
+        }
+
+        lines_left -= skipped;
+        return skipped;
+    }
+
     /*!\brief Show the character behind the current record.
      * \throws io_error If the stream is at end.
      * \details
@@ -421,7 +528,7 @@ public:
       requires(record_kind_ == record_kind::line_and_fields)
       //!\endcond
       :
-      stream{filename, istream_options}, it{stream, field_separator}
+      stream{filename, istream_options}, it{stream, field_separator}, field_sep{field_separator}
     {
         read_header(header);
     }
@@ -468,7 +575,7 @@ public:
       requires(record_kind_ == record_kind::line_and_fields)
       //!\endcond
       :
-      stream{str, istream_options}, it{stream, field_separator}
+      stream{str, istream_options}, it{stream, field_separator}, field_sep{field_separator}
     {
         read_header(header);
     }
@@ -495,7 +602,7 @@ public:
            char const                          field_separator,
            header_kind                         header          = header_kind::none,
            transparent_istream_options const & istream_options = transparent_istream_options{}) :
-      stream{std::move(str), istream_options}, it{stream, field_separator}
+      stream{std::move(str), istream_options}, it{stream, field_separator}, field_sep{field_separator}
     {
         read_header(header);
     }
@@ -562,6 +669,130 @@ public:
     //!\brief The header of the file.
     std::string_view header() noexcept { return headr; }
 
+    /*!\name Counting and skipping
+     * \brief Move through the file without creating records.
+     * \{
+     */
+    /*!\brief Skip lines, beginning with the current one.
+     * \param[in] n The number of lines to skip.
+     * \returns The number of lines skipped; smaller than `n` only if the end of the file was reached.
+     * \throws std::runtime_error If begin() has already been called.
+     * \details
+     *
+     * The lines are not split into fields and no data is copied; see
+     * bio::io::txt::detail::input_iterator::skip_lines(). Afterwards, begin() returns an iterator to the first line
+     * behind the skipped ones.
+     */
+    uint64_t skip(uint64_t const n)
+    {
+        if (it_invalid)
+            throw std::runtime_error{"You cannot call skip() after begin() on txt::reader."};
+
+        if (n == 0 || it == std::default_sentinel)
+            return 0;
+
+        uint64_t const skipped = 1 + it.skip_lines(n - 1); // current line is already read
+        ++it;
+        return skipped;
+    }
+
+    /*!\brief Count the lines from the current one to the end of the file.
+     * \returns The number of lines.
+     * \throws std::runtime_error If begin() has already been called.
+     * \details
+     *
+     * This is equivalent to `skip(std::numeric_limits<uint64_t>::max())`, i.e. the reader is at end afterwards.
+     * Header lines are not counted.
+     */
+    uint64_t count() { return skip(std::numeric_limits<uint64_t>::max()); }
+    //!\}
+
+    /*!\name Random access
+     * \brief Jump to lines via a bio::io::txt::line_index.
+     * \{
+     */
+    /*!\brief Set the line index used for random access.
+     * \param[in] index The index.
+     * \details
+     *
+     * See bio::io::txt::line_index for ways to create an index.
+     */
+    void set_line_index(line_index index) { line_idx = std::move(index); }
+
+    /*!\brief Read the line index from a file.
+     * \param[in] index_file The index file; defaults to "FILENAME.lidx".
+     * \throws bio::io::file_open_error If no file name is given and the reader was not created from a file.
+     */
+    void read_line_index(std::filesystem::path index_file = {})
+    {
+        if (index_file.empty())
+        {
+            if (stream.filename().empty())
+                throw file_open_error{"No line index file given and reader was not created from file."};
+            index_file = stream.filename();
+            index_file += ".lidx";
+        }
+
+        line_idx.emplace();
+        line_idx->read(index_file);
+    }
+
+    /*!\brief Move to the given line.
+     * \param[in] n The number of the line (0-based, counted from the beginning of the file).
+     * \throws bio::io::bio_error If no line index was set or the file is not seekable.
+     * \details
+     *
+     * This seeks to the closest indexed line before n and then skips the remaining lines. If n is beyond the end of
+     * the file, the reader will be at end afterwards.
+     *
+     * After calling this function, begin() may be called again (and needs to be called to get a valid iterator).
+     *
+     * The header is not re-read.
+     */
+    void seek_to_line(uint64_t const n)
+    {
+        if (!line_idx.has_value())
+            throw bio_error{"You need to set a line index before calling seek_to_line()."};
+
+        if (line_idx->offsets.empty()) // empty file
+        {
+            it = make_iterator(false);
+        }
+        else
+        {
+            uint64_t const i = std::min<uint64_t>(n / line_idx->stride, line_idx->offsets.size() - 1);
+            seek_to_offset(line_idx->offsets[i]);
+
+            it = make_iterator(false);
+            it.skip_lines(n - i * line_idx->stride);
+            ++it;
+        }
+
+        it_invalid = false;
+    }
+
+    /*!\brief Read lines [first, last).
+     * \param[in] first The number of the first line to read (0-based, counted from the beginning of the file).
+     * \param[in] last The number of the line behind the last line to read.
+     * \returns A range over the lines.
+     * \throws bio::io::bio_error If no line index was set or the file is not seekable.
+     * \details
+     *
+     * This performs seek_to_line(first) and returns a range of at most `last - first` lines. Any previously
+     * obtained iterators are invalidated. This function may be called repeatedly.
+     */
+    std::ranges::subrange<iterator, sentinel> read_lines(uint64_t const first, uint64_t const last)
+    {
+        seek_to_line(first);
+        if (last <= first)
+            it = make_iterator(false, true);
+        else
+            it.limit_lines(last - first - 1);
+
+        return {begin(), end()};
+    }
+    //!\}
+
 protected:
     //!\privatesection
     //!\brief Process the header (if requested).
@@ -598,6 +829,26 @@ protected:
             headr.pop_back();
     }
 
+    //!\brief Create a new iterator on the current stream position.
+    iterator make_iterator(bool const read_first_record, [[maybe_unused]] bool const at_end = false)
+    {
+        iterator ret;
+        if constexpr (record_kind_ == record_kind::line_and_fields)
+            ret = iterator{stream, field_sep, read_first_record};
+        else
+            ret = iterator{stream, read_first_record};
+
+        if (at_end)
+        {
+            ret.limit_lines(0);
+            ++ret;
+        }
+        return ret;
+    }
+
+    //!\brief Seek to an offset in the uncompressed data.
+    void seek_to_offset(uint64_t const offset) { io::detail::seek_to_uncompressed_offset(stream, gzi, offset); }
+
     //!\brief Return the current line (indepent of record_kind_).
     std::string_view current_line()
     {
@@ -615,6 +866,13 @@ protected:
     bool                it_invalid = false;
     //!\brief The stored header.
     std::string         headr;
+    //!\brief Delimiter between fields.
+    char                field_sep = '\t';
+
+    //!\brief Line index (used for random access).
+    std::optional<line_index>            line_idx;
+    //!\brief GZI index (used for random access in BGZF files).
+    std::optional<io::detail::gzi_index> gzi;
 };
 
 /*!\name Deduction guides
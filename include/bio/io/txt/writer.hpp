@@ -13,14 +13,21 @@
 
 #pragma once
 
+#include <functional>
+#include <optional>
 #include <ranges>
+#include <string>
 #include <string_view>
+#include <thread>
+#include <tuple>
 
 #include <bio/alphabet/concept.hpp>
 #include <bio/ranges/views/to_char.hpp>
 
+#include <bio/io/detail/parallel_format.hpp>
 #include <bio/io/stream/detail/fast_streambuf_iterator.hpp>
 #include <bio/io/stream/transparent_ostream.hpp>
+#include <bio/io/txt/line_index.hpp>
 #include <bio/io/txt/misc.hpp>
 
 namespace bio::io::txt
@@ -53,6 +60,38 @@ concept writable_to_output =
 namespace bio::io::txt::detail
 {
 
+//!\brief Append a single argument to a string; same output as bio::io::txt::detail::plaintext_output_iterator.
+//!\ingroup txt
+void append_single(std::string & buf, txt::writable_to_output auto && arg)
+{
+    using arg_t = decltype(arg);
+    if constexpr (std::same_as<std::remove_cvref_t<arg_t>, char>)
+    {
+        buf.push_back(arg);
+    }
+    else if constexpr (meta::arithmetic<std::remove_cvref_t<arg_t>>)
+    {
+        io::detail::append_number(buf, arg);
+    }
+    else if constexpr (std::same_as<std::decay_t<arg_t>, char const *>)
+    {
+        buf.append(arg);
+    }
+    else if constexpr (std::ranges::input_range<arg_t> &&
+                       std::convertible_to<std::ranges::range_reference_t<arg_t>, char>)
+    {
+        if constexpr (std::ranges::contiguous_range<arg_t> && std::ranges::sized_range<arg_t> &&
+                      std::same_as<std::ranges::range_value_t<arg_t>, char>)
+            buf.append(std::ranges::data(arg), std::ranges::size(arg));
+        else
+            std::ranges::copy(arg, std::back_inserter(buf));
+    }
+    else // if constexpr (std::ranges::input_range<arg_t> && alphabet<std::ranges::range_reference_t<arg_t>>)
+    {
+        std::ranges::copy(arg | bio::views::to_char, std::back_inserter(buf));
+    }
+}
+
 //!\brief An output iterator for writing into plaintext files via certain convenience functions.
 //!\ingroup txt
 template <txt::record_kind record_kind_ = txt::record_kind::line>
@@ -360,7 +399,7 @@ public:
       requires(record_kind_ == record_kind::line_and_fields)
       //!\endcond
       :
-      stream{filename, ostream_options}, it{stream, field_separator}
+      stream{filename, ostream_options}, it{stream, field_separator}, field_sep{field_separator}
     {}
 
     //!\overload
@@ -393,7 +432,7 @@ public:
       requires(record_kind_ == record_kind::line_and_fields)
       //!\endcond
       :
-      stream{str, ostream_options}, it{stream, field_separator}
+      stream{str, ostream_options}, it{stream, field_separator}, field_sep{field_separator}
     {}
 
     //!\overload
@@ -414,7 +453,7 @@ public:
     writer(stream_t &&                         str,
            char const                          field_separator,
            transparent_ostream_options const & ostream_options = transparent_ostream_options{}) :
-      stream{std::move(str), ostream_options}, it{stream, field_separator}
+      stream{std::move(str), ostream_options}, it{stream, field_separator}, field_sep{field_separator}
     {}
 
     //!\overload
@@ -485,6 +524,7 @@ public:
      */
     void write(writable_to_output auto && head, writable_to_output auto &&... tail)
     {
+        begin_line();
         it->write(std::forward<decltype(head)>(head), std::forward<decltype(tail)>(tail)...);
     }
 
@@ -502,7 +542,12 @@ public:
      * A newline is inserted after the arguments are written. This function can be called with zero arguments, in
      * which case only a newline is written.
      */
-    void emplace_back(writable_to_output auto &&... args) { it->write_line(std::forward<decltype(args)>(args)...); }
+    void emplace_back(writable_to_output auto &&... args)
+    {
+        begin_line();
+        it->write_line(std::forward<decltype(args)>(args)...);
+        end_line();
+    }
 
     /*!\brief Write a line to the file.
      * \param[in] line The range of fields.
@@ -518,7 +563,9 @@ public:
       requires(record_kind_ == record_kind::line)
     //!\endcond
     {
+        begin_line();
         *it = line;
+        end_line();
     }
 
     /*!\brief Write a range of fields separated by the delimiter the file.
@@ -538,7 +585,12 @@ public:
         requires((record_kind_ == record_kind::line_and_fields) &&
                  writable_to_output<std::ranges::range_reference_t<range_of_fields_t>>)
     //!\endcond
-    void push_back(range_of_fields_t && range_of_fields) { *it = std::forward<range_of_fields_t>(range_of_fields); }
+    void push_back(range_of_fields_t && range_of_fields)
+    {
+        begin_line();
+        *it = std::forward<range_of_fields_t>(range_of_fields);
+        end_line();
+    }
 
     /*!\brief Write a record to the file.
      * \param[in] record The record to be written.
@@ -554,7 +606,67 @@ public:
       requires(record_kind_ == record_kind::line_and_fields)
     //!\endcond
     {
+        begin_line();
         *it = record.fields;
+        end_line();
+    }
+
+    /*!\brief Format and write many lines using multiple threads.
+     * \tparam rows_t Type of the input; must model std::ranges::random_access_range and std::ranges::sized_range.
+     * \tparam proj_t Type of the projection.
+     * \param[in] rows The input data; every element results in one line.
+     * \param[in] proj A projection that is applied to every element of rows; see below.
+     * \param[in] n_threads The number of threads to use for formatting.
+     *
+     * \details
+     *
+     * The result of applying `proj` to an element of `rows` must be one of the following:
+     *
+     *   1. A type that models bio::io::txt::writable_to_output; the result is written like push_back() would.
+     *   2. A tuple-like type whose elements model bio::io::txt::writable_to_output; the elements are written like
+     *      emplace_back() would.
+     *   3. For delimited files: a range whose elements model bio::io::txt::writable_to_output; the elements are
+     *      written like push_back() would.
+     *
+     * The input is split into `n_threads` contiguous chunks that are formatted into separate buffers (numbers are
+     * converted via std::to_chars) and then written in order. Writing the first buffer to the stream overlaps with
+     * formatting of the later buffers. The output is identical to writing the lines one-by-one.
+     *
+     * The projection is called concurrently from multiple threads and needs to be thread-safe.
+     * Large batches result in better parallelisation; all formatted lines of one batch are held in memory.
+     *
+     * ### Example
+     *
+     * ```cpp
+     * std::vector<feature> features = ...;
+     *
+     * bio::io::txt::writer writer{"features.tsv.gz", '\t'};
+     * writer.push_back_batch(features, [] (feature const & f) { return std::tie(f.name, f.beg, f.end, f.score); });
+     * ```
+     */
+    template <std::ranges::random_access_range rows_t, typename proj_t = std::identity>
+        //!\cond REQ
+        requires(std::ranges::sized_range<rows_t> &&
+                 std::regular_invocable<proj_t const &, std::ranges::range_reference_t<rows_t>>)
+    //!\endcond
+    void push_back_batch(rows_t &&     rows,
+                         proj_t const  proj      = {},
+                         size_t const  n_threads = std::max<size_t>(1, std::thread::hardware_concurrency()))
+    {
+        auto format_fn = [&](size_t const beg, size_t const end, std::string & buf)
+        {
+            for (size_t i = beg; i < end; ++i)
+                append_line(buf, std::invoke(proj, rows[i]));
+        };
+
+        auto sink_fn = [&](std::string const & buf)
+        {
+            if (line_idx.has_value())
+                record_lines(buf, tell());
+            it->write(std::string_view{buf});
+        };
+
+        io::detail::parallel_format(std::ranges::size(rows), n_threads, format_fn, sink_fn);
     }
     //!\}
 
@@ -636,18 +748,163 @@ public:
      * \{
      */
     //!\brief Add carriage return characters before the linefeed (THIS IS NOT RECOMMENDED).
-    void add_carriage_return(bool add) { it->add_carriage_return(add); }
+    void add_carriage_return(bool add)
+    {
+        it->add_carriage_return(add);
+        add_CR = add;
+    }
     /* DESIGN NOTE:
      * This is explicitly not part of constructor options, because it is used very, very rarely and we
      * shouldn't add config or options just because of this.
      */
     //!\}
 
+    /*!\name Line index
+     * \brief Create a bio::io::txt::line_index while writing.
+     * \{
+     */
+    /*!\brief Start recording a line index.
+     * \param[in] stride Every stride-th line is indexed.
+     * \throws bio::io::bio_error If the output is compressed with a format other than BGZF.
+     * \details
+     *
+     * This needs to be called before any lines are written. Only lines written via the member functions of
+     * this class are recorded (not those written via an iterator obtained from begin()).
+     *
+     * The offsets recorded are offsets in the uncompressed data, so a GZI index is needed for random access to BGZF
+     * compressed files (bio::io::txt::reader creates it on demand).
+     */
+    void record_line_index(uint64_t const stride = 1024)
+    {
+        if (stride == 0)
+            throw bio_error{"The stride of a line index must be larger than 0."};
+
+        if (tell() < 0)
+            throw bio_error{"Line indexes can only be created for uncompressed or BGZF compressed output."};
+
+        line_idx.emplace();
+        line_idx->stride = stride;
+    }
+
+    //!\brief The line index recorded so far; throws if record_line_index() was not called.
+    line_index const & recorded_line_index() const
+    {
+        if (!line_idx.has_value())
+            throw bio_error{"No line index is being recorded; call record_line_index() first."};
+        return *line_idx;
+    }
+    //!\}
+
 protected:
+    //!\brief Return the current position in the uncompressed output.
+    std::streamoff tell()
+    {
+        return static_cast<std::streamoff>(stream.rdbuf()->pubseekoff(0, std::ios_base::cur, std::ios_base::out));
+    }
+
+    //!\brief Called before anything is written to a line; records line index if requested.
+    void begin_line()
+    {
+        if (line_idx.has_value() && at_line_start)
+        {
+            if (line_idx->n_lines % line_idx->stride == 0)
+                line_idx->offsets.push_back(tell());
+            at_line_start = false;
+        }
+    }
+
+    //!\brief Record the line beginnings in a buffer that is written at the given offset.
+    void record_lines(std::string_view const buf, uint64_t const offset)
+    {
+        size_t pos = 0;
+        while (pos < buf.size())
+        {
+            if (at_line_start)
+            {
+                if (line_idx->n_lines % line_idx->stride == 0)
+                    line_idx->offsets.push_back(offset + pos);
+                at_line_start = false;
+            }
+
+            size_t const eol = buf.find('\n', pos);
+            if (eol == std::string_view::npos)
+                break;
+
+            ++line_idx->n_lines;
+            at_line_start = true;
+            pos           = eol + 1;
+        }
+    }
+
+    //!\brief Format a line into a buffer (see push_back_batch()).
+    void append_line(std::string & buf, auto && line) const
+    {
+        using line_t = decltype(line);
+
+        if constexpr (writable_to_output<line_t>)
+        {
+            detail::append_single(buf, line);
+        }
+        else if constexpr (requires { std::tuple_size<std::remove_cvref_t<line_t>>::value; })
+        {
+            std::apply(
+              [&](auto &&... args)
+              {
+                  bool first = true;
+                  auto append_one = [&](auto && arg)
+                  {
+                      if (record_kind_ == record_kind::line_and_fields && !first)
+                          buf.push_back(field_sep);
+                      first = false;
+                      detail::append_single(buf, arg);
+                  };
+                  (append_one(args), ...);
+              },
+              line);
+        }
+        else
+        {
+            static_assert(record_kind_ == record_kind::line_and_fields && std::ranges::input_range<line_t> &&
+                            writable_to_output<std::ranges::range_reference_t<line_t>>,
+                          "Unsupported type returned by the projection passed to push_back_batch().");
+
+            bool first = true;
+            for (auto && field : line)
+            {
+                if (!first)
+                    buf.push_back(field_sep);
+                first = false;
+                detail::append_single(buf, field);
+            }
+        }
+
+        if (add_CR)
+            buf.push_back('\r');
+        buf.push_back('\n');
+    }
+
+    //!\brief Called after a line has been terminated.
+    void end_line()
+    {
+        if (line_idx.has_value())
+        {
+            ++line_idx->n_lines;
+            at_line_start = true;
+        }
+    }
+
     //!\brief The underlying stream object.
-    transparent_ostream stream;
+    transparent_ostream       stream;
     //!\brief The stream iterator.
-    iterator            it;
+    iterator                  it;
+    //!\brief The line index (if one is recorded).
+    std::optional<line_index> line_idx;
+    //!\brief Whether the next write begins a new line.
+    bool                      at_line_start = true;
+    //!\brief Delimiter between fields.
+    char                      field_sep     = '\t';
+    //!\brief Whether to add carriage return characters.
+    bool                      add_CR        = false;
 };
 
 /*!\name Deduction guides
@@ -13,10 +13,18 @@
 
 #pragma once
 
+#include <algorithm>
 #include <filesystem>
+#include <limits>
+#include <map>
+#include <optional>
+#include <ranges>
+#include <string>
+#include <vector>
 
 #include <bio/meta/tag/vtag.hpp>
 
+#include <bio/io/detail/index_gzi.hpp>
 #include <bio/io/detail/index_tabix.hpp>
 #include <bio/io/detail/reader_base.hpp>
 #include <bio/io/format/bcf_input_handler.hpp>
@@ -81,6 +89,9 @@ namespace bio::io::var
  * This region filter requires an index, although region filtering without an index
  * is also available; see bio::io::var::reader_options::region.
  *
+ * Many regions can be queried at once via bio::io::var::reader_options::regions. The index is read only once,
+ * and the reader moves through the file in a single pass.
+ *
  * ### Views on readers
  *
  * Print information for the first five records where quality is better than 23:
@@ -129,48 +140,330 @@ private:
     var::header const * header_ptr = nullptr;
     //!\}
 
-    //!\brief Jump to the region specified in the options.
-    void jump_to_region()
+    /*!\name Region filtering
+     * \brief State of the filter set up by bio::io::var::reader_options::region and
+     * bio::io::var::reader_options::regions.
+     * \{
+     */
+    //!\brief An interval of the region filter.
+    struct region_interval
+    {
+        size_t  chrom = 0; //!< The chromosome; its number in the index or in #region_chroms.
+        int64_t beg   = 0; //!< Begin position (0-based).
+        int64_t end   = 0; //!< End position (exclusive).
+        size_t  chunk = 0; //!< The first merged chunk that holds records of this or any later interval.
+    };
+
+    //!\brief Denotes intervals without records in #region_interval::chunk.
+    static constexpr size_t no_chunk = std::numeric_limits<size_t>::max();
+
+    //!\brief Whether records are filtered by region.
+    bool                                       region_filter  = false;
+    //!\brief The Tabix index; loaded only once and re-used by #reopen().
+    std::optional<io::detail::tabix_index>     index;
+    //!\brief Whether an index file has been looked for.
+    bool                                       index_searched = false;
+    //!\brief The number of every chromosome that has intervals (only used without an index).
+    std::map<std::string, size_t, std::less<>> region_chroms;
+    //!\brief The intervals sorted by chromosome and position; overlapping intervals are merged.
+    std::vector<region_interval>               region_intervals;
+    //!\brief Per chromosome, the first interval that may still overlap with a record.
+    std::vector<size_t>                        region_cursors;
+    //!\brief The number of chromosomes whose intervals have not all been passed (only used without an index).
+    size_t                                     region_chroms_left = 0;
+    //!\brief The chunks of all intervals as virtual offsets; sorted and merged so that blocks are not shared.
+    std::vector<std::pair<uint64_t, uint64_t>> region_chunks;
+    //!\brief The last chunk that was jumped to or whose beginning was passed while reading.
+    size_t                                     region_chunk = 0;
+    //!\brief The on-disk offset of the block that decompression started at with the last jump.
+    uint64_t                                   region_disk_offset = 0;
+    //!\brief The GZI index; only needed if BGZF files are decompressed as GZ (single-threaded).
+    std::optional<io::detail::gzi_index>       gzi;
+    //!\brief The chromosome of the last record (cached for #chrom_number()).
+    std::string                                last_chrom;
+    //!\brief The number of #last_chrom.
+    std::optional<size_t>                      last_chrom_number;
+    //!\brief Whether #last_chrom and #last_chrom_number are set.
+    bool                                       last_chrom_valid = false;
+    //!\brief Chromosome number and position of the last record read.
+    std::pair<size_t, int64_t>                 last_key{};
+    //!\brief The number of records read with #last_key.
+    size_t                                     n_last_key = 0;
+    //!\brief The number of records with #last_key to skip after jumping back.
+    size_t                                     n_replay   = 0;
+    //!\brief Whether records that were read before the last jump are being skipped.
+    bool                                       replaying  = false;
+    //!\}
+
+    //!\brief Read the index file (only once); returns nullptr if there is none.
+    io::detail::tabix_index * load_index()
+    {
+        if (!index_searched)
+        {
+            index_searched = true;
+
+            std::filesystem::path index_file = options.region_index_file;
+
+            // no index file was specified, try ".tbi"
+            if (std::filesystem::path index_file_tmp = stream.filename();
+                index_file.empty() && !index_file_tmp.empty() && std::filesystem::exists(index_file_tmp += ".tbi"))
+            {
+                index_file = index_file_tmp;
+            }
+
+            if (!index_file.empty())
+                index.emplace().read(index_file);
+        }
+
+        return index.has_value() ? &*index : nullptr;
+    }
+
+    //!\brief The number of a chromosome; std::nullopt if no interval can be on it.
+    std::optional<size_t> chrom_number(std::string_view const chrom)
+    {
+        if (!last_chrom_valid || chrom != last_chrom)
+        {
+            last_chrom        = chrom;
+            last_chrom_valid  = true;
+            last_chrom_number = std::nullopt;
+
+            if (index.has_value())
+            {
+                if (auto it = index->names_map.find(chrom); it != index->names_map.end())
+                    last_chrom_number = it->second;
+            }
+            else if (auto it = region_chroms.find(chrom); it != region_chroms.end())
+            {
+                last_chrom_number = it->second;
+            }
+        }
+
+        return last_chrom_number;
+    }
+
+    //!\brief Jump to the beginning of a chunk in #region_chunks.
+    void jump_to_chunk(size_t const chunk)
+    {
+        auto [disk_offset, block_offset] = io::detail::decode_bgz_virtual_offset(region_chunks[chunk].first);
+
+        // seek on-disk
+        stream.seekg_primary(disk_offset);
+        // seek inside block
+        io::detail::fast_istreambuf_iterator<char> it{stream};
+        it.skip_n(block_offset);
+        std::visit([](auto & f) { f.reset_stream(); }, format_handler);
+
+        region_chunk       = chunk;
+        region_disk_offset = disk_offset;
+        n_replay           = n_last_key;
+        replaying          = true;
+    }
+
+    /*!\brief The virtual offset of the next record; 0 if it cannot be determined.
+     * \details
+     *
+     * This is only unknown for streams without a file name that are decompressed as GZ (single-threaded), because
+     * the sizes of the blocks are needed to convert the number of decompressed characters.
+     */
+    uint64_t reached_virtual_offset()
     {
-        std::filesystem::path index_file = options.region_index_file;
+        // positions of compressed streams are relative to the block that decompression started at
+        std::streamoff const off = stream.rdbuf()->pubseekoff(0, std::ios_base::cur, std::ios_base::in);
+        if (off < 0)
+            return 0;
+
+        uint64_t const pos = off;
 
-        // no index file was specified, try ".tbi"
-        if (std::filesystem::path index_file_tmp = stream.filename();
-            index_file.empty() && !index_file_tmp.empty() && std::filesystem::exists(index_file_tmp += ".tbi"))
+        switch (stream.compression())
         {
-            index_file = index_file_tmp;
+            case compression_format::bgzf: // virtual offset
+                return (region_disk_offset << 16) + pos;
+            case compression_format::gz: // number of characters
+                {
+                    if (stream.filename().empty())
+                        return 0;
+
+                    io::detail::load_gzi_index(stream, gzi);
+                    auto it = std::ranges::lower_bound(gzi->blocks,
+                                                       region_disk_offset,
+                                                       {},
+                                                       [](auto const & p) { return p.first; });
+                    return it == gzi->blocks.end() ? 0 : gzi->to_virtual_offset(it->second + pos);
+                }
+            default:
+                return 0;
         }
+    }
+
+    /*!\brief Whether a record has not been seen before.
+     * \details
+     *
+     * The reader only jumps to chunks that begin behind the position it has reached, so records are not read twice.
+     * If that position is unknown (see #reached_virtual_offset()), the reader may have scanned past the beginning of
+     * the next chunk before it jumps there. Records are sorted, so everything up to the last record read (and as many
+     * records at its position as were read before) is skipped after such a jump.
+     */
+    bool is_new_record(size_t const chrom, int64_t const pos)
+    {
+        std::pair<size_t, int64_t> const key{chrom, pos};
 
-        if (!index_file.empty())
+        if (replaying)
         {
-            io::detail::tabix_index index;
-            index.read(index_file);
-            std::vector<std::pair<uint64_t, uint64_t>> chunks = index.reg2chunks(options.region);
-
-            /* IMPLEMENTATION NOTE
-             * We are currently doing a simplified indexed access where we do not process all
-             * possible chunks but just do a linear scan from the beginning of the first overlapping chunk.
-             * This is definitely worse than what htslib is doing, but still very good for the tests performed.
-             * I doubt that we can ever reach htslib's performance fully while using C++ iostreams.
-             */
-
-            // we take the smallest begin-offset
-            uint64_t const min_beg           = std::ranges::min(chunks | std::views::elements<0>);
-            auto [disk_offset, block_offset] = io::detail::decode_bgz_virtual_offset(min_beg);
-
-            // seek on-disk
-            stream.seekg_primary(disk_offset);
-            // seek inside block
-            io::detail::fast_istreambuf_iterator<char> it{stream};
-            it.skip_n(block_offset);
-            std::visit([](auto & f) { f.reset_stream(); }, format_handler);
+            if (key < last_key)
+                return false;
+
+            if (key == last_key && n_replay > 0)
+            {
+                --n_replay;
+                return false;
+            }
+
+            replaying = false;
         }
-        else if (!options.region_index_optional)
+
+        if (key == last_key)
+        {
+            ++n_last_key;
+        }
+        else
+        {
+            last_key   = key;
+            n_last_key = 1;
+        }
+        return true;
+    }
+
+    /*!\brief Set up the region filter and jump to the first region.
+     * \details
+     *
+     * The regions are sorted by chromosome (in the order of the index) and position, and overlapping regions
+     * are merged. The chunks of every region are computed via the index, and all chunks are sorted and merged so that
+     * no two of them share a compressed block. While reading, the reader jumps forward to the first chunk of the
+     * remaining regions whenever it reads a record between regions, and it only jumps if that chunk begins behind the
+     * position that has been reached. Without an index, every chromosome keeps its own cursor and the file is scanned
+     * until all regions have been passed.
+     */
+    void init_region_filter()
+    {
+        std::vector<genomic_region> regions = options.regions;
+        if (!options.region.chrom.empty())
+            regions.push_back(options.region);
+
+        region_filter = !regions.empty();
+        region_chroms.clear();
+        region_intervals.clear();
+        region_cursors.clear();
+        region_chunks.clear();
+        region_chroms_left = 0;
+        region_chunk       = 0;
+        region_disk_offset = 0;
+        last_chrom_valid   = false;
+        last_key           = {};
+        n_last_key         = 0;
+        n_replay           = 0;
+        replaying          = false;
+
+        if (!region_filter)
+            return;
+
+        io::detail::tabix_index * const idx = load_index();
+
+        if (idx == nullptr && !options.region_index_optional)
         {
             throw bio::io::file_open_error{
               "No index file was found. To allow linear-time filtering without an index, "
               "set options.region_index_optional to true."};
         }
+
+        /* number the chromosomes (index order if available) */
+        if (idx == nullptr)
+        {
+            for (genomic_region const & region : regions)
+                region_chroms.emplace(region.chrom, 0);
+
+            size_t c = 0;
+            for (auto & [chrom, n] : region_chroms)
+                n = c++;
+        }
+
+        /* sort and merge the intervals; intervals on chromosomes that are not in the index are dropped */
+        for (genomic_region const & region : regions)
+            if (std::optional<size_t> const c = chrom_number(region.chrom); c.has_value() && region.beg < region.end)
+                region_intervals.push_back({.chrom = *c, .beg = region.beg, .end = region.end});
+
+        std::ranges::sort(region_intervals, {}, [](region_interval const & i) { return std::pair{i.chrom, i.beg}; });
+
+        size_t n = 0;
+        for (region_interval const & i : region_intervals)
+        {
+            if (n > 0 && region_intervals[n - 1].chrom == i.chrom && i.beg <= region_intervals[n - 1].end)
+                region_intervals[n - 1].end = std::max(region_intervals[n - 1].end, i.end);
+            else
+                region_intervals[n++] = i;
+        }
+        region_intervals.resize(n);
+
+        /* set the cursors to the first interval of every chromosome (or the next chromosome's) */
+        size_t const n_chroms = idx != nullptr ? idx->names.size() : region_chroms.size();
+        region_cursors.resize(n_chroms);
+        for (size_t c = 0, i = 0; c < n_chroms; ++c)
+        {
+            while (i < n && region_intervals[i].chrom < c)
+                ++i;
+
+            region_cursors[c] = i;
+            region_chroms_left += (i < n && region_intervals[i].chrom == c);
+        }
+
+        if (idx == nullptr)
+            return;
+
+        /* compute, sort and merge the chunks */
+        std::vector<uint64_t> min_beg(n, std::numeric_limits<uint64_t>::max());
+        for (size_t i = 0; i < n; ++i)
+        {
+            // Tabix supports positions < 2^29
+            constexpr int64_t    max_pos = int64_t{1} << 29;
+            genomic_region const region{.chrom = idx->names[region_intervals[i].chrom],
+                                        .beg   = std::clamp<int64_t>(region_intervals[i].beg, 0, max_pos),
+                                        .end   = std::clamp<int64_t>(region_intervals[i].end, 0, max_pos)};
+
+            std::vector<std::pair<uint64_t, uint64_t>> const chunks = idx->reg2chunks(region);
+
+            for (auto const & chunk : chunks)
+                min_beg[i] = std::min(min_beg[i], chunk.first);
+            region_chunks.insert(region_chunks.end(), chunks.begin(), chunks.end());
+        }
+
+        std::ranges::sort(region_chunks);
+
+        // chunks are merged if they touch the same block, so that no block is decompressed twice
+        size_t n_chunks = 0;
+        for (auto const & chunk : region_chunks)
+        {
+            if (n_chunks > 0 && (chunk.first >> 16) <= (region_chunks[n_chunks - 1].second >> 16))
+                region_chunks[n_chunks - 1].second = std::max(region_chunks[n_chunks - 1].second, chunk.second);
+            else
+                region_chunks[n_chunks++] = chunk;
+        }
+        region_chunks.resize(n_chunks);
+
+        // the records of an interval and all later intervals begin in this chunk or behind it
+        size_t first_chunk = no_chunk;
+        for (size_t i = n; i-- > 0;)
+        {
+            if (min_beg[i] != std::numeric_limits<uint64_t>::max())
+            {
+                auto it = std::ranges::upper_bound(region_chunks | std::views::elements<0>, min_beg[i]);
+                first_chunk = std::min<size_t>(first_chunk, it.base() - region_chunks.begin() - 1);
+            }
+            region_intervals[i].chunk = first_chunk;
+        }
+
+        if (n == 0 || region_intervals[0].chunk == no_chunk)
+            at_end = true;
+        else
+            jump_to_chunk(region_intervals[0].chunk);
     }
 
     //!\brief Initialise the format handler and read first record.
@@ -180,8 +473,7 @@ private:
         std::visit([&](auto f) { format_handler = format_input_handler<decltype(f)>{stream, options}; }, format);
 
         /* region filtering */
-        if (!options.region.chrom.empty())
-            jump_to_region();
+        init_region_filter();
 
         /* read first record */
         read_next_record();
@@ -202,11 +494,11 @@ private:
         assert(!format_handler.valueless_by_exception());
 
         /* regular, unrestricted reading */
-        if (options.region.chrom.empty())
+        if (!region_filter)
         {
             std::visit([&](auto & f) { f.parse_next_record_into(record_buffer); }, format_handler);
         }
-        else /* only read sub-region */
+        else /* only read sub-regions */
         {
             // this record holds the bare minimum to check if regions overlap; always shallow
             using record_t = record<std::string_view,
@@ -220,6 +512,8 @@ private:
                                     meta::ignore_t>;
             record_t temp_record;
 
+            size_t const n = region_intervals.size();
+
             while (true)
             {
                 // at end if we could not read further
@@ -231,33 +525,77 @@ private:
 
                 std::visit([&](auto & f) { f.parse_next_record_into(temp_record); }, format_handler);
 
-                // TODO undo "- 1" if interval notation gets decided on
-                std::weak_ordering ordering =
-                  genomic_region::relative_to(temp_record.chrom,
-                                              temp_record.pos - 1,
-                                              temp_record.pos - 1 + (int64_t)temp_record.ref.size(),
-                                              options.region.chrom,
-                                              options.region.beg,
-                                              options.region.end);
-                if (ordering == std::weak_ordering::less) // records lies before the target region → skip
-                {
+                std::optional<size_t> const c = chrom_number(temp_record.chrom);
+                if (!c.has_value()) // no intervals on this chromosome → skip
                     continue;
-                }
-                else if (ordering == std::weak_ordering::equivalent) // records overlaps target region → take it
+
+                if (index.has_value() && !is_new_record(*c, temp_record.pos)) // already read before the last jump
+                    continue;
+
+                // TODO undo "- 1" if interval notation gets decided on
+                int64_t const beg = temp_record.pos - 1;
+                int64_t const end = beg + (int64_t)temp_record.ref.size();
+
+                // move the cursor past the intervals that end before the record
+                size_t &   cursor = region_cursors[*c];
+                bool const before = cursor < n && region_intervals[cursor].chrom == *c;
+                while (cursor < n && region_intervals[cursor].chrom == *c && region_intervals[cursor].end <= beg)
+                    ++cursor;
+                bool const after = cursor < n && region_intervals[cursor].chrom == *c;
+                region_chroms_left -= (before && !after);
+
+                if (after && region_intervals[cursor].beg < end) // record overlaps an interval → take it
                 {
                     // full parsing of the same record
                     std::visit([&](auto & f) { f.parse_current_record_into(record_buffer); }, format_handler);
                     break;
                 }
-                else if (ordering == std::weak_ordering::greater) // record begins after target region start → at end
+
+                // all intervals have been passed → at end
+                if (region_chroms_left == 0 || (index.has_value() && cursor == n))
                 {
                     at_end = true;
                     break;
                 }
+
+                // record lies between intervals → jump forward if the remaining records are in a later chunk
+                if (index.has_value())
+                {
+                    size_t const chunk = region_intervals[cursor].chunk;
+                    if (chunk == no_chunk)
+                    {
+                        at_end = true;
+                        break;
+                    }
+                    else if (chunk > region_chunk)
+                    {
+                        // the beginning of the chunk may already have been passed while scanning
+                        if (region_chunks[chunk].first > reached_virtual_offset())
+                            jump_to_chunk(chunk);
+                        else
+                            region_chunk = chunk;
+                    }
+                }
             }
         }
     }
 
+    //!\brief Skip records; falls back to reading records if a region is set.
+    uint64_t skip_raw_records(uint64_t const n)
+    {
+        if (!region_filter)
+            return base_t::skip_raw_records(n);
+
+        uint64_t i = 0;
+        for (; i < n; ++i)
+        {
+            read_next_record();
+            if (at_end)
+                break;
+        }
+        return i;
+    }
+
 public:
     //!\brief Inherit the format_type definition.
     using format_type = typename base_t::format_type;
@@ -342,13 +680,38 @@ public:
     /*!\brief Re-create this reader on the specified region.
      * \details
      *
-     * Note that the header is not parsed again.
+     * Note that the header is not parsed again and that the index is only read once per reader.
+     * bio::io::var::reader_options::regions is cleared.
      */
     void reopen(genomic_region const & region)
     {
-        at_end         = false;
         options.region = region;
-        jump_to_region();
+        options.regions.clear();
+        reopen_regions();
+    }
+
+    /*!\brief Re-create this reader on the specified regions.
+     * \details
+     *
+     * Note that the header is not parsed again and that the index is only read once per reader.
+     * bio::io::var::reader_options::region is cleared. See bio::io::var::reader_options::regions for details.
+     */
+    void reopen(std::vector<genomic_region> regions)
+    {
+        options.region  = {};
+        options.regions = std::move(regions);
+        reopen_regions();
+    }
+
+private:
+    //!\brief Implementation of the reopen() overloads for regions.
+    void reopen_regions()
+    {
+        // ensure that the format_handler is created
+        this->begin();
+
+        at_end = false;
+        init_region_filter();
         read_next_record();
     }
 };
@@ -108,8 +108,8 @@ struct reader_options
     /*!\brief Path to the index file [optional, auto-detected if not specified].
      * \details
      *
-     * This option is ignored if no #region is specified, if the file format is uncompressed VCF or the data
-     * are read from standard input.
+     * This option is ignored if neither #region nor #regions are specified, if the file format is uncompressed VCF
+     * or the data are read from standard input.
      *
      * If no path is given, the library will look for `FILE.tbi` where `FILE` is the filename of the input
      * file. CSI-indexes are not (yet) supported.
@@ -118,6 +118,22 @@ struct reader_options
 
     //!\brief Allow linear-time region filtering when no index file is available.
     bool region_index_optional = false;
+
+    /*!\brief Only display records that overlap with at least one of the given regions (ignored if empty).
+     * \details
+     *
+     * This works like #region, but for many regions at once, e.g. the target intervals of an exome read from a BED
+     * file. The regions must be specified as **0-based, half-open intervals**; they may be given in any order and
+     * they may overlap. If #region is also set, it is added to the list.
+     *
+     * Records are returned in the order of the file, and every record is returned only once, even if it overlaps
+     * with multiple regions. To query the regions one after the other instead (so that records may be returned
+     * repeatedly), call bio::io::var::reader::reopen() for every region; the index is only loaded once per reader.
+     *
+     * With an index, the chunks of all regions are sorted and merged, so that the reader only moves forward through
+     * the file and does not decompress the blocks in between regions.
+     */
+    std::vector<genomic_region> regions{};
     //!\}
 
     //!\brief Options that are passed on to the internal stream oject.
@@ -0,0 +1,86 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2022, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2022, Knut Reinert & MPI für molekulare Genetik
+// Copyright (c) 2020-2022, deCODE Genetics
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/bio/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <bio/test/tmp_filename.hpp>
+
+#include <bio/io/detail/bgzf_block_reader.hpp>
+#include <bio/io/stream/transparent_ostream.hpp>
+
+// spans several BGZF blocks
+std::string const data = []()
+{
+    std::string ret;
+    for (size_t i = 0; i < 300'000; ++i)
+        ret.push_back("ACGTNacgtn\n"[(i * i + i / 7) % 11]);
+    return ret;
+}();
+
+TEST(bgzf_block_reader, read)
+{
+    bio::test::tmp_filename filename{"bgzf_block_reader_test.txt.gz"};
+    {
+        bio::io::transparent_ostream ostr{filename.get_path(), {.threads = 2}};
+        ostr << data;
+    }
+
+    bio::io::detail::gzi_index const gzi = bio::io::detail::gzi_index::build(filename.get_path());
+    ASSERT_GT(gzi.blocks.size(), 2u);
+
+    bio::io::detail::bgzf_block_reader reader{filename.get_path()};
+
+    // within blocks, across block boundaries, backwards and repeated
+    uint64_t const boundary = gzi.blocks[2].second;
+    std::vector<std::pair<uint64_t, size_t>> const regions{
+      {           0,      10},
+      {          17,    1000},
+      {boundary - 5,      10},
+      {           3, 200'000},
+      {    boundary,       1},
+      {    boundary,       1},
+      {     299'990,      10},
+      {           0, 300'000}
+    };
+
+    for (auto [offset, n] : regions)
+    {
+        std::string buffer(n, '\0');
+        reader.read(gzi, offset, n, buffer.data());
+        EXPECT_EQ(buffer, data.substr(offset, n)) << offset << ' ' << n;
+    }
+
+    // the block that contains the offset
+    std::string_view const block = reader.read_block(gzi, boundary + 3);
+    EXPECT_EQ(block, std::string_view{data}.substr(boundary + 3, gzi.blocks[3].second - boundary - 3));
+
+    // end of file
+    EXPECT_TRUE(reader.read_block(gzi, data.size()).empty());
+    std::string buffer(20, '\0');
+    EXPECT_THROW(reader.read(gzi, data.size() - 10, 20, buffer.data()), bio::io::unexpected_end_of_input);
+}
+
+TEST(bgzf_block_reader, errors)
+{
+    EXPECT_THROW(bio::io::detail::bgzf_block_reader{"/this/file/does/not/exist.gz"}, bio::io::file_open_error);
+
+    bio::test::tmp_filename filename{"bgzf_block_reader_test.txt"};
+    {
+        std::ofstream ostr{filename.get_path()};
+        ostr << data;
+    }
+
+    bio::io::detail::gzi_index const   gzi;
+    bio::io::detail::bgzf_block_reader reader{filename.get_path()};
+    EXPECT_THROW(reader.read_block(gzi, 0), bio::io::format_error);
+}
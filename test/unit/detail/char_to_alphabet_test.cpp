@@ -0,0 +1,59 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2022, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2022, Knut Reinert & MPI für molekulare Genetik
+// Copyright (c) 2020-2022, deCODE Genetics
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <bio/alphabet/nucleotide/dna4.hpp>
+#include <bio/alphabet/nucleotide/dna5.hpp>
+#include <bio/alphabet/nucleotide/rna5.hpp>
+#include <bio/alphabet/quality/phred42.hpp>
+#include <bio/ranges/views/char_strictly_to.hpp>
+#include <bio/test/expect_range_eq.hpp>
+
+#include <bio/io/detail/char_to_alphabet.hpp>
+
+template <typename alph_t>
+void test_conversion(std::string_view const input)
+{
+    std::vector<alph_t> out{alph_t{}}; // non-empty before
+    bio::io::detail::char_strictly_to_bulk(input, out);
+    EXPECT_RANGE_EQ(out, input | bio::views::char_strictly_to<alph_t>);
+}
+
+template <typename alph_t>
+void test_invalid(std::string_view const input)
+{
+    std::vector<alph_t> out;
+    EXPECT_THROW(bio::io::detail::char_strictly_to_bulk(input, out), bio::alphabet::invalid_char_assignment);
+}
+
+TEST(char_to_alphabet, nucleotides)
+{
+    std::string_view const input = "ACGTTTTACGTAGCTAGCTAGCTAGCTGACTGACTGATCGATCGATCGATCGACGATGATGTAGCTAGCTAACGT";
+    test_conversion<bio::alphabet::dna4>(input);
+    test_conversion<bio::alphabet::dna5>(input);
+    test_conversion<bio::alphabet::dna5>("acgtnNNNNACGT");
+    test_conversion<bio::alphabet::rna5>("ACGUNacgun");
+    test_conversion<bio::alphabet::dna5>("");
+}
+
+TEST(char_to_alphabet, qualities)
+{
+    test_conversion<bio::alphabet::phred42>("!!!!!##$%&'()*+,-./0123456789:;<=>?@AIIIII");
+}
+
+TEST(char_to_alphabet, invalid)
+{
+    test_invalid<bio::alphabet::dna5>("ACGTNACGTXACGT");
+    test_invalid<bio::alphabet::dna4>("ACGT ACGT");
+    test_invalid<bio::alphabet::phred42>("IIII\x7f");
+}
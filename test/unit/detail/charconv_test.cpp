@@ -0,0 +1,132 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2022, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2022, Knut Reinert & MPI für molekulare Genetik
+// Copyright (c) 2020-2022, deCODE Genetics
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <bio/io/detail/charconv.hpp>
+
+template <typename t>
+t from_chars_reference(std::string_view const input)
+{
+    t res{};
+    std::from_chars(input.data(), input.data() + input.size(), res);
+    return res;
+}
+
+TEST(charconv, integers)
+{
+    for (std::string_view s : {"0", "1", "7", "42", "1234", "99999999", "12345678", "00000001", "-1", "-99999999"})
+    {
+        int32_t i = 0;
+        bio::io::detail::string_to_number(s, i);
+        EXPECT_EQ(i, from_chars_reference<int32_t>(s)) << s;
+
+        int64_t l = 0;
+        bio::io::detail::string_to_number(s, l);
+        EXPECT_EQ(l, from_chars_reference<int64_t>(s)) << s;
+    }
+
+    // longer than the fast path
+    int64_t l = 0;
+    bio::io::detail::string_to_number("1234567890123", l);
+    EXPECT_EQ(l, 1234567890123ll);
+
+    // limits of small types
+    int8_t i8 = 0;
+    bio::io::detail::string_to_number("-128", i8);
+    EXPECT_EQ(i8, -128);
+    bio::io::detail::string_to_number("127", i8);
+    EXPECT_EQ(i8, 127);
+    EXPECT_THROW(bio::io::detail::string_to_number("128", i8), bio::io::bio_error);
+    EXPECT_THROW(bio::io::detail::string_to_number("-129", i8), bio::io::bio_error);
+
+    uint16_t u16 = 0;
+    bio::io::detail::string_to_number("65535", u16);
+    EXPECT_EQ(u16, 65535);
+    EXPECT_THROW(bio::io::detail::string_to_number("65536", u16), bio::io::bio_error);
+    EXPECT_THROW(bio::io::detail::string_to_number("-1", u16), bio::io::bio_error);
+}
+
+TEST(charconv, integers_invalid)
+{
+    int32_t i = 0;
+    for (std::string_view s : {"", "-", "+1", "1a", "a1", "12 ", " 12", "1.0", "1:", "/", "12345678912345"})
+        EXPECT_THROW(bio::io::detail::string_to_number(s, i), bio::io::bio_error) << s;
+}
+
+TEST(charconv, floats)
+{
+    for (std::string_view s : {"0",     "-0",     "0.0",     "1",     "1.",      ".5",      "29.5",   "0.125",
+                               "0.1",   "-0.1",   "3.14159", "1e5",   "1E-5",    "2.5e+3",  "1e22",   "1e-22",
+                               "1e23",  "1e-300", "123456789012345678", "0.30000000000000004", "9007199254740993",
+                               "nan",   "inf",    "-inf",    "12345678901234567890.5"})
+    {
+        double d = 0;
+        bio::io::detail::string_to_number(s, d);
+        double ref = from_chars_reference<double>(s);
+        if (std::isnan(ref))
+        {
+            EXPECT_TRUE(std::isnan(d)) << s;
+        }
+        else
+        {
+            EXPECT_EQ(d, ref) << s;
+            EXPECT_EQ(std::signbit(d), std::signbit(ref)) << s;
+        }
+
+        if (s == "1e-300") // out of range for float
+            continue;
+
+        float f = 0;
+        bio::io::detail::string_to_number(s, f);
+        float reff = from_chars_reference<float>(s);
+        if (std::isnan(reff))
+            EXPECT_TRUE(std::isnan(f)) << s;
+        else
+            EXPECT_EQ(f, reff) << s;
+    }
+}
+
+TEST(charconv, floats_invalid)
+{
+    double d = 0;
+    for (std::string_view s : {"", "-", ".", "e5", "1e", "1e+", "+1", "1.0.0", "1,0", "1.0 "})
+        EXPECT_THROW(bio::io::detail::string_to_number(s, d), bio::io::bio_error) << s;
+
+    EXPECT_THROW(bio::io::detail::string_to_number("1e400", d), bio::io::bio_error);
+}
+
+TEST(charconv, string_to_numbers)
+{
+    std::vector<int32_t> ints;
+    bio::io::detail::string_to_numbers("1,2,3,4", ',', ints);
+    EXPECT_EQ(ints, (std::vector<int32_t>{1, 2, 3, 4}));
+
+    ints.clear();
+    bio::io::detail::string_to_numbers("-7", ',', ints);
+    EXPECT_EQ(ints, (std::vector<int32_t>{-7}));
+
+    ints.clear();
+    bio::io::detail::string_to_numbers("1,.,3", ',', ints, ".", -1);
+    EXPECT_EQ(ints, (std::vector<int32_t>{1, -1, 3}));
+
+    std::vector<float> floats;
+    bio::io::detail::string_to_numbers("0.5:1e-3:2", ':', floats);
+    EXPECT_EQ(floats, (std::vector<float>{0.5f, 1e-3f, 2.0f}));
+
+    ints.clear();
+    EXPECT_THROW(bio::io::detail::string_to_numbers("1,,3", ',', ints), bio::io::bio_error);
+    EXPECT_THROW(bio::io::detail::string_to_numbers("1,2,", ',', ints), bio::io::bio_error);
+    EXPECT_THROW(bio::io::detail::string_to_numbers("1,.,3", ',', ints), bio::io::bio_error);
+}
@@ -7,6 +7,8 @@
 // -----------------------------------------------------------------------------------------------------
 
 #include <ranges>
+#include <string>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -157,3 +159,33 @@ TEST(view_eager_split, concepts)
     EXPECT_FALSE(std::ranges::common_range<decltype(v)>);
     EXPECT_FALSE((std::ranges::output_range<decltype(v), std::string_view>));
 }
+
+TEST(view_eager_split, long_input)
+{
+    // elements of varying size so that delimiters are found at all positions relative to vector registers
+    std::string              s;
+    std::vector<std::string> expected;
+    for (size_t i = 0; i < 100; ++i)
+    {
+        expected.push_back(std::string(i % 37, 'A' + (i % 26)));
+        s += expected.back();
+        s.push_back(':');
+    }
+    s.pop_back();
+
+    std::vector<std::string> split;
+    for (std::string_view const elem : s | bio::io::detail::eager_split(':'))
+        split.emplace_back(elem);
+
+    EXPECT_EQ(split, expected);
+
+    // quoted delimiters far from the opening quote
+    std::string q = "\"" + std::string(100, ',') + "\"," + std::string(50, 'X');
+    split.clear();
+    for (std::string_view const elem : q | bio::io::detail::eager_split(',', true))
+        split.emplace_back(elem);
+
+    ASSERT_EQ(split.size(), 2u);
+    EXPECT_EQ(split[0], "\"" + std::string(100, ',') + "\"");
+    EXPECT_EQ(split[1], std::string(50, 'X'));
+}
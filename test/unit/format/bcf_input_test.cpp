@@ -53,6 +53,24 @@ TEST(bcf, iterator)
     EXPECT_TRUE(it == std::default_sentinel);
 }
 
+TEST(bcf, iterator_skip)
+{
+    std::istringstream           istream{static_cast<std::string>(example_from_spec_bcf)};
+    bio::io::transparent_istream str{istream};
+
+    bio::io::detail::bcf_input_iterator it{str};
+    EXPECT_EQ(it->first.size(), 91ull);
+
+    EXPECT_EQ(it.skip(2), 2ull);
+    ++it;
+    EXPECT_TRUE(it != std::default_sentinel);
+    EXPECT_EQ(it->first.size(), 71ull);
+
+    EXPECT_EQ(it.skip(5), 1ull);
+    ++it;
+    EXPECT_TRUE(it == std::default_sentinel);
+}
+
 TEST(bcf, iterator_underflow)
 {
     bio::test::tmp_filename filename{"bcf_iterator_overflow.unbcf"};
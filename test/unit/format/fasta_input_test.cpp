@@ -6,6 +6,7 @@
 // -----------------------------------------------------------------------------------------------------
 
 #include <algorithm>
+#include <fstream>
 #include <sstream>
 
 #include <gtest/gtest.h>
@@ -15,8 +16,10 @@
 #include <bio/alphabet/quality/phred42.hpp>
 #include <bio/test/expect_range_eq.hpp>
 #include <bio/test/expect_same_type.hpp>
+#include <bio/test/tmp_filename.hpp>
 
 #include <bio/io/format/fasta_input_handler.hpp>
+#include <bio/io/stream/transparent_istream.hpp>
 
 using namespace bio::alphabet::literals;
 using std::literals::string_view_literals::operator""sv;
@@ -164,6 +167,114 @@ ACGT9T5T2A
     do_read_test(input);
 }
 
+TEST_F(read, zero_copy)
+{
+    std::string input =
+      R"raw(>ID1
+ACGTTTTTTTTTTTTTTT
+>ID2
+ACGTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTT
+
+>ID3 lala
+ACGTTTA
+)raw";
+
+    std::istringstream istream{input};
+    auto * stream_buf = reinterpret_cast<bio::io::detail::stream_buffer_exposer<char> *>(istream.rdbuf());
+
+    bio::io::format_input_handler<bio::io::fasta>          input_handler{istream};
+    bio::io::seq::record<std::string_view, std::string_view> rec;
+
+    for (unsigned i = 0; i < 3; ++i)
+    {
+        input_handler.parse_next_record_into(rec);
+        EXPECT_RANGE_EQ(rec.id, ids[i]);
+        EXPECT_RANGE_EQ(rec.seq | bio::views::char_strictly_to<bio::alphabet::dna5>, seqs[i]);
+
+        if (i < 2) // the last record is copied, because the end of the stream cannot be detected in the buffer
+        {
+            EXPECT_GE(rec.seq.data(), stream_buf->eback());
+            EXPECT_LT(rec.seq.data(), stream_buf->egptr());
+        }
+    }
+}
+
+TEST_F(read, buffer_boundaries)
+{
+    std::string input =
+      ">ID1\r\nACGTTTTTTT\r\nTTTTTTTT\r\n>ID2\nACGTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTT\n"
+      ">ID3 lala\nACG 12 TTTA\n\n";
+
+    bio::test::tmp_filename filename{"fasta_input_test.fasta"};
+    {
+        std::ofstream ostream{filename.get_path()};
+        for (size_t i = 0; i < 100; ++i)
+            ostream << input;
+    }
+
+    // small buffers lead to records crossing the buffer boundaries
+    for (size_t buffer_size : {7ul, 64ul, 1000ul, 1024ul * 1024ul})
+    {
+        bio::io::transparent_istream istream{filename.get_path(), {.buffer1_size = buffer_size}};
+
+        bio::io::format_input_handler<bio::io::fasta>     input_handler{istream};
+        bio::io::seq::record<std::string_view, std::string> rec;
+
+        for (size_t i = 0; i < 300; ++i)
+        {
+            input_handler.parse_next_record_into(rec);
+            EXPECT_RANGE_EQ(rec.id, ids[i % 3]) << buffer_size << ' ' << i;
+            EXPECT_RANGE_EQ(rec.seq | bio::views::char_strictly_to<bio::alphabet::dna5>, seqs[i % 3]);
+        }
+    }
+}
+
+TEST_F(read, ignored_fields)
+{
+    std::string input =
+      ">ID1\r\nACGTTTTTTT\r\nTTTTTTTT\r\n>ID2\nACGTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTT\n"
+      ">ID3 lala\nACG 12 TTTA\n\n";
+
+    bio::test::tmp_filename filename{"fasta_input_test.fasta"};
+    {
+        std::ofstream ostream{filename.get_path()};
+        for (size_t i = 0; i < 100; ++i)
+            ostream << input;
+    }
+
+    using bio::meta::ignore_t;
+
+    for (size_t buffer_size : {7ul, 64ul, 1024ul * 1024ul})
+    {
+        bio::io::transparent_istream istream{filename.get_path(), {.buffer1_size = buffer_size}};
+        bio::io::transparent_istream istream2{filename.get_path(), {.buffer1_size = buffer_size}};
+
+        bio::io::format_input_handler<bio::io::fasta> input_handler{istream};
+        bio::io::format_input_handler<bio::io::fasta> input_handler2{istream2};
+        bio::io::seq::record<std::string, ignore_t>   id_rec;
+        bio::io::seq::record<ignore_t, std::string>   seq_rec;
+
+        for (size_t i = 0; i < 300; ++i)
+        {
+            input_handler.parse_next_record_into(id_rec);
+            EXPECT_RANGE_EQ(id_rec.id, ids[i % 3]) << buffer_size << ' ' << i;
+            input_handler2.parse_next_record_into(seq_rec);
+            EXPECT_RANGE_EQ(seq_rec.seq | bio::views::char_strictly_to<bio::alphabet::dna5>, seqs[i % 3]);
+        }
+        EXPECT_EQ(istream.peek(), std::char_traits<char>::eof());
+    }
+
+    // records without sequence are still detected
+    for (std::string_view const input2 : {">foo\n>bar\nACGT\n", ">foo\r\n\r\n>bar\nACGT\n"})
+    {
+        std::istringstream                            istream{std::string{input2}};
+        bio::io::format_input_handler<bio::io::fasta> input_handler{istream};
+        bio::io::seq::record<std::string, ignore_t>   rec;
+
+        EXPECT_THROW(input_handler.parse_next_record_into(rec), bio::io::parse_error);
+    }
+}
+
 TEST_F(read, old_id_style)
 {
     std::string input =
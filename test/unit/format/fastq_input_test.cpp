@@ -6,6 +6,7 @@
 // -----------------------------------------------------------------------------------------------------
 
 #include <algorithm>
+#include <fstream>
 #include <sstream>
 
 #include <gtest/gtest.h>
@@ -14,8 +15,10 @@
 #include <bio/alphabet/quality/phred42.hpp>
 #include <bio/test/expect_range_eq.hpp>
 #include <bio/test/expect_same_type.hpp>
+#include <bio/test/tmp_filename.hpp>
 
 #include <bio/io/format/fastq_input_handler.hpp>
+#include <bio/io/stream/transparent_istream.hpp>
 
 using namespace bio::alphabet::literals;
 using std::literals::string_view_literals::operator""sv;
@@ -135,6 +138,164 @@ ACGTTTA
     do_read_test(input);
 }
 
+TEST_F(read, zero_copy)
+{
+    std::istringstream istream{default_input};
+    auto * stream_buf = reinterpret_cast<bio::io::detail::stream_buffer_exposer<char> *>(istream.rdbuf());
+
+    bio::io::format_input_handler<bio::io::fastq>                              input_handler{istream};
+    bio::io::seq::record<std::string_view, std::string_view, std::string_view> rec;
+
+    for (unsigned i = 0; i < 3; ++i)
+    {
+        input_handler.parse_next_record_into(rec);
+        EXPECT_RANGE_EQ(rec.id, ids[i]);
+
+        // the fields point into the stream buffer
+        EXPECT_GE(rec.id.data(), stream_buf->eback());
+        EXPECT_LT(rec.id.data(), stream_buf->egptr());
+        EXPECT_GE(rec.seq.data(), stream_buf->eback());
+        EXPECT_LT(rec.seq.data(), stream_buf->egptr());
+        EXPECT_GE(rec.qual.data(), stream_buf->eback());
+        EXPECT_LT(rec.qual.data(), stream_buf->egptr());
+    }
+}
+
+TEST_F(read, buffer_boundaries)
+{
+    bio::test::tmp_filename filename{"fastq_input_test.fastq"};
+    {
+        std::ofstream ostream{filename.get_path()};
+        for (size_t i = 0; i < 100; ++i)
+            ostream << default_input;
+    }
+
+    // small buffers lead to records crossing the buffer boundaries
+    for (size_t buffer_size : {7ul, 64ul, 1000ul, 1024ul * 1024ul})
+    {
+        bio::io::transparent_istream istream{filename.get_path(), {.buffer1_size = buffer_size}};
+
+        bio::io::format_input_handler<bio::io::fastq>                        input_handler{istream};
+        bio::io::seq::record<std::string_view, std::string_view, std::string> rec;
+
+        for (size_t i = 0; i < 300; ++i)
+        {
+            input_handler.parse_next_record_into(rec);
+            EXPECT_RANGE_EQ(rec.id, ids[i % 3]) << buffer_size << ' ' << i;
+            EXPECT_RANGE_EQ(rec.seq | bio::views::char_strictly_to<bio::alphabet::dna5>, seqs[i % 3]);
+            EXPECT_RANGE_EQ(rec.qual | bio::views::char_strictly_to<bio::alphabet::phred42>, quals[i % 3]);
+        }
+    }
+}
+
+TEST_F(read, ignored_fields)
+{
+    bio::test::tmp_filename filename{"fastq_input_test.fastq"};
+    {
+        std::ofstream ostream{filename.get_path()};
+        for (size_t i = 0; i < 100; ++i)
+            ostream << default_input;
+    }
+
+    using bio::meta::ignore_t;
+
+    // small buffers lead to records being read via the low-level iterator
+    for (size_t buffer_size : {7ul, 64ul, 1024ul * 1024ul})
+    {
+        auto check = [&]<typename id_t, typename seq_t, typename qual_t>(bio::io::seq::record<id_t, seq_t, qual_t> rec)
+        {
+            bio::io::transparent_istream                  istream{filename.get_path(), {.buffer1_size = buffer_size}};
+            bio::io::format_input_handler<bio::io::fastq> input_handler{istream};
+
+            for (size_t i = 0; i < 300; ++i)
+            {
+                input_handler.parse_next_record_into(rec);
+                if constexpr (!std::same_as<id_t, ignore_t>)
+                {
+                    EXPECT_RANGE_EQ(rec.id, ids[i % 3]) << buffer_size << ' ' << i;
+                }
+                if constexpr (!std::same_as<seq_t, ignore_t>)
+                {
+                    EXPECT_RANGE_EQ(rec.seq | bio::views::char_strictly_to<bio::alphabet::dna5>, seqs[i % 3]);
+                }
+                if constexpr (!std::same_as<qual_t, ignore_t>)
+                {
+                    EXPECT_RANGE_EQ(rec.qual | bio::views::char_strictly_to<bio::alphabet::phred42>, quals[i % 3]);
+                }
+            }
+            EXPECT_EQ(istream.peek(), std::char_traits<char>::eof());
+        };
+
+        check(bio::io::seq::record<ignore_t, std::string, ignore_t>{});
+        check(bio::io::seq::record<ignore_t, std::string_view, ignore_t>{});
+        check(bio::io::seq::record<std::string, ignore_t, ignore_t>{});
+        check(bio::io::seq::record<ignore_t, ignore_t, std::string>{});
+        check(bio::io::seq::record<std::string_view, std::string, ignore_t>{});
+    }
+
+    // ignored qualities are not validated, but their length is checked
+    for (size_t buffer_size : {7ul, 1024ul * 1024ul})
+    {
+        bio::test::tmp_filename filename2{"fastq_input_test2.fastq"};
+        {
+            std::ofstream ostream{filename2.get_path()};
+            ostream << "@ID1\nACGT\n+\n! \x01\x7F\n@ID2\nACGT\n+\n!!!!!\n";
+        }
+
+        bio::io::transparent_istream                  istream{filename2.get_path(), {.buffer1_size = buffer_size}};
+        bio::io::format_input_handler<bio::io::fastq> input_handler{istream};
+        bio::io::seq::record<ignore_t, std::string, ignore_t> rec;
+
+        EXPECT_NO_THROW(input_handler.parse_next_record_into(rec));
+        EXPECT_EQ(rec.seq, "ACGT");
+        EXPECT_THROW(input_handler.parse_next_record_into(rec), bio::io::parse_error);
+    }
+}
+
+TEST_F(read, long_records)
+{
+    // records of several megabases cross many buffer boundaries
+    std::string long_seq(3'000'000, 'A');
+    std::string long_qual(long_seq.size(), 'I');
+    for (size_t i = 0; i < long_seq.size(); i += 7)
+    {
+        long_seq[i]  = 'C';
+        long_qual[i] = '#';
+    }
+
+    for (std::string_view const eol : {"\n", "\r\n"})
+    {
+        bio::test::tmp_filename filename{"fastq_input_test.fastq"};
+        {
+            std::ofstream ostream{filename.get_path(), std::ios::binary};
+            for (size_t i = 0; i < 2; ++i)
+                ostream << "@long" << eol << long_seq << eol << '+' << eol << long_qual << eol;
+            ostream << "@short" << eol << "ACGT" << eol << '+' << eol << "!!!!";
+        }
+
+        for (size_t buffer_size : {1000ul, 1024ul * 1024ul})
+        {
+            bio::io::transparent_istream istream{filename.get_path(), {.buffer1_size = buffer_size}};
+
+            bio::io::format_input_handler<bio::io::fastq>                    input_handler{istream};
+            bio::io::seq::record<std::string, std::string, std::string_view> rec;
+
+            for (size_t i = 0; i < 2; ++i)
+            {
+                input_handler.parse_next_record_into(rec);
+                EXPECT_EQ(rec.id, "long");
+                EXPECT_TRUE(rec.seq == long_seq) << buffer_size;
+                EXPECT_TRUE(rec.qual == long_qual) << buffer_size;
+            }
+
+            input_handler.parse_next_record_into(rec);
+            EXPECT_EQ(rec.id, "short");
+            EXPECT_EQ(rec.seq, "ACGT");
+            EXPECT_EQ(rec.qual, "!!!!");
+        }
+    }
+}
+
 TEST_F(read, double_id)
 {
     std::string input =
@@ -195,9 +356,28 @@ TEST_F(read, empty_seq)
     EXPECT_TRUE(std::ranges::empty(rec.qual));
 }
 
+TEST_F(read, empty_seq_zero_copy)
+{
+    std::string const input = "@ID1\n\n+\n\n@ID2\n\n+\n\n";
+
+    std::istringstream                                                         istream{input};
+    bio::io::format_input_handler<bio::io::fastq>                              input_handler{istream};
+    bio::io::seq::record<std::string_view, std::string_view, std::string_view> rec;
+
+    for (std::string_view const id : {"ID1"sv, "ID2"sv})
+    {
+        input_handler.parse_next_record_into(rec);
+        EXPECT_RANGE_EQ(rec.id, id);
+        EXPECT_TRUE(std::ranges::empty(rec.seq));
+        EXPECT_TRUE(std::ranges::empty(rec.qual));
+    }
+}
+
 struct options_t
 {
-    bool truncate_ids = false;
+    bool    compute_qual_stats = false;
+    uint8_t qual_offset        = 33;
+    bool    truncate_ids       = false;
 };
 
 TEST_F(read, truncate_ids_off)
@@ -244,6 +424,66 @@ TEST_F(read, truncate_ids_on)
     EXPECT_RANGE_EQ(rec.qual, quals[2]);
 }
 
+TEST_F(read, qual_offset_64)
+{
+    // Phred+33 qualities shifted by 31
+    std::string input = default_input;
+    for (size_t line_begin = 0, line_no = 0; line_begin < input.size(); ++line_no)
+    {
+        size_t const line_end = input.find('\n', line_begin);
+        if (line_no % 4 == 3)
+            std::ranges::for_each(input.begin() + line_begin, input.begin() + line_end, [](char & c) { c += 31; });
+        line_begin = line_end + 1;
+    }
+
+    bio::test::tmp_filename filename{"fastq_qual_offset.fastq"};
+    {
+        std::ofstream filecreator{filename.get_path(), std::ios::out | std::ios::binary};
+        filecreator << input;
+    }
+
+    for (size_t buffer_size : {7ul, 1ul << 16})
+    {
+        bio::io::transparent_istream                  istream{filename.get_path(), {.buffer1_size = buffer_size}};
+        bio::io::format_input_handler<bio::io::fastq> input_handler{istream, options_t{.qual_offset = 64}};
+        default_rec_t                                 rec;
+
+        for (unsigned i = 0; i < 3; ++i)
+        {
+            input_handler.parse_next_record_into(rec);
+            EXPECT_RANGE_EQ(rec.qual, quals[i]);
+        }
+    }
+
+    std::istringstream                            istream{default_input};
+    bio::io::format_input_handler<bio::io::fastq> input_handler{istream, options_t{.qual_offset = 64}};
+    default_rec_t                                 rec;
+    EXPECT_THROW(input_handler.parse_next_record_into(rec), bio::io::parse_error);
+}
+
+TEST_F(read, qual_stats)
+{
+    std::istringstream                            istream{default_input};
+    bio::io::format_input_handler<bio::io::fastq> input_handler{istream, options_t{.compute_qual_stats = true}};
+    default_rec_t                                 rec;
+
+    for (unsigned i = 0; i < 3; ++i)
+    {
+        input_handler.parse_next_record_into(rec);
+
+        double  sum = 0;
+        uint8_t min = 255;
+        for (bio::alphabet::phred42 const q : quals[i])
+        {
+            sum += q.to_phred();
+            min = std::min<uint8_t>(min, q.to_phred());
+        }
+
+        EXPECT_DOUBLE_EQ(input_handler.current_qual_stats().mean, sum / quals[i].size());
+        EXPECT_EQ(input_handler.current_qual_stats().min, min);
+    }
+}
+
 // ----------------------------------------------------------------------------
 // failure
 // ----------------------------------------------------------------------------
@@ -292,6 +532,30 @@ ACGTTTTTTTTTTTTTTT
     default_rec_t                                 rec;
 
     EXPECT_THROW(input_handler.parse_next_record_into(rec), bio::io::parse_error);
+
+    // qualities shorter or longer than the sequence and followed by another record
+    for (std::string_view const qual : {"!!!", "!!!!!", "!!!\r"})
+    {
+        std::string const input2 = "@ID1\nACGT\n+\n" + std::string{qual} + "\n@ID2\nACGT\n+\n!!!!\n";
+        std::istringstream                            istream2{input2};
+        bio::io::format_input_handler<bio::io::fastq> input_handler2{istream2};
+        EXPECT_THROW(input_handler2.parse_next_record_into(rec), bio::io::parse_error) << qual;
+    }
+}
+
+TEST_F(read, fail_zero_copy)
+{
+    // the malformed records lie completely in the stream buffer
+    for (std::string const input : {"foo\nACGT\n+\n!!!!\n",
+                                    "@foo\nACGT\nbar\n!!!!\n",
+                                    "@ID1\nACGT\n+\n!!!\n@ID2\nACGT\n+\n!!!!\n"})
+    {
+        std::istringstream                                                         istream{input};
+        bio::io::format_input_handler<bio::io::fastq>                              input_handler{istream};
+        bio::io::seq::record<std::string_view, std::string_view, std::string_view> rec;
+
+        EXPECT_THROW(input_handler.parse_next_record_into(rec), bio::io::parse_error) << input;
+    }
 }
 
 TEST_F(read, fail_illegal_alphabet)
@@ -306,3 +570,14 @@ TEST_F(read, fail_illegal_alphabet)
 
     EXPECT_THROW(input_handler.parse_next_record_into(rec), bio::alphabet::invalid_char_assignment);
 }
+
+TEST_F(read, fail_illegal_qualities)
+{
+    std::string input{"@foo\nACGT\n+\n!! !\n"};
+
+    std::istringstream                            istream{input};
+    bio::io::format_input_handler<bio::io::fastq> input_handler{istream};
+    default_rec_t                                 rec;
+
+    EXPECT_THROW(input_handler.parse_next_record_into(rec), bio::io::parse_error);
+}
@@ -0,0 +1,130 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2022, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2022, Knut Reinert & MPI für molekulare Genetik
+// Copyright (c) 2020-2022, deCODE Genetics
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/bio/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#pragma once
+
+#include <cctype>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+//=============================================================================
+// Sequences (IDs and the characters returned by the reader)
+//=============================================================================
+
+inline std::vector<std::pair<std::string, std::string>> const twobit_seqs{
+  {"chr1",  "ACGTNNNNacgtACGTA"                                                      },
+  {"chrM",  "nnnnGATTACAggccNNttA"                                                   },
+  {"empty", ""                                                                       },
+  {"chr2",  "TTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTCCGA"},
+};
+
+//=============================================================================
+// Create a 2bit file
+//=============================================================================
+
+/* The UCSC tools only create little-endian files with version 0, but the format allows for both byte-orders and
+ * version 1 has 64bit offsets; so the file is created here instead of being stored.
+ */
+inline std::string make_twobit(std::vector<std::pair<std::string, std::string>> const & seqs,
+                               bool const                                              big_endian = false,
+                               uint32_t const                                          version    = 0)
+{
+    std::string ret;
+
+    auto append = [&](uint64_t const value, size_t const size)
+    {
+        for (size_t i = 0; i < size; ++i)
+            ret.push_back(static_cast<char>(value >> (8 * (big_endian ? size - 1 - i : i))));
+    };
+
+    // runs of characters that satisfy the predicate
+    auto blocks = [](std::string const & seq, auto pred)
+    {
+        std::vector<std::pair<uint32_t, uint32_t>> ret;
+        for (size_t i = 0; i < seq.size(); ++i)
+        {
+            if (!pred(seq[i]))
+                continue;
+            if (ret.empty() || ret.back().first + ret.back().second != i)
+                ret.emplace_back(i, 0);
+            ++ret.back().second;
+        }
+        return ret;
+    };
+
+    auto append_blocks = [&](std::vector<std::pair<uint32_t, uint32_t>> const & bl)
+    {
+        append(bl.size(), 4);
+        for (auto [start, size] : bl)
+            append(start, 4);
+        for (auto [start, size] : bl)
+            append(size, 4);
+    };
+
+    /* header */
+    append(0x1A412743, 4);
+    append(version, 4);
+    append(seqs.size(), 4);
+    append(0, 4);
+
+    /* index */
+    size_t const offset_size = version == 0 ? 4 : 8;
+    uint64_t     offset      = ret.size();
+    for (auto const & [id, seq] : seqs)
+        offset += 1 + id.size() + offset_size;
+
+    for (auto const & [id, seq] : seqs)
+    {
+        ret.push_back(static_cast<char>(id.size()));
+        ret += id;
+        append(offset, offset_size);
+
+        auto const n_blocks    = blocks(seq, [](char const c) { return c == 'N' || c == 'n'; });
+        auto const mask_blocks = blocks(seq, [](char const c) { return std::islower(c); });
+        offset += 16 + 8 * (n_blocks.size() + mask_blocks.size()) + (seq.size() + 3) / 4;
+    }
+
+    /* sequences */
+    for (auto const & [id, seq] : seqs)
+    {
+        append(seq.size(), 4);
+        append_blocks(blocks(seq, [](char const c) { return c == 'N' || c == 'n'; }));
+        append_blocks(blocks(seq, [](char const c) { return std::islower(c); }));
+        append(0, 4);
+
+        for (size_t i = 0; i < seq.size(); i += 4)
+        {
+            uint8_t byte = 0;
+            for (size_t j = i; j < i + 4; ++j)
+            {
+                uint8_t code = 0; // T, N and padding
+                if (j < seq.size())
+                {
+                    switch (std::toupper(seq[j]))
+                    {
+                        case 'C':
+                            code = 1;
+                            break;
+                        case 'A':
+                            code = 2;
+                            break;
+                        case 'G':
+                            code = 3;
+                            break;
+                    }
+                }
+                byte = (byte << 2) | code;
+            }
+            ret.push_back(static_cast<char>(byte));
+        }
+    }
+
+    return ret;
+}
@@ -0,0 +1,154 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2022, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2022, Knut Reinert & MPI für molekulare Genetik
+// Copyright (c) 2020-2022, deCODE Genetics
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/bio/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <cctype>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <bio/alphabet/nucleotide/dna5.hpp>
+#include <bio/test/expect_range_eq.hpp>
+
+#include <bio/io/format/twobit_input_handler.hpp>
+
+#include "twobit_data.hpp"
+
+using namespace bio::alphabet::literals;
+
+TEST(twobit_input, read)
+{
+    for (auto [big_endian, version] : {std::pair{false, 0u}, {true, 0u}, {false, 1u}, {true, 1u}})
+    {
+        std::istringstream                             istream{make_twobit(twobit_seqs, big_endian, version)};
+        bio::io::format_input_handler<bio::io::twobit> handler{istream};
+
+        bio::io::seq::record<std::string, std::string, std::string> rec;
+        for (auto const & [id, seq] : twobit_seqs)
+        {
+            handler.parse_next_record_into(rec);
+            EXPECT_EQ(rec.id, id);
+            EXPECT_EQ(rec.seq, seq);
+            EXPECT_TRUE(rec.qual.empty());
+        }
+
+        EXPECT_EQ(istream.peek(), std::char_traits<char>::eof());
+    }
+}
+
+TEST(twobit_input, read_dna5)
+{
+    std::istringstream                             istream{make_twobit(twobit_seqs)};
+    bio::io::format_input_handler<bio::io::twobit> handler{istream};
+
+    bio::io::seq::record<std::string, std::vector<bio::alphabet::dna5>, std::string> rec;
+    handler.parse_next_record_into(rec);
+    EXPECT_RANGE_EQ(rec.seq, "ACGTNNNNACGTACGTA"_dna5);
+}
+
+TEST(twobit_input, skip_records)
+{
+    std::istringstream                             istream{make_twobit(twobit_seqs)};
+    bio::io::format_input_handler<bio::io::twobit> handler{istream};
+
+    EXPECT_EQ(handler.skip_records(2), 2ull);
+
+    bio::io::seq::record<std::string, std::string, std::string> rec;
+    handler.parse_next_record_into(rec);
+    EXPECT_EQ(rec.id, twobit_seqs[2].first);
+    EXPECT_EQ(rec.seq, twobit_seqs[2].second);
+
+    EXPECT_EQ(handler.skip_records(5), 1ull);
+    EXPECT_EQ(handler.skip_records(5), 0ull);
+}
+
+TEST(twobit_input, fetch)
+{
+    std::istringstream                             istream{make_twobit(twobit_seqs, true, 1)};
+    bio::io::format_input_handler<bio::io::twobit> handler{istream};
+
+    EXPECT_RANGE_EQ(handler.sequence_names(),
+                    (std::vector<std::string_view>{"chr1", "chrM", "empty", "chr2"}));
+
+    auto seek = [&](uint64_t const offset)
+    {
+        istream.clear();
+        istream.seekg(offset);
+    };
+
+    std::string out;
+    for (auto const & [id, seq] : twobit_seqs)
+    {
+        // every begin and end position, so that all offsets within the packed bytes are covered
+        for (int64_t beg = 0; beg <= static_cast<int64_t>(seq.size()); ++beg)
+        {
+            for (int64_t end = beg; end <= static_cast<int64_t>(seq.size()); ++end)
+            {
+                handler.fetch(bio::io::genomic_region{.chrom = id, .beg = beg, .end = end}, out, seek);
+                EXPECT_EQ(out, seq.substr(beg, end - beg)) << id << ':' << beg << '-' << end;
+            }
+        }
+    }
+
+    // clamped
+    handler.fetch(bio::io::genomic_region{.chrom = "chr1", .beg = -5, .end = 1000}, out, seek);
+    EXPECT_EQ(out, twobit_seqs[0].second);
+
+    EXPECT_THROW(handler.fetch(bio::io::genomic_region{.chrom = "chr3", .beg = 0, .end = 1}, out, seek),
+                 bio::io::bio_error);
+}
+
+TEST(twobit_input, errors)
+{
+    { // wrong signature
+        std::string data = make_twobit(twobit_seqs);
+        data[0]          = 'X';
+        std::istringstream istream{data};
+        EXPECT_THROW((bio::io::format_input_handler<bio::io::twobit>{istream}), bio::io::parse_error);
+    }
+
+    { // unsupported version
+        std::string data = make_twobit(twobit_seqs);
+        data[4]          = 2;
+        std::istringstream istream{data};
+        EXPECT_THROW((bio::io::format_input_handler<bio::io::twobit>{istream}), bio::io::parse_error);
+    }
+
+    { // truncated
+        std::string const  data = make_twobit(twobit_seqs);
+        std::istringstream istream{data.substr(0, data.size() - 3)};
+
+        bio::io::format_input_handler<bio::io::twobit>              handler{istream};
+        bio::io::seq::record<std::string, std::string, std::string> rec;
+        handler.parse_next_record_into(rec);
+        handler.parse_next_record_into(rec);
+        handler.parse_next_record_into(rec);
+        EXPECT_THROW(handler.parse_next_record_into(rec), bio::io::unexpected_end_of_input);
+    }
+
+    { // truncated sequence header; a failed fetch does not leave a partial header behind
+        std::string const  data = make_twobit(twobit_seqs);
+        std::istringstream istream{data.substr(0, data.size() - 18 - 10)}; // 72 bases of chr2 and part of its header
+
+        bio::io::format_input_handler<bio::io::twobit> handler{istream};
+        auto                                           seek = [&](uint64_t const offset)
+        {
+            istream.clear();
+            istream.seekg(offset);
+        };
+
+        std::string                 out;
+        bio::io::genomic_region const region{.chrom = "chr2", .beg = 0, .end = 4};
+        EXPECT_THROW(handler.fetch(region, out, seek), bio::io::unexpected_end_of_input);
+        EXPECT_THROW(handler.fetch(region, out, seek), bio::io::unexpected_end_of_input);
+    }
+}
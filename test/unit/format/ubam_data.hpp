@@ -0,0 +1,112 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2022, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2022, Knut Reinert & MPI für molekulare Genetik
+// Copyright (c) 2020-2022, deCODE Genetics
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/bio/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+//=============================================================================
+// Records (as stored in the file)
+//=============================================================================
+
+struct ubam_record
+{
+    std::string name;
+    std::string seq;
+    std::string qual; // Phred+33; empty means absent
+    uint16_t    flag = 0x4;
+    std::string tags = {};
+};
+
+inline std::vector<ubam_record> const ubam_records{
+  {"read1", "ACGTNACGTACGTTTGA", "IIIII#IIII5555II!", 0x4D, "RGZgroup1"},
+  {"read2", "ACGTNACGTACGTTTG", "IIIII#IIII5555II", 0x8D},
+  {"sec", "ACGT", "IIII", 0x100},
+  {"read3", "=MRWSYKVHDB", "", 0x4},
+  {"rev", "AACCM", "ABCDE", 0x10},
+  {"empty", "", "", 0x4},
+  {"supp", "ACGT", "IIII", 0x800},
+};
+
+//!\brief The records that the reader returns, i.e. without secondary/supplementary and in original orientation.
+inline std::vector<ubam_record> const ubam_expected{
+  {"read1", "ACGTNACGTACGTTTGA", "IIIII#IIII5555II!"},
+  {"read2", "ACGTNACGTACGTTTG", "IIIII#IIII5555II"},
+  {"read3", "=MRWSYKVHDB", ""},
+  {"rev", "KGGTT", "EDCBA"},
+  {"empty", "", ""},
+};
+
+//=============================================================================
+// Create an (uncompressed) BAM file
+//=============================================================================
+
+inline std::string make_ubam(std::vector<ubam_record> const & records)
+{
+    std::string ret;
+
+    auto append = [](std::string & out, uint64_t const value, size_t const size)
+    {
+        for (size_t i = 0; i < size; ++i)
+            out.push_back(static_cast<char>(value >> (8 * i)));
+    };
+
+    /* header */
+    std::string_view const text = "@HD\tVN:1.6\tSO:unsorted\n@RG\tID:group1\n";
+    ret += std::string_view{"BAM\1", 4};
+    append(ret, text.size(), 4);
+    ret += text;
+    append(ret, 1, 4); // n_ref
+    append(ret, 5, 4);
+    ret += std::string_view{"chr1", 5};
+    append(ret, 1000, 4);
+
+    /* records */
+    constexpr std::string_view codes = "=ACMGRSVTWYHKDBN";
+    for (ubam_record const & rec : records)
+    {
+        bool const  aligned = !(rec.flag & 0x4);
+        std::string data;
+        append(data, aligned ? 0 : -1, 4);    // refID
+        append(data, aligned ? 10 : -1, 4);   // pos
+        append(data, rec.name.size() + 1, 1); // l_read_name
+        append(data, 0, 1);                   // mapq
+        append(data, 4680, 2);                // bin
+        append(data, aligned ? 1 : 0, 2);     // n_cigar_op
+        append(data, rec.flag, 2);            // flag
+        append(data, rec.seq.size(), 4);      // l_seq
+        append(data, -1, 4);                  // next_refID
+        append(data, -1, 4);                  // next_pos
+        append(data, 0, 4);                   // tlen
+        data += rec.name;
+        data.push_back('\0');
+        if (aligned)
+            append(data, (rec.seq.size() << 4) | 0, 4); // <l_seq>M
+
+        for (size_t i = 0; i < rec.seq.size(); i += 2)
+        {
+            uint8_t byte = codes.find(rec.seq[i]) << 4;
+            if (i + 1 < rec.seq.size())
+                byte |= codes.find(rec.seq[i + 1]);
+            data.push_back(static_cast<char>(byte));
+        }
+
+        for (size_t i = 0; i < rec.seq.size(); ++i)
+            data.push_back(rec.qual.empty() ? '\xFF' : static_cast<char>(rec.qual[i] - '!'));
+
+        data += rec.tags;
+
+        append(ret, data.size(), 4);
+        ret += data;
+    }
+
+    return ret;
+}
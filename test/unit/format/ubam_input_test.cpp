@@ -0,0 +1,124 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2022, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2022, Knut Reinert & MPI für molekulare Genetik
+// Copyright (c) 2020-2022, deCODE Genetics
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/bio/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <bio/alphabet/nucleotide/dna5.hpp>
+#include <bio/alphabet/quality/phred42.hpp>
+#include <bio/test/expect_range_eq.hpp>
+
+#include <bio/io/format/ubam_input_handler.hpp>
+
+#include "ubam_data.hpp"
+
+using namespace bio::alphabet::literals;
+
+TEST(ubam_input, read)
+{
+    std::istringstream                           istream{make_ubam(ubam_records)};
+    bio::io::format_input_handler<bio::io::ubam> handler{istream};
+
+    bio::io::seq::record<std::string, std::string, std::string> rec;
+    for (ubam_record const & expected : ubam_expected)
+    {
+        handler.parse_next_record_into(rec);
+        EXPECT_EQ(rec.id, expected.name);
+        EXPECT_EQ(rec.seq, expected.seq);
+        EXPECT_EQ(rec.qual, expected.qual);
+    }
+
+    EXPECT_EQ(istream.peek(), std::char_traits<char>::eof());
+}
+
+TEST(ubam_input, read_alphabets)
+{
+    std::istringstream                           istream{make_ubam(ubam_records)};
+    bio::io::format_input_handler<bio::io::ubam> handler{istream};
+
+    bio::io::seq::record<std::string, std::vector<bio::alphabet::dna5>, std::vector<bio::alphabet::phred42>> rec;
+    handler.parse_next_record_into(rec);
+    EXPECT_RANGE_EQ(rec.seq, "ACGTNACGTACGTTTGA"_dna5);
+    EXPECT_RANGE_EQ(rec.qual, "IIIII#IIII5555II!"_phred42);
+}
+
+TEST(ubam_input, ignored_fields)
+{
+    std::istringstream                           istream{make_ubam(ubam_records)};
+    bio::io::format_input_handler<bio::io::ubam> handler{istream};
+
+    bio::io::seq::record<bio::meta::ignore_t, std::string, bio::meta::ignore_t> rec;
+    for (ubam_record const & expected : ubam_expected)
+    {
+        handler.parse_next_record_into(rec);
+        EXPECT_EQ(rec.seq, expected.seq);
+    }
+
+    EXPECT_EQ(istream.peek(), std::char_traits<char>::eof());
+}
+
+TEST(ubam_input, skip_records)
+{
+    std::istringstream                           istream{make_ubam(ubam_records)};
+    bio::io::format_input_handler<bio::io::ubam> handler{istream};
+
+    EXPECT_EQ(handler.skip_records(2), 2ull);
+
+    bio::io::seq::record<std::string, std::string, std::string> rec;
+    handler.parse_next_record_into(rec);
+    EXPECT_EQ(rec.id, "read3");
+
+    EXPECT_EQ(handler.skip_records(5), 2ull);
+    EXPECT_EQ(handler.skip_records(5), 0ull);
+    EXPECT_EQ(istream.peek(), std::char_traits<char>::eof());
+}
+
+TEST(ubam_input, errors)
+{
+    { // wrong magic
+        std::string data = make_ubam(ubam_records);
+        data[0]          = 'X';
+        std::istringstream istream{data};
+        EXPECT_THROW((bio::io::format_input_handler<bio::io::ubam>{istream}), bio::io::parse_error);
+    }
+
+    { // record smaller than its fields
+        std::string  data           = make_ubam(ubam_records);
+        size_t const block_size_pos = make_ubam({}).size();
+        data[block_size_pos]        = 10;
+        std::istringstream istream{data};
+        EXPECT_THROW((bio::io::format_input_handler<bio::io::ubam>{istream}), bio::io::parse_error);
+    }
+
+    { // quality out of range
+        std::vector<ubam_record> records{ubam_records[3]};
+        records[0].qual = std::string(records[0].seq.size(), '~');
+        records[0].qual.back() += 1;
+        std::istringstream                                          istream{make_ubam(records)};
+        bio::io::format_input_handler<bio::io::ubam>                handler{istream};
+        bio::io::seq::record<std::string, std::string, std::string> rec;
+        EXPECT_THROW(handler.parse_next_record_into(rec), bio::io::parse_error);
+    }
+
+    { // truncated
+        std::string const  data = make_ubam(ubam_records);
+        std::istringstream istream{data.substr(0, data.size() - 40)};
+
+        bio::io::format_input_handler<bio::io::ubam>                handler{istream};
+        bio::io::seq::record<std::string, std::string, std::string> rec;
+        EXPECT_THROW(
+          {
+              for (size_t i = 0; i < ubam_expected.size(); ++i)
+                  handler.parse_next_record_into(rec);
+          },
+          bio::io::unexpected_end_of_input);
+    }
+}
@@ -0,0 +1,191 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2022, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2022, Knut Reinert & MPI für molekulare Genetik
+// Copyright (c) 2020-2022, deCODE Genetics
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/bio/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <bio/alphabet/custom/char.hpp>
+#include <bio/alphabet/nucleotide/dna5.hpp>
+#include <bio/test/expect_range_eq.hpp>
+#include <bio/test/tmp_filename.hpp>
+
+#include <bio/io/seq/fai_index.hpp>
+#include <bio/io/seq/reader.hpp>
+#include <bio/io/seq/writer.hpp>
+
+using namespace bio::alphabet::literals;
+
+// the last sequence spans multiple BGZF blocks
+std::vector<std::pair<std::string, std::string>> const sequences = []()
+{
+    std::vector<std::pair<std::string, std::string>> ret{{"chr1", ""}, {"chr2", ""}, {"chr3", ""}};
+
+    std::string_view const bases = "ACGTNacgt";
+    for (size_t i = 0; i < 1000; ++i)
+        ret[0].second.push_back(bases[i % 4]);
+    for (size_t i = 0; i < 120; ++i)
+        ret[1].second.push_back(bases[(i * 7) % 9]);
+    for (size_t i = 0; i < 200000; ++i)
+        ret[2].second.push_back(bases[(i * i) % 5]);
+
+    return ret;
+}();
+
+bio::io::seq::fai_index write_test_file(std::filesystem::path const & path, bool const windows_eol = false)
+{
+    std::filesystem::path fai_file = path;
+    fai_file += ".fai";
+
+    {
+        bio::io::seq::writer writer{path,
+                                    bio::io::seq::writer_options{.max_seq_line_length = 60,
+                                                                 .fai_file            = fai_file,
+                                                                 .stream_options      = {.threads = 2},
+                                                                 .windows_eol         = windows_eol}};
+
+        for (auto & [name, seq] : sequences)
+            writer.emplace_back(name + " description", seq, std::string{});
+    }
+
+    bio::io::seq::fai_index ret;
+    ret.read(fai_file);
+    return ret;
+}
+
+void test_fetch(std::filesystem::path const & path, bool const windows_eol = false)
+{
+    bio::io::seq::fai_index idx_written = write_test_file(path, windows_eol);
+
+    ASSERT_EQ(idx_written.entries().size(), sequences.size());
+    for (size_t i = 0; i < sequences.size(); ++i)
+    {
+        EXPECT_EQ(idx_written.entries()[i].name, sequences[i].first);
+        EXPECT_EQ(idx_written.entries()[i].length, sequences[i].second.size());
+    }
+    EXPECT_EQ(idx_written.entries()[0].linebases, 60u);
+    EXPECT_EQ(idx_written.entries()[0].linewidth, windows_eol ? 62u : 61u);
+
+    // build index by reading
+    bio::io::seq::fai_index idx_built = bio::io::seq::fai_index::build(path);
+    EXPECT_TRUE(idx_built == idx_written);
+
+    bio::io::seq::reader reader{path};
+    for (auto [chrom, beg, end] : std::vector<std::tuple<std::string, int64_t, int64_t>>{
+           {"chr1",      0,     10},
+           {"chr1",     55,     65},
+           {"chr1",     60,    120},
+           {"chr1",    990,   2000},
+           {"chr2",      0,    120},
+           {"chr2",    -10,      5},
+           {"chr3", 123456, 123456},
+           {"chr3", 130000, 150001},
+           {"chr1",      1,      2},
+           {"chr3",      0, 200000}
+    })
+    {
+        auto const & seq = std::ranges::find(sequences, chrom, [](auto const & p) { return p.first; })->second;
+        int64_t      b   = std::clamp<int64_t>(beg, 0, seq.size());
+        int64_t      e   = std::clamp<int64_t>(end, b, seq.size());
+
+        EXPECT_EQ(reader.fetch({chrom, beg, end}), seq.substr(b, e - b)) << chrom << ':' << beg << '-' << end;
+    }
+
+    EXPECT_THROW(reader.fetch({"chr4", 0, 10}), bio::io::bio_error);
+
+    // record-based reading after fetching
+    reader.reopen();
+    size_t n = 0;
+    for (auto & rec : reader)
+        EXPECT_EQ(rec.id, sequences[n++].first + " description");
+    EXPECT_EQ(n, sequences.size());
+}
+
+TEST(fai_index, uncompressed)
+{
+    bio::test::tmp_filename filename{"fai_index_test.fasta"};
+    test_fetch(filename.get_path());
+}
+
+TEST(fai_index, windows_eol)
+{
+    bio::test::tmp_filename filename{"fai_index_test.fasta"};
+    test_fetch(filename.get_path(), true);
+}
+
+TEST(fai_index, bgzf)
+{
+    bio::test::tmp_filename filename{"fai_index_test.fasta.gz"};
+    test_fetch(filename.get_path());
+}
+
+TEST(fai_index, read_write)
+{
+    std::string const input = "chr1\t1000\t6\t60\t61\nchr2\t120\t1030\t60\t61\n";
+
+    bio::test::tmp_filename filename{"fai_index_test.fasta.fai"};
+    {
+        std::ofstream str{filename.get_path()};
+        str << input;
+    }
+
+    bio::io::seq::fai_index idx;
+    idx.read(filename.get_path());
+    ASSERT_EQ(idx.entries().size(), 2u);
+    ASSERT_TRUE(idx.find("chr2") != nullptr);
+    EXPECT_EQ(idx.find("chr2")->offset, 1030u);
+    EXPECT_EQ(idx.find("chr2")->offset_of(61), 1030u + 61u + 1u);
+    EXPECT_TRUE(idx.find("chr3") == nullptr);
+
+    idx.write(filename.get_path());
+    std::ifstream      str{filename.get_path()};
+    std::ostringstream output;
+    output << str.rdbuf();
+    EXPECT_EQ(output.str(), input);
+}
+
+TEST(fai_index, stream)
+{
+    std::string const input = ">seq1 foo\nACGTA\nCGTAC\nGT\n>seq2\nNNNN\nACGT\n";
+
+    bio::io::seq::fai_index idx;
+    idx.push_back({.name = "seq1", .length = 12, .offset = 10, .linebases = 5, .linewidth = 6});
+    idx.push_back({.name = "seq2", .length = 8, .offset = 31, .linebases = 4, .linewidth = 5});
+    EXPECT_THROW(idx.push_back({.name = "seq1"}), bio::io::format_error);
+
+    bio::io::seq::reader reader{std::istringstream{input}, bio::io::fasta{}};
+    EXPECT_THROW(reader.fetch({"seq1", 0, 3}), bio::io::bio_error); // no index
+
+    reader.set_fai_index(std::move(idx));
+    EXPECT_EQ(reader.fetch({"seq1", 3, 11}), "TACGTACG");
+    EXPECT_EQ(reader.fetch({"seq2", 2, 7}), "NNACG");
+
+    std::vector<bio::alphabet::dna5> seq;
+    reader.fetch({"seq1", 4, 12}, seq);
+    EXPECT_RANGE_EQ(seq, "ACGTACGT"_dna5);
+
+    std::string str;
+    reader.fetch({"seq1", 0, 2}, str);
+    EXPECT_EQ(str, "AC");
+}
+
+TEST(fai_index, inconsistent_line_length)
+{
+    bio::test::tmp_filename filename{"fai_index_test.fasta"};
+    {
+        std::ofstream str{filename.get_path()};
+        str << ">seq1\nACGT\nAC\nACGT\n";
+    }
+
+    EXPECT_THROW(bio::io::seq::fai_index::build(filename.get_path()), bio::io::format_error);
+}
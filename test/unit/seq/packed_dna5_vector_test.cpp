@@ -0,0 +1,143 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2022, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2022, Knut Reinert & MPI für molekulare Genetik
+// Copyright (c) 2020-2022, deCODE Genetics
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/bio/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <bio/alphabet/nucleotide/dna5.hpp>
+#include <bio/alphabet/quality/phred42.hpp>
+#include <bio/ranges/views/char_strictly_to.hpp>
+#include <bio/test/expect_range_eq.hpp>
+
+#include <bio/io/seq/packed_dna5_vector.hpp>
+#include <bio/io/seq/reader.hpp>
+#include <bio/io/seq/writer.hpp>
+
+using namespace bio::alphabet::literals;
+
+// covers partial words, N-runs at word boundaries and lower-case characters
+std::string const long_seq = []()
+{
+    std::string ret;
+    for (size_t i = 0; i < 1000; ++i)
+        ret.push_back("ACGTacgtTGCA"[(i * 7) % 12]);
+    ret.replace(31, 3, "NNN");
+    ret.replace(500, 100, std::string(100, 'N'));
+    ret.back() = 'n';
+    return ret;
+}();
+
+TEST(packed_dna5_vector, concepts)
+{
+    EXPECT_TRUE(std::ranges::random_access_range<bio::io::seq::packed_dna5_vector>);
+    EXPECT_TRUE(std::ranges::sized_range<bio::io::seq::packed_dna5_vector>);
+    EXPECT_TRUE(bio::io::detail::bulk_char_convertible<bio::io::seq::packed_dna5_vector>);
+}
+
+TEST(packed_dna5_vector, assign_chars)
+{
+    for (std::string_view const input : {std::string_view{""}, std::string_view{"ACGT"}, std::string_view{long_seq}})
+    {
+        bio::io::seq::packed_dna5_vector vec;
+        vec.assign_chars(input);
+
+        ASSERT_EQ(vec.size(), input.size());
+        EXPECT_RANGE_EQ(vec, input | bio::views::char_strictly_to<bio::alphabet::dna5>);
+    }
+
+    bio::io::seq::packed_dna5_vector vec;
+    vec.assign_chars(long_seq);
+    std::vector<bio::io::seq::packed_dna5_vector::n_run> const n_runs{
+      { 31,   3},
+      {500, 100},
+      {999,   1}
+    };
+    EXPECT_RANGE_EQ(vec.n_runs(), n_runs);
+
+    EXPECT_THROW(vec.assign_chars("ACGTXACGT"), bio::alphabet::invalid_char_assignment);
+}
+
+TEST(packed_dna5_vector, push_back_and_append)
+{
+    bio::io::seq::packed_dna5_vector vec;
+    for (bio::alphabet::dna5 const l : long_seq | bio::views::char_strictly_to<bio::alphabet::dna5>)
+        vec.push_back(l);
+
+    bio::io::seq::packed_dna5_vector vec2;
+    vec2.append_chars(std::string_view{long_seq}.substr(0, 17));
+    vec2.append_chars(std::string_view{long_seq}.substr(17, 400));
+    vec2.append_chars(std::string_view{long_seq}.substr(417));
+
+    bio::io::seq::packed_dna5_vector vec3;
+    vec3.assign_chars(long_seq);
+
+    EXPECT_TRUE(vec == vec3);
+    EXPECT_TRUE(vec2 == vec3);
+}
+
+TEST(packed_dna5_vector, to_chars)
+{
+    bio::io::seq::packed_dna5_vector vec;
+    vec.assign_chars(long_seq);
+
+    std::string upper = long_seq;
+    std::ranges::transform(upper, upper.begin(), [](char c) { return c & ~0x20; });
+    EXPECT_EQ(vec.to_string(), upper);
+
+    std::string buffer(1000, ' ');
+    for (auto [pos, count] : std::vector<std::pair<size_t, size_t>>{{0, 1}, {3, 30}, {30, 5}, {498, 103}, {997, 10}})
+    {
+        size_t const n = vec.to_chars(pos, count, buffer.data());
+        EXPECT_EQ(std::string_view(buffer.data(), n), std::string_view{upper}.substr(pos, count));
+    }
+}
+
+TEST(packed_dna5_vector, read_write)
+{
+    std::string const input = ">ID1\n" + long_seq + "\n>ID2\nACGTN\n";
+
+    bio::io::seq::reader reader{std::istringstream{input},
+                                bio::io::fasta{},
+                                bio::io::seq::reader_options{.record = bio::io::seq::record_dna_packed{}}};
+
+    std::ostringstream ostr;
+    {
+        bio::io::seq::writer writer{ostr, bio::io::fasta{}, bio::io::seq::writer_options{.max_seq_line_length = 60}};
+        for (auto & rec : reader)
+        {
+            EXPECT_TRUE((std::same_as<decltype(rec.seq), bio::io::seq::packed_dna5_vector>));
+            writer.push_back(rec);
+        }
+    }
+
+    std::istringstream istr{ostr.str()};
+    bio::io::seq::reader reader2{istr, bio::io::fasta{}};
+    auto                 it = reader2.begin();
+    EXPECT_RANGE_EQ(it->seq, long_seq | bio::views::char_strictly_to<bio::alphabet::dna5>);
+    ++it;
+    EXPECT_RANGE_EQ(it->seq, "ACGTN"_dna5);
+}
+
+TEST(packed_dna5_vector, write_fastq)
+{
+    bio::io::seq::record_dna_packed rec;
+    rec.id = "ID1";
+    rec.seq.assign_chars("ACGTNNACGT");
+    rec.qual = "IIIIIIIIII"_phred42;
+
+    std::ostringstream ostr;
+    {
+        bio::io::seq::writer writer{ostr, bio::io::fastq{}};
+        writer.push_back(rec);
+    }
+
+    EXPECT_EQ(ostr.str(), "@ID1\nACGTNNACGT\n+\nIIIIIIIIII\n");
+}
@@ -0,0 +1,158 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2022, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2022, Knut Reinert & MPI für molekulare Genetik
+// Copyright (c) 2020-2022, deCODE Genetics
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/bio/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <bio/test/expect_range_eq.hpp>
+#include <bio/test/tmp_filename.hpp>
+
+#include <bio/io/seq/paired_reader.hpp>
+
+#include "data.hpp"
+
+struct paired_files
+{
+    bio::test::tmp_filename interleaved{"paired_reader_interleaved.fastq"};
+    bio::test::tmp_filename r1{"paired_reader_R1.fastq"};
+    bio::test::tmp_filename r2{"paired_reader_R2.fastq"};
+
+    explicit paired_files(std::string_view const content)
+    {
+        std::ofstream inter{interleaved.get_path(), std::ios::binary};
+        std::ofstream out1{r1.get_path(), std::ios::binary};
+        std::ofstream out2{r2.get_path(), std::ios::binary};
+        inter << content;
+
+        // every record has four lines
+        size_t line = 0;
+        for (size_t pos = 0; pos < content.size();)
+        {
+            size_t const end = content.find('\n', pos) + 1;
+            (line / 4 % 2 == 0 ? out1 : out2) << content.substr(pos, end - pos);
+            pos = end;
+            ++line;
+        }
+    }
+};
+
+TEST(paired_reader, mate_names_match)
+{
+    using t = bio::io::seq::paired_reader<>;
+
+    EXPECT_TRUE(t::mate_names_match(std::string_view{"read1"}, std::string_view{"read1"}));
+    EXPECT_TRUE(t::mate_names_match(std::string_view{"read1/1"}, std::string{"read1/2"}));
+    EXPECT_TRUE(t::mate_names_match(std::string_view{"read1 1:N:0:28"}, std::string_view{"read1 2:N:0:28"}));
+    EXPECT_TRUE(t::mate_names_match(std::string_view{"read1/1\tfoo"}, std::string_view{"read1/2 bar"}));
+    EXPECT_FALSE(t::mate_names_match(std::string_view{"read1"}, std::string_view{"read2"}));
+    EXPECT_FALSE(t::mate_names_match(std::string_view{"read1/1"}, std::string_view{"read1/3"}));
+    EXPECT_FALSE(t::mate_names_match(std::string_view{"read1"}, std::string_view{"read11"}));
+}
+
+void paired_reader_iterate(auto & reader)
+{
+    std::vector<std::string> ids1;
+    std::vector<std::string> ids2;
+    for (auto && [mate1, mate2] : reader)
+    {
+        ids1.emplace_back(mate1.id);
+        ids2.emplace_back(mate2.id);
+    }
+
+    ASSERT_EQ(ids1.size(), 2ull);
+    EXPECT_EQ(ids1[0], "M10991:61:000000000-A7EML:1:1101:14011:1001 1:N:0:28");
+    EXPECT_EQ(ids2[0], "M10991:61:000000000-A7EML:1:1101:14011:1001 2:N:0:28");
+    EXPECT_EQ(ids1[1], "M10991:61:000000000-A7EML:1:1201:15411:3101 1:N:0:28");
+    EXPECT_EQ(ids2[1], "M10991:61:000000000-A7EML:1:1201:15411:3101 2:N:0:28");
+}
+
+TEST(paired_reader, two_files)
+{
+    paired_files files{interleaved_fastq};
+
+    bio::io::seq::paired_reader reader{files.r1.get_path(), files.r2.get_path()};
+    EXPECT_TRUE((std::same_as<decltype(reader), bio::io::seq::paired_reader<>>));
+    paired_reader_iterate(reader);
+}
+
+TEST(paired_reader, interleaved)
+{
+    paired_files files{interleaved_fastq};
+
+    bio::io::seq::paired_reader reader{files.interleaved.get_path()};
+    paired_reader_iterate(reader);
+}
+
+TEST(paired_reader, read_batch)
+{
+    paired_files files{interleaved_fastq};
+
+    for (bool interleaved : {false, true})
+    {
+        bio::io::seq::reader_options opt{.record = bio::io::seq::record_char_shallow{}};
+        auto reader = interleaved
+                      ? bio::io::seq::paired_reader{files.interleaved.get_path(), std::move(opt)}
+                      : bio::io::seq::paired_reader{files.r1.get_path(), files.r2.get_path(), std::move(opt)};
+
+        bio::io::seq::record_batch batch1;
+        bio::io::seq::record_batch batch2;
+
+        // mix with iteration
+        auto it = reader.begin();
+        EXPECT_EQ((*it).second.seq.substr(0, 7), "NGCTCCT");
+        ++it;
+
+        EXPECT_EQ(reader.read_batch(batch1, batch2, 10), 1ull);
+        EXPECT_RANGE_EQ(batch1.ids[0], std::string_view{"M10991:61:000000000-A7EML:1:1201:15411:3101 1:N:0:28"});
+        EXPECT_RANGE_EQ(batch2.ids[0], std::string_view{"M10991:61:000000000-A7EML:1:1201:15411:3101 2:N:0:28"});
+        EXPECT_RANGE_EQ(batch2.seqs[0].subspan(0, 7), std::string_view{"CGCTAGC"});
+        EXPECT_TRUE(reader.begin() == reader.end());
+
+        EXPECT_EQ(reader.read_batch(batch1, batch2, 10), 0ull);
+    }
+}
+
+TEST(paired_reader, errors)
+{
+    { // name mismatch
+        std::string content{interleaved_fastq};
+        content.replace(content.find("1101:14011:1001 2"), 15, "1101:14011:1002");
+        paired_files files{content};
+
+        bio::io::seq::paired_reader reader{files.r1.get_path(), files.r2.get_path()};
+        EXPECT_THROW(reader.begin(), bio::io::format_error);
+
+        bio::io::seq::paired_reader reader2{files.interleaved.get_path(), bio::io::seq::reader_options{}, false};
+        EXPECT_EQ(std::ranges::distance(reader2.begin(), reader2.end()), 2);
+    }
+
+    { // different number of records
+        std::string_view const content = interleaved_fastq.substr(0, interleaved_fastq.rfind("\n@") + 1);
+        paired_files           files{content};
+
+        bio::io::seq::paired_reader reader{files.r1.get_path(), files.r2.get_path()};
+        auto                        it = reader.begin();
+        EXPECT_THROW(++it, bio::io::format_error);
+
+        bio::io::seq::paired_reader reader2{files.interleaved.get_path()};
+        bio::io::seq::record_batch  batch1;
+        bio::io::seq::record_batch  batch2;
+        EXPECT_THROW(reader2.read_batch(batch1, batch2, 10), bio::io::format_error);
+    }
+
+    { // sharding
+        paired_files files{interleaved_fastq};
+        EXPECT_THROW((bio::io::seq::paired_reader{files.interleaved.get_path(),
+                                                  bio::io::seq::reader_options{.shard = {.index = 0, .count = 2}}}),
+                     bio::io::bio_error);
+    }
+}
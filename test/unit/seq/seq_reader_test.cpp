@@ -7,7 +7,11 @@
 // -----------------------------------------------------------------------------------------------------
 
 #include <algorithm>
+#include <filesystem>
+#include <fstream>
 #include <sstream>
+#include <string>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -17,10 +21,16 @@
 #include <bio/test/tmp_filename.hpp>
 
 #include <bio/io/seq/reader.hpp>
+#include <bio/io/seq/writer.hpp>
+#include <bio/io/stream/transparent_ostream.hpp>
 #include <bio/io/stream/detail/fast_streambuf_iterator.hpp>
 
+#include "../format/twobit_data.hpp"
+#include "../format/ubam_data.hpp"
 #include "data.hpp"
 
+using namespace bio::alphabet::literals;
+
 TEST(seq_reader, concepts)
 {
     using t = bio::io::seq::reader<>;
@@ -71,7 +81,8 @@ TEST(seq_reader, constructor1_with_opts)
     seq_reader_filename_constructor(true, std::move(opt));
 
     using control_t =
-      bio::io::seq::reader<bio::io::seq::record_protein_shallow, bio::meta::type_list<bio::io::fasta, bio::io::fastq>>;
+      bio::io::seq::reader<bio::io::seq::record_protein_shallow,
+                           bio::meta::type_list<bio::io::fasta, bio::io::fastq, bio::io::twobit, bio::io::ubam>>;
     EXPECT_TRUE((std::same_as<decltype(bio::io::seq::reader{"", std::move(opt)}), control_t>));
 }
 
@@ -87,7 +98,8 @@ TEST(seq_reader, constructor2_with_opts_direct_format)
     seq_reader_filename_constructor(false, bio::io::fasta{}, std::move(opt));
 
     using control_t =
-      bio::io::seq::reader<bio::io::seq::record_dna_shallow, bio::meta::type_list<bio::io::fasta, bio::io::fastq>>;
+      bio::io::seq::reader<bio::io::seq::record_dna_shallow,
+                           bio::meta::type_list<bio::io::fasta, bio::io::fastq, bio::io::twobit, bio::io::ubam>>;
     EXPECT_TRUE((std::same_as<decltype(bio::io::seq::reader{"", bio::io::fasta{}, std::move(opt)}), control_t>));
 }
 
@@ -106,7 +118,8 @@ TEST(seq_reader, constructor2_with_opts_format_variant)
     seq_reader_filename_constructor(false, var, std::move(opt));
 
     using control_t =
-      bio::io::seq::reader<bio::io::seq::record_dna_shallow, bio::meta::type_list<bio::io::fasta, bio::io::fastq>>;
+      bio::io::seq::reader<bio::io::seq::record_dna_shallow,
+                           bio::meta::type_list<bio::io::fasta, bio::io::fastq, bio::io::twobit, bio::io::ubam>>;
     EXPECT_TRUE((std::same_as<decltype(bio::io::seq::reader{"", var, std::move(opt)}), control_t>));
 }
 
@@ -125,7 +138,8 @@ TEST(seq_reader, constructor3_with_opts)
     EXPECT_NO_THROW((bio::io::seq::reader{str, bio::io::fasta{}, std::move(opt)}));
 
     using control_t =
-      bio::io::seq::reader<bio::io::seq::record_dna_shallow, bio::meta::type_list<bio::io::fasta, bio::io::fastq>>;
+      bio::io::seq::reader<bio::io::seq::record_dna_shallow,
+                           bio::meta::type_list<bio::io::fasta, bio::io::fastq, bio::io::twobit, bio::io::ubam>>;
     EXPECT_TRUE((std::same_as<decltype(bio::io::seq::reader{str, bio::io::fasta{}, std::move(opt)}), control_t>));
 }
 
@@ -145,7 +159,8 @@ TEST(seq_reader, constructor4_with_opts)
     EXPECT_NO_THROW((bio::io::seq::reader{std::move(str), bio::io::fasta{}, std::move(opt)}));
 
     using control_t =
-      bio::io::seq::reader<bio::io::seq::record_dna_shallow, bio::meta::type_list<bio::io::fasta, bio::io::fastq>>;
+      bio::io::seq::reader<bio::io::seq::record_dna_shallow,
+                           bio::meta::type_list<bio::io::fasta, bio::io::fastq, bio::io::twobit, bio::io::ubam>>;
     EXPECT_TRUE(
       (std::same_as<decltype(bio::io::seq::reader{std::move(str), bio::io::fasta{}, std::move(opt)}), control_t>));
 }
@@ -174,6 +189,458 @@ TEST(seq_reader, iteration)
     }
 }
 
+TEST(seq_reader, skip_and_count)
+{
+    {
+        std::istringstream   str{static_cast<std::string>(input)};
+        bio::io::seq::reader reader{str, bio::io::fasta{}};
+
+        EXPECT_EQ(reader.skip(2), 2ull);
+        EXPECT_EQ(reader.front().id, "ID3 lala");
+        EXPECT_EQ(reader.count(), 3ull);
+        EXPECT_TRUE(reader.begin() == reader.end());
+        EXPECT_EQ(reader.skip(1), 0ull);
+    }
+
+    {
+        std::istringstream   str{static_cast<std::string>(interleaved_fastq)};
+        bio::io::seq::reader reader{str, bio::io::fastq{}};
+
+        EXPECT_EQ(reader.skip(3), 3ull);
+        EXPECT_EQ(reader.front().id, "M10991:61:000000000-A7EML:1:1201:15411:3101 2:N:0:28");
+        EXPECT_EQ(reader.skip(10), 1ull);
+        EXPECT_TRUE(reader.begin() == reader.end());
+    }
+
+    {
+        std::istringstream   str{static_cast<std::string>(interleaved_fastq)};
+        bio::io::seq::reader reader{str, bio::io::fastq{}};
+
+        EXPECT_EQ(reader.count(), 4ull);
+    }
+
+    { // no trailing newline and broken record
+        std::string_view     in = interleaved_fastq.substr(0, interleaved_fastq.size() - 1);
+        std::istringstream   str{static_cast<std::string>(in)};
+        bio::io::seq::reader reader{str, bio::io::fastq{}};
+        EXPECT_EQ(reader.count(), 4ull);
+
+        std::istringstream   str2{"@ID1\nACGT\n+\n!!!!\n@ID2\nACGT\n!!!!\n"};
+        bio::io::seq::reader reader2{str2, bio::io::fastq{}};
+        EXPECT_THROW(reader2.count(), bio::io::parse_error);
+    }
+}
+
+TEST(seq_reader, read_batch)
+{
+    {
+        std::istringstream   str{static_cast<std::string>(input)};
+        bio::io::seq::reader reader{str, bio::io::fasta{}};
+
+        bio::io::seq::record_batch batch;
+        EXPECT_EQ(reader.read_batch(batch, 2), 2ull);
+        ASSERT_EQ(batch.size(), 2ull);
+        EXPECT_RANGE_EQ(batch[0].id, std::string_view{"ID1"});
+        EXPECT_RANGE_EQ(batch[1].seq, std::string_view{"ACGTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTT"
+                                                       "TTTTTTTTTTTTTTTT"});
+        EXPECT_TRUE(batch[1].qual.empty());
+
+        // mixed with iteration
+        EXPECT_EQ(reader.front().id, "ID3 lala");
+
+        EXPECT_EQ(reader.read_batch(batch, 10), 3ull);
+        ASSERT_EQ(batch.size(), 3ull);
+        EXPECT_RANGE_EQ(batch[0].id, std::string_view{"ID3 lala"});
+        EXPECT_RANGE_EQ(batch[0].seq, std::string_view{"ACGTTTAACGTTTTTTTT"});
+        EXPECT_RANGE_EQ(batch[2].id, std::string_view{"ID5 lala"});
+        EXPECT_TRUE(reader.begin() == reader.end());
+
+        EXPECT_EQ(reader.read_batch(batch, 10), 0ull);
+        EXPECT_TRUE(batch.empty());
+    }
+
+    {
+        std::istringstream   str{static_cast<std::string>(interleaved_fastq)};
+        bio::io::seq::reader reader{str, bio::io::fastq{}};
+
+        bio::io::seq::record_batch<std::vector<bio::alphabet::dna5>, std::string> batch;
+
+        size_t n = 0;
+        while (reader.read_batch(batch, 3) > 0)
+        {
+            for (size_t i = 0; i < batch.size(); ++i, ++n)
+            {
+                EXPECT_TRUE(std::ranges::equal(batch[i].id | std::views::take(6), std::string_view{"M10991"}));
+                EXPECT_EQ(batch[i].seq.size(), batch[i].qual.size());
+                EXPECT_EQ(batch[i].seq[0], bio::alphabet::dna5{}.assign_char(n < 3 ? 'N' : 'C'));
+            }
+        }
+        EXPECT_EQ(n, 4ull);
+    }
+
+    { // record type of the reader differs from batch
+        std::istringstream   str{static_cast<std::string>(input)};
+        bio::io::seq::reader reader{str,
+                                    bio::io::fasta{},
+                                    bio::io::seq::reader_options{.record = bio::io::seq::record_dna_deep{}}};
+
+        bio::io::seq::record_batch batch;
+        EXPECT_EQ(reader.read_batch(batch, 5), 5ull);
+        EXPECT_RANGE_EQ(batch[0].seq, std::string_view{"ACGTTTTTTTTTTTTTTT"});
+        EXPECT_RANGE_EQ(batch[4].seq, std::string_view{"ACGTTTAACGTTTTTTTT"});
+    }
+}
+
+TEST(seq_reader, read_batch_parallel)
+{
+    // qualities beginning with '@' and "+" lines with IDs make finding record starts non-trivial
+    std::string file_content;
+    for (size_t i = 0; i < 300; ++i)
+    {
+        std::string const seq(i % 17, "ACGTN"[i % 5]);
+        std::string       qual(i % 17, "@+!I"[i % 4]);
+        file_content += "@read" + std::to_string(i) + " lala\n" + seq + "\n+" + (i % 2 ? "read" : "") + "\n" + qual;
+        file_content += i % 3 ? "\n" : "\r\n";
+    }
+
+    bio::test::tmp_filename filename{"seq_reader_parallel.fastq"};
+    {
+        std::ofstream filecreator{filename.get_path(), std::ios::out | std::ios::binary};
+        filecreator << file_content;
+    }
+
+    bio::io::seq::record_batch expected;
+    {
+        bio::io::seq::reader reader{filename.get_path(),
+                                    bio::io::seq::reader_options{.record = bio::io::seq::record_char_shallow{}}};
+        EXPECT_EQ(reader.read_batch(expected, 1000), 300ull);
+    }
+
+    for (size_t n_threads : {1ul, 2ul, 3ul, 8ul})
+    {
+        for (size_t chunk_size : {1ul, 37ul, 100ul, 1000ul, 1ul << 20})
+        {
+            bio::io::seq::reader       reader{filename.get_path()};
+            bio::io::seq::record_batch batch;
+
+            size_t n = 0;
+            while (reader.read_batch_parallel(batch, n_threads, chunk_size) > 0)
+            {
+                for (size_t i = 0; i < batch.size(); ++i, ++n)
+                {
+                    ASSERT_LT(n, expected.size());
+                    EXPECT_RANGE_EQ(batch[i].id, expected[n].id) << n_threads << ' ' << chunk_size;
+                    EXPECT_RANGE_EQ(batch[i].seq, expected[n].seq);
+                    EXPECT_RANGE_EQ(batch[i].qual, expected[n].qual);
+                }
+            }
+            EXPECT_EQ(n, 300ull) << n_threads << ' ' << chunk_size;
+        }
+    }
+
+    { // mixed with record-based reading
+        bio::io::seq::reader reader{filename.get_path()};
+        EXPECT_EQ(reader.skip(10), 10ull);
+
+        bio::io::seq::record_batch<std::vector<bio::alphabet::dna5>, std::string> batch;
+        EXPECT_EQ(reader.read_batch_parallel(batch, 4), 290ull);
+        EXPECT_RANGE_EQ(batch[0].id, std::string_view{"read10 lala"});
+        EXPECT_TRUE(reader.begin() == reader.end());
+
+        reader.reopen();
+        EXPECT_EQ(reader.front().id, "read0 lala");
+    }
+
+    { // errors
+        std::istringstream   str{"@ID1\nACGT\n+\n!!!!\n@ID2\nACGT\n+\n!!!\n"};
+        bio::io::seq::reader reader{str, bio::io::fastq{}};
+        bio::io::seq::record_batch batch;
+        EXPECT_THROW(
+          while (reader.read_batch_parallel(batch, 2, 4) > 0) {}, bio::io::parse_error);
+
+        std::istringstream   str2{"@ID1\nACGT\n+\n!!!!\n@ID2\nACGT\n"};
+        bio::io::seq::reader reader2{str2, bio::io::fastq{}};
+        EXPECT_THROW(
+          while (reader2.read_batch_parallel(batch, 2, 4) > 0) {}, bio::io::parse_error);
+
+        std::istringstream   str3{static_cast<std::string>(input)};
+        bio::io::seq::reader reader3{str3, bio::io::fasta{}};
+        EXPECT_THROW(reader3.read_batch_parallel(batch, 2), bio::io::bio_error);
+    }
+}
+
+TEST(seq_reader, qual_stats)
+{
+    std::istringstream   str{"@ID1\nACGT\n+\n!5I+\n@ID2\nAC\n+\n55\n"};
+    bio::io::seq::reader reader{str, bio::io::fastq{}, bio::io::seq::reader_options{.compute_qual_stats = true}};
+
+    EXPECT_DOUBLE_EQ(reader.current_qual_stats().mean, (0 + 20 + 40 + 10) / 4.0);
+    EXPECT_EQ(reader.current_qual_stats().min, 0);
+    EXPECT_EQ(reader.skip(1), 1ull);
+    EXPECT_DOUBLE_EQ(reader.current_qual_stats().mean, 20.0);
+    EXPECT_EQ(reader.current_qual_stats().min, 20);
+
+    std::istringstream   str2{static_cast<std::string>(input)};
+    bio::io::seq::reader reader2{str2, bio::io::fasta{}, bio::io::seq::reader_options{.compute_qual_stats = true}};
+    EXPECT_EQ(reader2.current_qual_stats().mean, 0);
+}
+
+TEST(seq_reader, twobit)
+{
+    bio::test::tmp_filename filename{"seq_reader.2bit"};
+    {
+        std::ofstream filecreator{filename.get_path(), std::ios::out | std::ios::binary};
+        filecreator << make_twobit(twobit_seqs);
+    }
+
+    bio::io::seq::reader reader{filename.get_path(),
+                                bio::io::seq::reader_options{.record = bio::io::seq::record_char_shallow{}}};
+
+    size_t n = 0;
+    for (auto & rec : reader)
+    {
+        EXPECT_EQ(rec.id, twobit_seqs[n].first);
+        EXPECT_EQ(rec.seq, twobit_seqs[n].second);
+        ++n;
+    }
+    EXPECT_EQ(n, twobit_seqs.size());
+
+    // random access
+    EXPECT_EQ(reader.fetch({"chrM", 2, 13}), "nnGATTACAgg");
+    EXPECT_EQ(reader.fetch({"chr2", 66, 1000}), "TTCCGA");
+
+    std::vector<bio::alphabet::dna5> seq;
+    reader.fetch({"chr1", 2, 11}, seq);
+    EXPECT_RANGE_EQ(seq, "GTNNNNACG"_dna5);
+
+    // record-based reading after fetching
+    reader.reopen();
+    EXPECT_EQ(reader.skip(3), 3ull);
+    EXPECT_EQ(reader.front().id, "chr2");
+}
+
+TEST(seq_reader, statistics)
+{
+    std::string              file_content;
+    bio::io::seq::statistics expected;
+    for (size_t i = 0; i < 300; ++i)
+    {
+        std::string const seq(i % 17, "ACGTNacgt"[i % 9]);
+        std::string const qual(i % 17, "@+!I"[i % 4]);
+        file_content += "@read" + std::to_string(i) + "\n" + seq + "\n+\n" + qual + "\n";
+        expected.add(seq, qual);
+    }
+
+    bio::test::tmp_filename filename{"seq_reader_statistics.fastq"};
+    {
+        std::ofstream filecreator{filename.get_path(), std::ios::out | std::ios::binary};
+        filecreator << file_content;
+    }
+
+    { // record-based and batches
+        bio::io::seq::reader reader{filename.get_path(), bio::io::seq::reader_options{.compute_statistics = true}};
+        EXPECT_EQ(reader.statistics(), bio::io::seq::statistics{});
+
+        size_t n = 0;
+        for ([[maybe_unused]] auto & rec : reader)
+            if (++n == 100)
+                break;
+
+        bio::io::seq::record_batch batch;
+        while (reader.read_batch(batch, 7) > 0) {}
+        EXPECT_EQ(reader.statistics(), expected);
+
+        reader.reopen();
+        for ([[maybe_unused]] auto & rec : reader) {}
+        EXPECT_EQ(reader.statistics(), expected);
+    }
+
+    for (size_t n_threads : {1ul, 3ul})
+    {
+        bio::io::seq::reader       reader{filename.get_path(),
+                                    bio::io::seq::reader_options{.compute_statistics = true}};
+        bio::io::seq::record_batch batch;
+        while (reader.read_batch_parallel(batch, n_threads, 37) > 0) {}
+        EXPECT_EQ(reader.statistics(), expected) << n_threads;
+    }
+
+    { // FastA, multi-line sequences
+        std::istringstream   str{static_cast<std::string>(input)};
+        bio::io::seq::reader reader{str, bio::io::fasta{}, bio::io::seq::reader_options{.compute_statistics = true}};
+        for ([[maybe_unused]] auto & rec : reader) {}
+
+        EXPECT_EQ(reader.statistics().n_records, 5ull);
+        EXPECT_EQ(reader.statistics().n_bases(), 18ull + 82 + 18 + 7 + 18);
+        EXPECT_TRUE(reader.statistics().position_qual_sums.empty());
+    }
+
+    { // not requested
+        bio::io::seq::reader reader{filename.get_path()};
+        for ([[maybe_unused]] auto & rec : reader) {}
+        EXPECT_EQ(reader.statistics(), bio::io::seq::statistics{});
+    }
+}
+
+TEST(seq_reader, ubam)
+{
+    bio::test::tmp_filename filename{"seq_reader.bam"};
+    bio::io::transparent_ostream{filename.get_path(),
+                                 {.compression = bio::io::compression_format::bgzf, .threads = 2}}
+      << make_ubam(ubam_records);
+
+    for (size_t threads : {1, 2})
+    {
+        bio::io::seq::reader reader{filename.get_path(),
+                                    bio::io::seq::reader_options{.record         = bio::io::seq::record_char_shallow{},
+                                                                 .stream_options = {.threads = threads}}};
+
+        size_t n = 0;
+        for (auto & rec : reader)
+        {
+            EXPECT_EQ(rec.id, ubam_expected[n].name);
+            EXPECT_EQ(rec.seq, ubam_expected[n].seq);
+            EXPECT_EQ(rec.qual, ubam_expected[n].qual);
+            ++n;
+        }
+        EXPECT_EQ(n, ubam_expected.size());
+
+        reader.reopen();
+        EXPECT_EQ(reader.count(), ubam_expected.size());
+    }
+}
+
+TEST(seq_reader, shard)
+{
+    // qualities beginning with '@' and "+" lines with IDs make finding record starts non-trivial
+    std::vector<std::string> ids;
+    std::string              fastq_content;
+    std::string              fasta_content;
+    std::string              fai_content;
+    for (size_t i = 0; i < 3000; ++i)
+    {
+        ids.push_back("read" + std::to_string(i));
+        std::string const seq(i % 97 + 1, "ACGTN"[i % 5]);
+        std::string const qual(i % 97 + 1, "@+!I"[i % 4]);
+        fastq_content += "@" + ids.back() + "\n" + seq + "\n+" + (i % 2 ? ids.back() : "") + "\n" + qual + "\n";
+
+        // FastA with 10 bases per line
+        fasta_content += ">" + ids.back() + "\n";
+        fai_content += ids.back() + "\t" + std::to_string(seq.size()) + "\t" + std::to_string(fasta_content.size()) +
+                       "\t10\t11\n";
+        for (size_t j = 0; j < seq.size(); j += 10)
+            fasta_content += seq.substr(j, 10) + "\n";
+    }
+
+    bio::test::tmp_filename fastq{"seq_reader_shard.fastq"};
+    bio::test::tmp_filename fastq_gz{"seq_reader_shard.fastq.gz"};
+    bio::test::tmp_filename fasta{"seq_reader_shard.fasta"};
+    std::filesystem::path   fasta_fai = fasta.get_path(); // the index is found next to the file
+    fasta_fai += ".fai";
+    {
+        std::ofstream{fastq.get_path(), std::ios::binary} << fastq_content;
+        bio::io::transparent_ostream{fastq_gz.get_path(),
+                                     {.compression = bio::io::compression_format::bgzf, .threads = 2}}
+          << fastq_content;
+        std::ofstream{fasta.get_path(), std::ios::binary} << fasta_content;
+    }
+
+    // reads all shards and checks that every record is read exactly once
+    auto check = [&](std::filesystem::path const & path, size_t const threads)
+    {
+        auto make_reader = [&](size_t const index, size_t const count)
+        {
+            return bio::io::seq::reader{path,
+                                        bio::io::seq::reader_options{.record = bio::io::seq::record_char_shallow{},
+                                                                     .shard  = {.index = index, .count = count},
+                                                                     .stream_options = {.threads = threads}}};
+        };
+
+        for (size_t count : {1ul, 2ul, 3ul, 7ul, 64ul})
+        {
+            std::vector<std::string> read_ids;
+            for (size_t index = 0; index < count; ++index)
+            {
+                auto reader = make_reader(index, count);
+                for (auto & rec : reader)
+                    read_ids.emplace_back(rec.id);
+            }
+            EXPECT_EQ(read_ids, ids) << path << ' ' << threads << ' ' << count;
+        }
+
+        // skipping and batches stop at the end of the shard
+        auto         reader    = make_reader(1, 3);
+        size_t const n_records = reader.count();
+        EXPECT_GT(n_records, 10ull);
+
+        reader.reopen();
+        bio::io::seq::record_batch batch;
+        EXPECT_EQ(reader.read_batch(batch, 10), 10ull);
+        EXPECT_EQ(reader.read_batch(batch, 100000), n_records - 10);
+        EXPECT_EQ(reader.read_batch(batch, 10), 0ull);
+    };
+
+    check(fastq.get_path(), 1);
+    check(fastq_gz.get_path(), 1); // read as GZ
+    check(fastq_gz.get_path(), 2); // read as BGZF
+    check(fasta.get_path(), 1);
+
+    // FastA with FAI index
+    {
+        std::ofstream{fasta_fai, std::ios::binary} << fai_content;
+    }
+    check(fasta.get_path(), 1);
+
+    // errors
+    using opt_t = bio::io::seq::reader_options<>;
+    EXPECT_THROW((bio::io::seq::reader{fastq.get_path(), opt_t{.shard = {.index = 3, .count = 3}}}.begin()),
+                 bio::io::bio_error);
+
+    std::istringstream str{fastq_content};
+    EXPECT_THROW((bio::io::seq::reader{str, bio::io::fastq{}, opt_t{.shard = {.index = 0, .count = 3}}}.begin()),
+                 bio::io::bio_error);
+
+    bio::io::seq::reader       reader{fastq.get_path(), opt_t{.shard = {.index = 0, .count = 3}}};
+    bio::io::seq::record_batch batch;
+    EXPECT_THROW(reader.read_batch_parallel(batch, 2), bio::io::bio_error);
+}
+
+TEST(seq_reader, shard_fasta_with_empty_lines)
+{
+    // the FastA writer separates records by empty lines, so records do not begin where the previous one ends
+    bio::test::tmp_filename fasta{"seq_reader_shard_empty_lines.fasta"};
+    std::filesystem::path   fasta_fai = fasta.get_path();
+    fasta_fai += ".fai";
+
+    std::vector<std::string> ids;
+    {
+        bio::io::seq::writer writer{fasta.get_path(),
+                                    bio::io::seq::writer_options{.max_seq_line_length = 10,
+                                                                 .fai_file            = fasta_fai}};
+        bio::io::seq::record_dna_deep rec;
+        for (size_t i = 0; i < 200; ++i)
+        {
+            rec.id = "read" + std::to_string(i) + " description";
+            rec.seq.assign(i % 37 + 1, bio::alphabet::dna5{}.assign_rank(i % 5));
+            writer.push_back(rec);
+            ids.push_back(rec.id);
+        }
+    }
+
+    for (size_t count : {2ul, 3ul, 7ul})
+    {
+        std::vector<std::string> read_ids;
+        for (size_t index = 0; index < count; ++index)
+        {
+            bio::io::seq::reader reader{fasta.get_path(),
+                                        bio::io::seq::reader_options{.record = bio::io::seq::record_char_shallow{},
+                                                                     .shard  = {.index = index, .count = count}}};
+            for (auto & rec : reader)
+                read_ids.emplace_back(rec.id);
+        }
+        EXPECT_EQ(read_ids, ids) << count;
+    }
+}
+
 TEST(seq_reader, empty_file)
 {
     {
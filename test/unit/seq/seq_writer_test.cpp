@@ -6,12 +6,16 @@
 // shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
 // -----------------------------------------------------------------------------------------------------
 
+#include <span>
+#include <sstream>
+
 #include <gtest/gtest.h>
 
 #include <bio/test/expect_range_eq.hpp>
 #include <bio/test/tmp_filename.hpp>
 
 #include <bio/io/format/fasta.hpp>
+#include <bio/io/seq/record_batch.hpp>
 #include <bio/io/seq/writer.hpp>
 #include <bio/io/stream/transparent_istream.hpp>
 
@@ -246,3 +250,72 @@ TEST(seq_writer, compression)
     std::string                  buffer(std::istreambuf_iterator<char>{decompressor}, std::istreambuf_iterator<char>{});
     EXPECT_RANGE_EQ(buffer, fasta_default_output);
 }
+
+TEST(seq_writer, push_back_batch)
+{
+    using namespace bio::alphabet::literals;
+
+    std::vector<bio::io::seq::record_dna_deep> records;
+    bio::io::seq::record_batch                 batch;
+    for (size_t i = 0; i < 100; ++i)
+    {
+        bio::io::seq::record_dna_deep rec;
+        rec.id = "read" + std::to_string(i);
+        for (size_t j = 0; j < (i * 7) % 160; ++j)
+        {
+            rec.seq.push_back(bio::alphabet::dna5{}.assign_rank(j % 5));
+            rec.qual.push_back(bio::alphabet::phred42{}.assign_rank(j % 42));
+        }
+        batch.push_back(rec);
+        records.push_back(std::move(rec));
+    }
+
+    for (bool fastq : {false, true})
+    {
+        for (bool windows_eol : {false, true})
+        {
+            bio::io::seq::writer_options opt{.windows_eol = windows_eol};
+
+            auto write = [&](std::ostream & stream, auto && fn)
+            {
+                if (fastq)
+                {
+                    bio::io::seq::writer writer{stream, bio::io::fastq{}, opt};
+                    fn(writer);
+                }
+                else
+                {
+                    bio::io::seq::writer writer{stream, bio::io::fasta{}, opt};
+                    fn(writer);
+                }
+            };
+
+            std::ostringstream expected;
+            write(expected,
+                  [&](auto & writer)
+                  {
+                      for (size_t i = 0; i < 2; ++i)
+                          for (auto & rec : records)
+                              writer.push_back(rec);
+                  });
+
+            for (size_t n_threads : {1ul, 2ul, 3ul, 7ul, 200ul})
+            {
+                std::ostringstream actual;
+                write(actual,
+                      [&](auto & writer)
+                      {
+                          writer.push_back(records[0]); // mixed with push_back()
+                          writer.push_back_batch(std::span{records}.subspan(1), n_threads);
+                          writer.push_back_batch(batch, n_threads);
+                      });
+                EXPECT_EQ(actual.str(), expected.str()) << fastq << windows_eol << n_threads;
+            }
+        }
+    }
+
+    bio::test::tmp_filename filename{"seq_writer_batch.fasta"};
+    bio::io::seq::writer    writer{filename.get_path(),
+                                bio::io::seq::writer_options{.fai_file = filename.get_path().string() + ".fai"}};
+    EXPECT_THROW(writer.push_back_batch(records), bio::io::bio_error);
+}
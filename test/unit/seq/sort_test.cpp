@@ -0,0 +1,142 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2022, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2022, Knut Reinert & MPI für molekulare Genetik
+// Copyright (c) 2020-2022, deCODE Genetics
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/bio/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <filesystem>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <bio/test/tmp_directory.hpp>
+
+#include <bio/io/seq/sort.hpp>
+
+using record_t = std::tuple<std::string, std::string, std::string>;
+
+// IDs and sequences with many duplicates; the qualities make every record unique
+std::vector<record_t> const sort_input = []()
+{
+    std::vector<record_t> ret;
+    for (size_t i = 0; i < 5000; ++i)
+    {
+        size_t const      j = (i * 7919) % 1013;
+        std::string const seq(j % 13 + 1, "ACGT"[j % 4]);
+        ret.emplace_back("read" + std::to_string(j), seq, std::string(seq.size() - 1, 'I') + char('!' + i % 40));
+    }
+    return ret;
+}();
+
+std::string to_fastq(std::vector<record_t> const & records)
+{
+    std::string ret;
+    for (auto const & [id, seq, qual] : records)
+        ret += '@' + id + '\n' + seq + "\n+\n" + qual + '\n';
+    return ret;
+}
+
+// sort via the library and read the result
+std::vector<record_t> sort_fastq(bio::io::seq::sort_options const & options, uint64_t & n_written)
+{
+    std::istringstream   istr{to_fastq(sort_input)};
+    bio::io::seq::reader reader{istr,
+                                bio::io::fastq{},
+                                bio::io::seq::reader_options{.record = bio::io::seq::record_char_shallow{}}};
+
+    std::ostringstream ostr;
+    {
+        bio::io::seq::writer writer{ostr, bio::io::fastq{}};
+        n_written = bio::io::seq::sort_records(reader, writer, options);
+    }
+
+    std::vector<record_t> ret;
+    std::istringstream    istr2{ostr.str()};
+    bio::io::seq::reader  reader2{istr2,
+                                 bio::io::fastq{},
+                                 bio::io::seq::reader_options{.record = bio::io::seq::record_char_shallow{}}};
+    for (auto & rec : reader2)
+        ret.emplace_back(std::string{rec.id}, std::string{rec.seq}, std::string{rec.qual});
+    return ret;
+}
+
+// sort via the standard library
+std::vector<record_t> expected_result(bio::io::seq::sort_key const key, bool const collapse)
+{
+    std::vector<record_t> ret  = sort_input;
+    auto                  proj = [&](record_t const & r) -> std::string const &
+    { return key == bio::io::seq::sort_key::id ? get<0>(r) : get<1>(r); };
+
+    std::ranges::stable_sort(ret, {}, proj);
+    if (collapse)
+    {
+        auto [b, e] = std::ranges::unique(ret, {}, proj);
+        ret.erase(b, e);
+    }
+    return ret;
+}
+
+TEST(sort_records, in_memory_and_external)
+{
+    bio::test::tmp_directory dir{};
+
+    for (auto key : {bio::io::seq::sort_key::id, bio::io::seq::sort_key::seq})
+    {
+        for (bool collapse : {false, true})
+        {
+            std::vector<record_t> const expected = expected_result(key, collapse);
+
+            // the input is ~150KB, so the smaller budgets create many runs (the smallest more than are merged at once)
+            for (size_t memory : {1ull << 30, 10'000ull, 1'000ull})
+            {
+                for (size_t threads : {1ul, 3ul})
+                {
+                    uint64_t n_written = 0;
+                    auto     result    = sort_fastq(bio::io::seq::sort_options{.collapse_duplicates = collapse,
+                                                                               .key                 = key,
+                                                                               .memory              = memory,
+                                                                               .threads             = threads,
+                                                                               .tmp_dir             = dir.path()},
+                                             n_written);
+
+                    EXPECT_EQ(n_written, expected.size());
+                    EXPECT_TRUE(result == expected) << int(key) << collapse << ' ' << memory << ' ' << threads;
+
+                    // temporary files are removed
+                    EXPECT_TRUE(std::filesystem::is_empty(dir.path()));
+                }
+            }
+        }
+    }
+}
+
+TEST(sort_records, reader_at_end)
+{
+    std::istringstream   istr{to_fastq(sort_input)};
+    bio::io::seq::reader reader{istr, bio::io::fastq{}};
+    std::ostringstream   ostr;
+    bio::io::seq::writer writer{ostr, bio::io::fastq{}};
+
+    EXPECT_EQ(reader.count(), sort_input.size());
+    EXPECT_EQ(bio::io::seq::sort_records(reader, writer, bio::io::seq::sort_options{.memory = 1}), 0ull);
+}
+
+TEST(sort_records, errors)
+{
+    std::istringstream   istr{to_fastq(sort_input)};
+    bio::io::seq::reader reader{istr, bio::io::fastq{}};
+    std::ostringstream   ostr;
+    bio::io::seq::writer writer{ostr, bio::io::fastq{}};
+
+    EXPECT_THROW(bio::io::seq::sort_records(
+                   reader,
+                   writer,
+                   bio::io::seq::sort_options{.memory = 1, .tmp_dir = "/this/directory/does/not/exist"}),
+                 bio::io::file_open_error);
+}
@@ -0,0 +1,70 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2022, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2022, Knut Reinert & MPI für molekulare Genetik
+// Copyright (c) 2020-2022, deCODE Genetics
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/bio/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <bio/io/seq/statistics.hpp>
+
+using stats_t = bio::io::seq::statistics;
+
+TEST(statistics, add)
+{
+    stats_t stats;
+    stats.add("ACGTN", "!!I5+");
+    stats.add("acGu", "");
+    stats.add("", "");
+    stats.add("CC-", "II5");
+
+    EXPECT_EQ(stats.n_records, 4ull);
+    EXPECT_EQ(stats.n_bases(), 12ull);
+    EXPECT_EQ(stats.length_histogram, (std::vector<uint64_t>{1, 0, 0, 1, 1, 1}));
+    EXPECT_EQ(stats.qual_length_histogram, (std::vector<uint64_t>{0, 0, 0, 1, 0, 1}));
+
+    // A, C, G, T, other
+    std::vector<std::array<uint64_t, 5>> const position_base_counts{
+      {{2, 1, 0, 0, 0}, {0, 3, 0, 0, 0}, {0, 0, 2, 0, 1}, {0, 0, 0, 2, 0}, {0, 0, 0, 0, 1}}
+    };
+    EXPECT_EQ(stats.position_base_counts, position_base_counts);
+    EXPECT_EQ(stats.base_counts(), (std::array<uint64_t, 5>{2, 4, 2, 2, 2}));
+    EXPECT_DOUBLE_EQ(stats.gc_content(), 0.6);
+
+    EXPECT_EQ(stats.position_qual_sums, (std::vector<uint64_t>{40, 40, 60, 20, 10}));
+    EXPECT_EQ(stats.mean_qual_per_position(), (std::vector<double>{20, 20, 30, 20, 10}));
+}
+
+TEST(statistics, merge)
+{
+    stats_t all;
+    stats_t part1;
+    stats_t part2;
+
+    all.add("ACGTN", "!!I5+");
+    part1.add("ACGTN", "!!I5+");
+    all.add("GGGGGGGG", "IIIIIIII");
+    part2.add("GGGGGGGG", "IIIIIIII");
+    all.add("T", "");
+    part2.add("T", "");
+
+    part1 += part2;
+    EXPECT_EQ(part1, all);
+
+    part1.clear();
+    EXPECT_EQ(part1, stats_t{});
+}
+
+TEST(statistics, empty)
+{
+    stats_t stats;
+    EXPECT_EQ(stats.n_bases(), 0ull);
+    EXPECT_EQ(stats.gc_content(), 0);
+    EXPECT_TRUE(stats.mean_qual_per_position().empty());
+}
@@ -0,0 +1,152 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2022, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2022, Knut Reinert & MPI für molekulare Genetik
+// Copyright (c) 2020-2022, deCODE Genetics
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/bio/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <sstream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <bio/alphabet/custom/char.hpp>
+
+#include <bio/io/seq/reader.hpp>
+#include <bio/io/seq/trim.hpp>
+#include <bio/io/seq/writer.hpp>
+
+using bio::io::seq::trim_interval;
+using bio::io::seq::trim_options;
+using bio::io::seq::trimmer;
+
+std::string const adapter_3p = "AGATCGGAAGAGC";
+std::string const adapter_5p = "ACACTCTTTCCCTACACGACGCTCTTCCGATCT";
+std::string const insert     = "TTGCATCCATTACAGCTA";
+
+TEST(trimmer, disabled)
+{
+    trimmer const trim{trim_options{}};
+    EXPECT_EQ(trim("ACGTGGGGGGGGGGGG", "################"), (trim_interval{0, 16}));
+    EXPECT_EQ(trim("", ""), (trim_interval{0, 0}));
+}
+
+TEST(trimmer, quality)
+{
+    trimmer const trim{trim_options{.qual_cutoff = 20}};
+
+    // the window "I###" is the first with a mean below 20; its leading good base is kept
+    EXPECT_EQ(trim("ACGTACGTAC", "IIIIII####"), (trim_interval{0, 6}));
+    EXPECT_EQ(trim("ACGTACGTAC", "IIIIII#III"), (trim_interval{0, 10}));
+    EXPECT_EQ(trim("ACGTACGTAC", "##########"), (trim_interval{0, 0}));
+    EXPECT_EQ(trim("AC", "I#"), (trim_interval{0, 2})); // window is shortened to the read
+    EXPECT_EQ(trim("ACGT", ""), (trim_interval{0, 4}));  // no qualities
+
+    trimmer const trim64{trim_options{.qual_cutoff = 20, .qual_offset = 64, .qual_window = 1}};
+    EXPECT_EQ(trim64("ACGTACGTAC", "hhhhhhhBhh"), (trim_interval{0, 7}));
+}
+
+TEST(trimmer, poly_g)
+{
+    trimmer const trim{trim_options{.poly_g_min_length = 10}};
+
+    EXPECT_EQ(trim("ACGTACGT" + std::string(12, 'G'), ""), (trim_interval{0, 8}));
+    EXPECT_EQ(trim("ACGTA" + std::string("GGGGAGGGGGGg"), ""), (trim_interval{0, 5})); // one mismatch tolerated
+    EXPECT_EQ(trim("ACGTGGGGGGGGGA", ""), (trim_interval{0, 4}));                       // trailing mismatch
+    EXPECT_EQ(trim("ACGTGGGGGG", ""), (trim_interval{0, 10}));                          // too short
+    EXPECT_EQ(trim("GGGGAGAGAGGGGGGG", ""), (trim_interval{0, 16}));                    // too many mismatches
+}
+
+TEST(trimmer, adapter_3p)
+{
+    trimmer const trim{trim_options{.adapters_3p = {adapter_3p}}};
+
+    // complete adapter, exact and with errors
+    EXPECT_EQ(trim(insert + adapter_3p + "ACGT", ""), (trim_interval{0, insert.size()}));
+    EXPECT_EQ(trim(insert + "AGATCGCAAGAGC" + "ACGT", ""), (trim_interval{0, insert.size()})); // substitution
+    EXPECT_EQ(trim(insert + "AGATCGAAGAGC" + "ACGT", ""), (trim_interval{0, insert.size()}));  // deletion
+    EXPECT_EQ(trim(insert + "agatcggaagagc", ""), (trim_interval{0, insert.size()}));          // lower-case
+
+    // too many errors
+    EXPECT_EQ(trim(insert + "AGCTCGCAAGAGC" + "ACGT", ""), (trim_interval{0, insert.size() + 17}));
+
+    // partial adapter at the end
+    EXPECT_EQ(trim(insert + "AGATCG", ""), (trim_interval{0, insert.size()}));
+    EXPECT_EQ(trim(insert + "AGA", ""), (trim_interval{0, insert.size()}));
+    EXPECT_EQ(trim(insert.substr(0, 17) + "GA", ""), (trim_interval{0, 19})); // shorter than the minimum overlap
+    EXPECT_EQ(trim("AGATC", ""), (trim_interval{0, 0}));                     // read shorter than adapter
+
+    // adapter with N
+    trimmer const trim_n{trim_options{.adapters_3p = {"AGANCGG"}}};
+    EXPECT_EQ(trim_n(insert + "AGATCGG", ""), (trim_interval{0, insert.size()}));
+}
+
+TEST(trimmer, adapter_5p)
+{
+    trimmer const trim{trim_options{.adapters_5p = {adapter_5p}}};
+
+    EXPECT_EQ(trim("TTT" + adapter_5p + insert, ""), (trim_interval{3 + adapter_5p.size(), insert.size() + 36}));
+    EXPECT_EQ(trim("CGATCT" + insert, ""), (trim_interval{6, insert.size() + 6})); // partial adapter
+    EXPECT_EQ(trim(insert, ""), (trim_interval{0, insert.size()}));
+}
+
+TEST(trimmer, all_steps)
+{
+    trimmer const trim{trim_options{.adapters_3p       = {adapter_3p},
+                                    .adapters_5p       = {adapter_5p},
+                                    .poly_g_min_length = 10,
+                                    .qual_cutoff       = 20}};
+
+    std::string const seq = "TCCGATCT" + insert + adapter_3p + std::string(12, 'G');
+    std::string       qual(seq.size(), 'I');
+    qual[qual.size() - 15] = '#';
+
+    EXPECT_EQ(trim(seq, qual), (trim_interval{8, 8 + insert.size()}));
+}
+
+TEST(trimmer, batch)
+{
+    trimmer const trim{trim_options{.adapters_3p = {adapter_3p}, .qual_cutoff = 20, .threads = 3}};
+
+    // enough records for multiple threads
+    std::string input;
+    std::string expected;
+    for (size_t i = 0; i < 3000; ++i)
+    {
+        std::string const seq  = insert.substr(0, 5 + i % 13) + adapter_3p.substr(0, i % 17);
+        std::string const qual = std::string(seq.size() - 2, 'I') + "##";
+        input += "@r" + std::to_string(i) + '\n' + seq + "\n+\n" + qual + '\n';
+
+        auto const [beg, end] = trim(seq, qual);
+        expected += "@r" + std::to_string(i) + '\n' + seq.substr(beg, end - beg) + "\n+\n" +
+                    qual.substr(beg, end - beg) + '\n';
+    }
+
+    std::istringstream   istr{input};
+    bio::io::seq::reader reader{istr, bio::io::fastq{}};
+
+    std::ostringstream ostr;
+    {
+        bio::io::seq::writer writer{ostr, bio::io::fastq{}};
+
+        bio::io::seq::record_batch<> batch;
+        bio::io::seq::trimmed_batch  trimmed;
+        while (reader.read_batch(batch, 2000) > 0)
+        {
+            trim(batch, trimmed);
+            EXPECT_EQ(trimmed.size(), batch.size());
+            writer.push_back_batch(trimmed, 2);
+        }
+    }
+
+    EXPECT_LT(expected.size(), input.size()); // something was trimmed
+    EXPECT_EQ(ostr.str(), expected);
+}
+
+TEST(trimmer, errors)
+{
+    EXPECT_THROW(trimmer{trim_options{.adapters_3p = {""}}}, bio::io::bio_error);
+    EXPECT_THROW(trimmer{trim_options{.adapter_error_rate = 1}}, bio::io::bio_error);
+    EXPECT_THROW(trimmer{trim_options{.qual_window = 0}}, bio::io::bio_error);
+}
@@ -0,0 +1,112 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2022, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2022, Knut Reinert & MPI für molekulare Genetik
+// Copyright (c) 2020-2022, deCODE Genetics
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/bio/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <sstream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <bio/test/tmp_filename.hpp>
+
+#include <bio/io/txt/line_index.hpp>
+#include <bio/io/txt/reader.hpp>
+#include <bio/io/txt/writer.hpp>
+
+// more lines than fit into a single BGZF block
+inline constexpr size_t n_lines = 20000;
+
+std::string expected_line(size_t const i)
+{
+    return "line" + std::to_string(i) + "\tfield\t" + std::to_string(i * 3);
+}
+
+bio::io::txt::line_index write_test_file(std::filesystem::path const & path, size_t const stride)
+{
+    bio::io::txt::writer writer{path, '\t', {.threads = 2}};
+    writer.record_line_index(stride);
+    for (size_t i = 0; i < n_lines; ++i)
+        writer.emplace_back("line" + std::to_string(i), "field", i * 3);
+
+    return writer.recorded_line_index();
+}
+
+void test_random_access(std::filesystem::path const & path, size_t const reader_threads = 1)
+{
+    bio::io::txt::line_index idx_written = write_test_file(path, 100);
+
+    EXPECT_EQ(idx_written.n_lines, n_lines);
+    EXPECT_EQ(idx_written.offsets.size(), n_lines / 100);
+
+    // build index by reading
+    bio::io::txt::line_index idx_built = bio::io::txt::line_index::build(path, 100);
+    EXPECT_EQ(idx_built.n_lines, idx_written.n_lines);
+    EXPECT_EQ(idx_built.offsets, idx_written.offsets);
+
+    // write and read from disk
+    bio::test::tmp_filename idx_file{"line_index_test.lidx"};
+    idx_written.write(idx_file.get_path());
+    bio::io::txt::line_index idx_read;
+    idx_read.read(idx_file.get_path());
+    EXPECT_EQ(idx_read.stride, idx_written.stride);
+    EXPECT_EQ(idx_read.n_lines, idx_written.n_lines);
+    EXPECT_EQ(idx_read.offsets, idx_written.offsets);
+
+    bio::io::txt::reader reader{path, '\t', bio::io::txt::header_kind::none, {.threads = reader_threads}};
+    reader.set_line_index(idx_read);
+
+    for (size_t n : {0ul, 1ul, 99ul, 100ul, 101ul, 7777ul, 19999ul, 5ul})
+    {
+        reader.seek_to_line(n);
+        auto it = reader.begin();
+        ASSERT_TRUE(it != reader.end()) << n;
+        EXPECT_EQ(it->line, expected_line(n));
+        ASSERT_EQ(it->fields.size(), 3u);
+        EXPECT_EQ(it->fields[2], std::to_string(n * 3));
+    }
+
+    reader.seek_to_line(n_lines);
+    EXPECT_TRUE(reader.begin() == reader.end());
+
+    size_t i = 12345;
+    for (auto & rec : reader.read_lines(12345, 12555))
+        EXPECT_EQ(rec.line, expected_line(i++));
+    EXPECT_EQ(i, 12555u);
+
+    i = 19990;
+    for (auto & rec : reader.read_lines(19990, 30000))
+        EXPECT_EQ(rec.line, expected_line(i++));
+    EXPECT_EQ(i, n_lines);
+
+    auto empty = reader.read_lines(50, 50);
+    EXPECT_TRUE(empty.begin() == empty.end());
+}
+
+TEST(line_index, uncompressed)
+{
+    bio::test::tmp_filename filename{"line_index_test.tsv"};
+    test_random_access(filename.get_path());
+}
+
+TEST(line_index, bgzf)
+{
+    bio::test::tmp_filename filename{"line_index_test.tsv.gz"};
+    test_random_access(filename.get_path());
+}
+
+TEST(line_index, bgzf_threaded_decompression)
+{
+    bio::test::tmp_filename filename{"line_index_test.tsv.gz"};
+    test_random_access(filename.get_path(), 2);
+}
+
+TEST(line_index, no_index)
+{
+    std::istringstream   str{"foo\nbar\n"};
+    bio::io::txt::reader reader{str};
+    EXPECT_THROW(reader.seek_to_line(1), bio::io::bio_error);
+}
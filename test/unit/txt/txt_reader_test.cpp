@@ -349,3 +349,52 @@ TEST(reader, no_eol)
     ASSERT_TRUE(it == reader.end());
     EXPECT_EQ(reader.header(), "header");
 }
+
+TEST(reader, skip_and_count)
+{
+    {
+        std::istringstream   str{static_cast<std::string>(input_with_header)};
+        bio::io::txt::reader reader{str, bio::io::txt::header_kind::starts_with{'#'}};
+
+        EXPECT_EQ(reader.skip(2), 2ull);
+        auto it = reader.begin();
+        ASSERT_TRUE(it != reader.end());
+        EXPECT_EQ(*it, lines_comp[2]);
+        EXPECT_THROW(reader.skip(1), std::runtime_error);
+    }
+
+    {
+        std::istringstream   str{static_cast<std::string>(input_no_header)};
+        bio::io::txt::reader reader{str, ' '};
+
+        EXPECT_EQ(reader.count(), 3ull);
+        EXPECT_TRUE(reader.begin() == reader.end());
+    }
+
+    { // no newline at end, many lines and small buffers
+        std::string in;
+        for (size_t i = 0; i < 10000; ++i)
+            in += std::to_string(i) + (i % 7 == 0 ? "\t\t\t\t\t\t\t\t\t\n" : "\n");
+        in.pop_back();
+
+        for (size_t buffer_size : {3, 4096})
+        {
+            bio::test::tmp_filename filename{"txt_test"};
+            {
+                std::ofstream fi{filename.get_path()};
+                fi << in;
+            }
+
+            bio::io::txt::reader reader{filename.get_path(),
+                                        bio::io::txt::header_kind::none,
+                                        bio::io::transparent_istream_options{.buffer1_size = buffer_size}};
+
+            EXPECT_EQ(reader.skip(1234), 1234ull);
+            EXPECT_EQ(*reader.begin(), "1234");
+        }
+
+        std::istringstream   str{in};
+        bio::io::txt::reader reader{str};
+        EXPECT_EQ(reader.count(), 10000ull);
+    }
+}
@@ -7,6 +7,9 @@
 // -----------------------------------------------------------------------------------------------------
 
 #include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -156,4 +159,61 @@ TEST(writer, field_wise_emplace_back_file)
     EXPECT_EQ(buffer.str(), compare);
 }
 
+TEST(writer, push_back_batch)
+{
+    struct row
+    {
+        std::string name;
+        int         pos;
+        double      score;
+    };
+
+    std::vector<row> rows;
+    for (int i = 0; i < 1000; ++i)
+        rows.push_back(row{"chr" + std::to_string(i % 23), i * 7, i / 8.0});
+
+    auto proj = [](row const & r) { return std::tie(r.name, r.pos, r.score); };
+
+    std::ostringstream sequential;
+    {
+        bio::io::txt::writer writer{sequential, '\t'};
+        for (row const & r : rows)
+            std::apply([&](auto const &... args) { writer.emplace_back(args...); }, proj(r));
+    }
+
+    for (size_t n_threads : {1, 3, 8})
+    {
+        std::ostringstream batched;
+        {
+            bio::io::txt::writer writer{batched, '\t'};
+            writer.push_back_batch(rows, proj, n_threads);
+        }
+        EXPECT_EQ(batched.str(), sequential.str());
+    }
+}
+
+TEST(writer, push_back_batch_line_wise)
+{
+    std::vector<std::string_view> lines{"foo bar", "bax", "bat baz 3.4 7"};
+
+    std::ostringstream str;
+    {
+        bio::io::txt::writer writer{str};
+        writer.push_back_batch(lines, std::identity{}, 2);
+    }
+
+    EXPECT_EQ(str.str(), compare);
+}
+
+TEST(writer, push_back_batch_empty)
+{
+    std::ostringstream str;
+    {
+        bio::io::txt::writer writer{str};
+        writer.push_back_batch(std::vector<std::string>{});
+    }
+
+    EXPECT_EQ(str.str(), "");
+}
+
 // TODO write by record
@@ -6,6 +6,11 @@
 // shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
 // -----------------------------------------------------------------------------------------------------
 
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include <bio/test/expect_range_eq.hpp>
@@ -13,8 +18,15 @@
 #include <bio/test/tmp_directory.hpp>
 #include <bio/test/tmp_filename.hpp>
 
+#include <bio/io/detail/index_gzi.hpp>
+#include <bio/io/detail/index_tabix.hpp>
 #include <bio/io/var/reader.hpp>
 
+#ifndef BIOCPP_IO_DATA_DIR
+#    error "BIOCPP_IO_DATA_DIR not defined. This is required."
+#endif
+
+#include "../format/bcf_data.hpp"
 #include "../format/vcf_data.hpp"
 
 TEST(var_reader, concepts)
@@ -168,6 +180,40 @@ TEST(var_reader, iteration)
     }
 }
 
+TEST(var_reader, skip_and_count)
+{
+    {
+        std::istringstream   str{static_cast<std::string>(example_from_spec)};
+        bio::io::var::reader reader{str, bio::io::vcf{}};
+
+        EXPECT_EQ(reader.skip(3), 3ull);
+        EXPECT_EQ(reader.front().pos, 1230237);
+        EXPECT_EQ(reader.count(), 2ull);
+        EXPECT_TRUE(reader.begin() == reader.end());
+    }
+
+    {
+        std::istringstream   str{static_cast<std::string>(example_from_spec_bcf)};
+        bio::io::var::reader reader{str, bio::io::bcf{}};
+
+        EXPECT_EQ(reader.skip(3), 3ull);
+        EXPECT_EQ(reader.front().pos, 1230237);
+        EXPECT_EQ(reader.count(), 2ull);
+    }
+
+    { // region is considered
+        bio::io::genomic_region region{.chrom = "20", .beg = 17000, .end = 1230300};
+        std::istringstream      str{static_cast<std::string>(example_from_spec)};
+        bio::io::var::reader    reader{
+          str,
+          bio::io::vcf{                            },
+          { .region = region,.region_index_optional = true}
+        };
+
+        EXPECT_EQ(reader.count(), 3ull);
+    }
+}
+
 TEST(var_reader, empty_file)
 {
     {
@@ -336,6 +382,352 @@ TEST(var_reader, region_filter_linear)
     }
 }
 
+TEST(var_reader, region_filter_multiple)
+{
+    // unsorted, overlapping and on a chromosome that is not in the file
+    std::vector<bio::io::genomic_region> const regions{
+      {.chrom = "20", .beg = 1230000, .end = 1230300},
+      {.chrom = "21", .beg =       0, .end =     100},
+      {.chrom = "20", .beg =   17000, .end =   20000},
+      {.chrom = "20", .beg =   17300, .end =   17400}
+    };
+
+    bio::test::tmp_directory dir{};
+
+    {
+        std::ofstream os{dir.path() / "example.vcf.gz", std::ios::binary};
+        os << example_from_spec_bgzipped;
+    }
+
+    {
+        std::ofstream os{dir.path() / "example.vcf.gz.tbi", std::ios::binary};
+        os << example_from_spec_bgzipped_tbi;
+    }
+
+    {
+        bio::io::var::reader reader{dir.path() / "example.vcf.gz", {.regions = regions}};
+
+        std::vector<int64_t> positions;
+        for (auto & rec : reader)
+            positions.push_back(rec.pos);
+        EXPECT_RANGE_EQ(positions, (std::vector<int64_t>{17330, 1230237}));
+    }
+
+    { // without an index
+        std::istringstream   str{static_cast<std::string>(example_from_spec)};
+        bio::io::var::reader reader{str, bio::io::vcf{}, {.region_index_optional = true, .regions = regions}};
+
+        std::vector<int64_t> positions;
+        for (auto & rec : reader)
+            positions.push_back(rec.pos);
+        EXPECT_RANGE_EQ(positions, (std::vector<int64_t>{17330, 1230237}));
+    }
+
+    std::filesystem::remove(dir.path() / "example.vcf.gz");
+    std::filesystem::remove(dir.path() / "example.vcf.gz.tbi");
+}
+
+//!\brief Position and length of the records of `reader`.
+std::vector<std::pair<int64_t, size_t>> positions_and_lengths(auto & reader)
+{
+    std::vector<std::pair<int64_t, size_t>> ret;
+    for (auto & rec : reader)
+        ret.emplace_back(rec.pos, std::ranges::size(rec.ref));
+    return ret;
+}
+
+//!\brief The records that overlap at least one of the regions, in file order.
+std::vector<std::pair<int64_t, size_t>> overlapping(std::vector<std::pair<int64_t, size_t>> const & records,
+                                                    std::vector<bio::io::genomic_region> const &  regions)
+{
+    std::vector<std::pair<int64_t, size_t>> ret;
+    for (auto [pos, length] : records)
+    {
+        if (std::ranges::any_of(regions,
+                                [&](bio::io::genomic_region const & r)
+                                { return pos - 1 < r.end && pos - 1 + (int64_t)length > r.beg && r.chrom == "20"; }))
+        {
+            ret.emplace_back(pos, length);
+        }
+    }
+    return ret;
+}
+
+TEST(var_reader, region_filter_multiple_blocks)
+{
+    std::filesystem::path input = BIOCPP_IO_DATA_DIR;
+    input /= "../format/1000G_chr10_sample.vcf.gz";
+
+    std::vector<std::pair<int64_t, size_t>> all;
+    {
+        bio::io::var::reader reader{input};
+        all = positions_and_lengths(reader);
+    }
+    ASSERT_EQ(all.size(), 500u);
+
+    // many small regions near the records in shuffled order (some overlapping), some between the records,
+    // a large one and some without records
+    std::vector<bio::io::genomic_region> regions;
+    for (size_t i = 0; i < 150; ++i)
+    {
+        int64_t const beg = all[i * 7919 % all.size()].first - 1 - (int64_t)(i % 7) * 20;
+        regions.push_back({.chrom = "20", .beg = beg, .end = beg + 1 + (int64_t)(i * i % 60)});
+    }
+    for (int64_t i = 0; i < 50; ++i)
+        regions.push_back({.chrom = "20", .beg = 10'000'000 + i * 10'000, .end = 10'000'000 + i * 10'000 + 100});
+    regions.push_back({.chrom = "20", .beg = 36'934'000, .end = 36'935'000});
+    regions.push_back({.chrom = "20", .beg = 60'000'000, .end = 70'000'000});
+    regions.push_back({.chrom = "X", .beg = 0, .end = 70'000'000});
+
+    std::vector<std::pair<int64_t, size_t>> const expected = overlapping(all, regions);
+    ASSERT_GT(expected.size(), 100u);
+    ASSERT_LT(expected.size(), 400u);
+
+    for (size_t threads : {1, 2})
+    {
+        bio::io::var::reader reader{input, {.regions = regions, .stream_options = {.threads = threads}}};
+        EXPECT_RANGE_EQ(positions_and_lengths(reader), expected);
+
+        // the index is re-used
+        std::vector<bio::io::genomic_region> const less_regions{regions.begin(), regions.begin() + 50};
+        reader.reopen(less_regions);
+        EXPECT_RANGE_EQ(positions_and_lengths(reader), overlapping(all, less_regions));
+
+        // one region after the other returns records that overlap multiple regions repeatedly
+        size_t count = 0;
+        for (bio::io::genomic_region const & region : less_regions)
+        {
+            reader.reopen(region);
+            count += std::ranges::distance(reader);
+        }
+        size_t expected_count = 0;
+        for (bio::io::genomic_region const & region : less_regions)
+            expected_count += overlapping(all, {region}).size();
+        EXPECT_EQ(count, expected_count);
+    }
+
+    { // without an index
+        std::ifstream        str{input, std::ios::binary};
+        bio::io::var::reader reader{str, bio::io::vcf{}, {.region_index_optional = true, .regions = regions}};
+        EXPECT_RANGE_EQ(positions_and_lengths(reader), expected);
+    }
+}
+
+//!\brief The smallest Tabix bin that contains [beg, end).
+uint32_t reg2bin(uint32_t const beg, uint32_t end)
+{
+    --end;
+    for (uint32_t shift = 14, first = 4681; shift < 29; shift += 3, first = (first - 1) / 8)
+        if (beg >> shift == end >> shift)
+            return first + (beg >> shift);
+    return 0;
+}
+
+/*!\brief Write a Tabix index for a BGZF compressed VCF file.
+ * \details
+ *
+ * Unlike htslib, this does not move the chunks of small bins to their parent bins, so regions have many chunks even
+ * for small files.
+ */
+void write_tabix_index(std::filesystem::path const & path)
+{
+    using index_t = bio::io::detail::tabix_index;
+
+    bio::io::detail::gzi_index const gzi = bio::io::detail::gzi_index::build(path);
+    std::string                      content;
+    {
+        bio::io::transparent_istream istr{path};
+        content.assign(std::istreambuf_iterator<char>{istr}, std::istreambuf_iterator<char>{});
+    }
+
+    index_t index{};
+    std::ranges::copy(index_t::magic_bytes, index.core.magic);
+    index.core.format  = 2;
+    index.core.col_seq = 1;
+    index.core.col_beg = 2;
+    index.core.meta    = '#';
+
+    std::vector<std::map<uint32_t, std::vector<index_t::chunk_t>>> bins;
+    uint64_t                                                       line_beg = 0;
+    for (std::string_view line : content | bio::io::detail::eager_split('\n'))
+    {
+        uint64_t const line_end = line_beg + line.size() + 1;
+        if (!line.empty() && !line.starts_with('#'))
+        {
+            std::vector<std::string_view> fields;
+            for (std::string_view field : line | bio::io::detail::eager_split('\t'))
+                fields.push_back(field);
+
+            if (index.names.empty() || index.names.back() != fields[0])
+            {
+                index.names.emplace_back(fields[0]);
+                index.indexes.emplace_back();
+                bins.emplace_back();
+            }
+
+            uint32_t const beg = std::stoul(std::string{fields[1]}) - 1;
+            uint32_t const end = beg + fields[3].size();
+
+            uint64_t const                   voffset_beg = gzi.to_virtual_offset(line_beg);
+            uint64_t const                   voffset_end = gzi.to_virtual_offset(line_end);
+            std::vector<index_t::chunk_t> & chunks      = bins.back()[reg2bin(beg, end)];
+            if (!chunks.empty() && chunks.back().cnk_end == voffset_beg)
+                chunks.back().cnk_end = voffset_end;
+            else
+                chunks.push_back({voffset_beg, voffset_end});
+
+            std::vector<uint64_t> & offsets = index.indexes.back().offsets;
+            if (offsets.size() <= (end - 1) >> 14)
+                offsets.resize(((end - 1) >> 14) + 1, std::numeric_limits<uint64_t>::max());
+            for (uint32_t window = beg >> 14; window <= (end - 1) >> 14; ++window)
+                offsets[window] = std::min(offsets[window], voffset_beg);
+        }
+        line_beg = line_end;
+    }
+
+    for (size_t i = 0; i < index.indexes.size(); ++i)
+    {
+        for (auto & [bin, chunks] : bins[i])
+            index.indexes[i].bins.push_back({bin, std::move(chunks)});
+
+        // windows without records get the offset of the previous window
+        std::vector<uint64_t> & offsets = index.indexes[i].offsets;
+        for (size_t window = 0; window < offsets.size(); ++window)
+            if (offsets[window] == std::numeric_limits<uint64_t>::max())
+                offsets[window] = window == 0 ? 0 : offsets[window - 1];
+
+        index.core.l_nm += index.names[i].size() + 1;
+    }
+    index.core.n_ref = index.names.size();
+
+    index.write(path.string() + ".tbi");
+}
+
+TEST(var_reader, region_filter_multiple_chunks)
+{
+    bio::test::tmp_directory     dir{};
+    std::filesystem::path const path = dir.path() / "chunks.vcf.gz";
+
+    // two chromosomes with a record every 10bp, every 100th is long; spans many blocks
+    std::vector<std::tuple<std::string, int64_t, size_t>> all;
+    {
+        bio::io::transparent_ostream ostr{path, {.threads = 2}};
+        ostr << "##fileformat=VCFv4.3\n##contig=<ID=1>\n##contig=<ID=2>\n##contig=<ID=3>\n"
+                "#CHROM\tPOS\tID\tREF\tALT\tQUAL\tFILTER\tINFO\n";
+        for (std::string const chrom : {"1", "2"})
+        {
+            for (int64_t pos = 1; pos < 300'000; pos += 10)
+            {
+                std::string const ref = pos % 1000 == 991 ? std::string(40, 'A') : "A";
+                ostr << chrom << '\t' << pos << "\t.\t" << ref << "\tC\t.\t.\t.\n";
+                all.emplace_back(chrom, pos, ref.size());
+            }
+        }
+    }
+    write_tabix_index(path);
+
+    // clusters of small regions in shuffled order, separated by blocks without regions
+    std::vector<bio::io::genomic_region> regions;
+    for (int64_t i = 0; i < 120; ++i)
+    {
+        int64_t const beg = (i * 7 % 6) * 50'000 + (i * 37 % 100) * 30;
+        regions.push_back({.chrom = i % 2 ? "2" : "1", .beg = beg, .end = beg + 1 + i % 25});
+    }
+    regions.push_back({.chrom = "3", .beg = 0, .end = 1000});
+    regions.push_back({.chrom = "X", .beg = 0, .end = 1000});
+
+    std::vector<std::tuple<std::string, int64_t, size_t>> expected;
+    for (auto const & [chrom, pos, length] : all)
+    {
+        bool const overlaps = std::ranges::any_of(regions,
+                                                  [&](bio::io::genomic_region const & r) {
+                                                      return r.chrom == chrom && pos - 1 < r.end &&
+                                                             pos - 1 + (int64_t)length > r.beg;
+                                                  });
+        if (overlaps)
+            expected.emplace_back(chrom, pos, length);
+    }
+    ASSERT_GT(expected.size(), 100u);
+
+    for (size_t threads : {1, 2})
+    {
+        bio::io::var::reader reader{path, {.regions = regions, .stream_options = {.threads = threads}}};
+
+        std::vector<std::tuple<std::string, int64_t, size_t>> records;
+        for (auto & rec : reader)
+            records.emplace_back(rec.chrom, rec.pos, std::ranges::size(rec.ref));
+        EXPECT_RANGE_EQ(records, expected);
+    }
+}
+
+TEST(var_reader, region_filter_long_record)
+{
+    bio::test::tmp_directory     dir{};
+    std::filesystem::path const path = dir.path() / "long.vcf.gz";
+
+    /* Two long deletions: the first one overlaps the first two regions, so the reader scans from its chunk. The
+     * second one overlaps the last two regions; its chunk is passed while scanning, before the reader moves on to
+     * the last region (whose first chunk it is). */
+    std::vector<std::tuple<std::string, int64_t, size_t>> all;
+    {
+        bio::io::transparent_ostream ostr{path, {.threads = 2}};
+        ostr << "##fileformat=VCFv4.3\n##contig=<ID=1>\n#CHROM\tPOS\tID\tREF\tALT\tQUAL\tFILTER\tINFO\n";
+        for (int64_t pos = 1; pos < 300'000; pos += 10)
+        {
+            std::string ref = "A";
+            if (pos == 20'001)
+                ref.assign(40'000, 'A');
+            else if (pos == 55'001)
+                ref.assign(50'000, 'A');
+            ostr << "1\t" << pos << "\t.\t" << ref << "\tC\t.\t.\t.\n";
+            all.emplace_back("1", pos, ref.size());
+        }
+    }
+    write_tabix_index(path);
+
+    std::vector<bio::io::genomic_region> regions;
+    for (int64_t const beg : {20'100, 58'000, 100'000})
+        regions.push_back({.chrom = "1", .beg = beg, .end = beg + 50});
+
+    std::vector<std::tuple<std::string, int64_t, size_t>> expected;
+    for (auto const & [chrom, pos, length] : all)
+    {
+        bool const overlaps = std::ranges::any_of(regions,
+                                                  [&](bio::io::genomic_region const & r)
+                                                  { return pos - 1 < r.end && pos - 1 + (int64_t)length > r.beg; });
+        if (overlaps)
+            expected.emplace_back(chrom, pos, length);
+    }
+    ASSERT_EQ(expected.size(), 17u);
+
+    auto records = [](auto & reader)
+    {
+        std::vector<std::tuple<std::string, int64_t, size_t>> ret;
+        for (auto & rec : reader)
+            ret.emplace_back(rec.chrom, rec.pos, std::ranges::size(rec.ref));
+        return ret;
+    };
+
+    for (size_t threads : {1, 2})
+    {
+        bio::io::var::reader reader{path, {.regions = regions, .stream_options = {.threads = threads}}};
+        EXPECT_RANGE_EQ(records(reader), expected);
+    }
+
+    /* Without a file name, the position reached cannot be determined in single-threaded mode, so the reader jumps
+     * back to chunks that it has already scanned and skips the records that it has read before. */
+    for (size_t threads : {1, 2})
+    {
+        std::ifstream        str{path, std::ios::binary};
+        bio::io::var::reader reader{str,
+                                    bio::io::vcf{},
+                                    {.region_index_file = path.string() + ".tbi",
+                                     .regions           = regions,
+                                     .stream_options    = {.threads = threads}}};
+        EXPECT_RANGE_EQ(records(reader), expected);
+    }
+}
+
 TEST(var_reader, reopen)
 {
     bio::test::tmp_directory dir{};
@@ -369,5 +761,3 @@ TEST(var_reader, reopen)
 
     std::filesystem::remove(dir.path() / "example.vcf.gz");
 }
-
-// TODO tests for reopen(region) on 1000G_chr10_sample.vcf.gz